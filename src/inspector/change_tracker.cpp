@@ -0,0 +1,227 @@
+﻿#include "pch.h"
+#include "change_tracker.h"
+#include "game_tick.h"
+#include "native_object.h"
+#include "methods/method_helpers.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <emmintrin.h>
+
+bool ChangeTracker::track(UnityResolve::UnityType::Component* owner, const FieldLayouts::Layout& layout,
+                          std::string label)
+{
+    if (!owner || layout.fields.empty() || isTracked(owner)) return false;
+
+    // Each field owns the bytes up to the next one, the last up to the end of the instance; value types have
+    // no size in the layout
+    std::vector<size_t> order(layout.fields.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+    {
+        return layout.fields[a].offset < layout.fields[b].offset;
+    });
+
+    const FieldLayouts::Field& last = layout.fields[order.back()];
+    Tracked tracked;
+    tracked.owner = owner;
+    tracked.layout = &layout;
+    tracked.begin = layout.fields[order.front()].offset;
+    tracked.end = std::max(methods::Runtime::GetInstanceSize(layout.klass),
+                           last.offset + static_cast<int32_t>(last.size));
+    if (tracked.end <= tracked.begin) return false;
+
+    const size_t bytes = static_cast<size_t>(tracked.end - tracked.begin);
+    tracked.fieldAt.assign(bytes, kPadding);
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const int32_t from = layout.fields[order[i]].offset - tracked.begin;
+        const int32_t to = i + 1 < order.size() ? layout.fields[order[i + 1]].offset - tracked.begin
+                                                : static_cast<int32_t>(bytes);
+        std::fill(tracked.fieldAt.begin() + from, tracked.fieldAt.begin() + to, static_cast<uint16_t>(order[i]));
+    }
+    tracked.changedFrame.assign(layout.fields.size(), 0);
+    tracked.shadow.resize(bytes);
+    std::memcpy(tracked.shadow.data(), reinterpret_cast<const uint8_t*>(owner) + tracked.begin, bytes);
+
+    tracked.label = static_cast<uint32_t>(m_labels.size());
+    m_labels.push_back(std::move(label));
+
+    std::lock_guard lock(m_mutex);
+    m_byOwner[owner] = m_tracked.size();
+    m_tracked.push_back(std::move(tracked));
+    m_bytes += bytes;
+    return true;
+}
+
+void ChangeTracker::untrack(UnityResolve::UnityType::Component* owner)
+{
+    auto it = m_byOwner.find(owner);
+    if (it == m_byOwner.end()) return;
+
+    // Swap with the last entry to keep the array dense for scan()
+    std::lock_guard lock(m_mutex);
+    const size_t index = it->second;
+    m_byOwner.erase(it);
+    m_bytes -= m_tracked[index].shadow.size();
+    if (index + 1 != m_tracked.size())
+    {
+        m_tracked[index] = std::move(m_tracked.back());
+        m_byOwner[m_tracked[index].owner] = index;
+    }
+    m_tracked.pop_back();
+}
+
+void ChangeTracker::clear()
+{
+    std::lock_guard lock(m_mutex);
+    m_tracked.clear();
+    m_byOwner.clear();
+    m_bytes = 0;
+}
+
+int ChangeTracker::getBreak(UnityResolve::UnityType::Component* owner) const
+{
+    auto it = m_byOwner.find(owner);
+    return it != m_byOwner.end() ? m_tracked[it->second].breakField : kNoBreak;
+}
+
+void ChangeTracker::setBreak(UnityResolve::UnityType::Component* owner, int field)
+{
+    auto it = m_byOwner.find(owner);
+    std::lock_guard lock(m_mutex);
+    if (it != m_byOwner.end()) m_tracked[it->second].breakField = field;
+}
+
+uint64_t ChangeTracker::lastChanged(UnityResolve::UnityType::Component* owner, size_t field) const
+{
+    auto it = m_byOwner.find(owner);
+    if (it == m_byOwner.end()) return 0;
+    std::lock_guard lock(m_mutex);
+    const Tracked& tracked = m_tracked[it->second];
+    return field < tracked.changedFrame.size() ? tracked.changedFrame[field] : 0;
+}
+
+void ChangeTracker::record(Tracked& tracked, size_t byte, uint64_t frame, Hit& hit, bool& hitFound)
+{
+    const uint16_t field = tracked.fieldAt[byte];
+    if (field == kPadding || tracked.changedFrame[field] == frame) return; // several bytes of one field
+
+    tracked.changedFrame[field] = frame;
+    const FieldLayouts::Field* info = &tracked.layout->fields[field];
+    if (!m_arrivals.push({frame, tracked.label, info})) m_dropped.fetch_add(1, std::memory_order_relaxed);
+
+    if (!hitFound && (tracked.breakField == kBreakOnAny || tracked.breakField == field))
+    {
+        hit = {tracked.label, info, frame};
+        hitFound = true;
+    }
+}
+
+bool ChangeTracker::scan(uint64_t frame, Hit& hit)
+{
+    const auto start = std::chrono::steady_clock::now();
+    bool hitFound = false;
+
+    std::lock_guard lock(m_mutex);
+    for (Tracked& tracked : m_tracked)
+    {
+        if (tracked.destroyed) continue;
+        if (!NativeObjectLayout::getCachedPtr(tracked.owner))
+        {
+            tracked.destroyed = true;
+            continue;
+        }
+
+        const uint8_t* current = reinterpret_cast<const uint8_t*>(tracked.owner) + tracked.begin;
+        uint8_t* shadow = tracked.shadow.data();
+        const size_t bytes = tracked.shadow.size();
+
+        size_t i = 0;
+        for (; i + 16 <= bytes; i += 16)
+        {
+            const __m128i now = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i));
+            const __m128i before = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shadow + i));
+            unsigned differing = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(now, before))) & 0xFFFF;
+            if (!differing) continue;
+
+            for (; differing; differing &= differing - 1)
+            {
+                record(tracked, i + std::countr_zero(differing), frame, hit, hitFound);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(shadow + i), now);
+        }
+        for (; i < bytes; i++)
+        {
+            if (current[i] == shadow[i]) continue;
+            record(tracked, i, frame, hit, hitFound);
+            shadow[i] = current[i];
+        }
+    }
+
+    m_scanUs.store(std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count(),
+                   std::memory_order_relaxed);
+    return hitFound;
+}
+
+void ChangeTracker::tick(uint64_t frame)
+{
+    Hit hit;
+    if (!scan(frame, hit) || isPaused()) return;
+
+    // Paused from here, so the game stops on the frame that made the change
+    try
+    {
+        m_resumeTimeScale = methods::Time::GetTimeScale();
+        methods::Time::SetTimeScale(0.0f);
+    }
+    catch (...)
+    {
+        LOG_WARNING("[ChangeTracker] Failed to pause on change of %s", hit.field->name.c_str());
+        return;
+    }
+    m_break = hit;
+    m_paused.store(true, std::memory_order_release);
+    m_breakPending.store(true, std::memory_order_release);
+}
+
+void ChangeTracker::onTick(void* context)
+{
+    auto tracker = static_cast<ChangeTracker*>(context);
+    tracker->tick(GameTick::getInstance().getFrame());
+}
+
+bool ChangeTracker::drain(Hit& hit)
+{
+    Change batch[256];
+    size_t count;
+    while ((count = m_arrivals.pop(batch, std::size(batch))) > 0)
+    {
+        if (m_log.empty()) m_log.resize(kMaxLog);
+        for (size_t i = 0; i < count; i++)
+        {
+            m_log[m_logHead] = batch[i];
+            m_logHead = (m_logHead + 1) % kMaxLog;
+        }
+        m_logCount = std::min(m_logCount + count, kMaxLog);
+    }
+
+    if (!m_breakPending.exchange(false, std::memory_order_acquire)) return false;
+    hit = m_break;
+    return true;
+}
+
+void ChangeTracker::resume()
+{
+    if (!isPaused()) return;
+    try
+    {
+        methods::Time::SetTimeScale(m_resumeTimeScale);
+    }
+    catch (...)
+    {
+        LOG_WARNING("[ChangeTracker] Failed to restore the time scale");
+    }
+    m_paused.store(false, std::memory_order_release);
+}
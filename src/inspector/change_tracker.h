@@ -0,0 +1,120 @@
+﻿#pragma once
+
+#include "field_layout.h"
+#include "utils/spsc_ring.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Detects writes to the managed fields of chosen components. Each tracked component keeps a shadow copy of its
+// field bytes; scan() compares object memory against it 16 bytes at a time with SSE2, and only when a block
+// differs maps the differing bytes back to fields through the class layout, logs them with the frame number
+// and updates the copy. A few hundred components of ordinary size take microseconds per scan. A component can
+// also carry a break condition, a change to one field or to any.
+//
+// tick() runs on the game's main thread (see GameTick), so every game frame is scanned and stamped with its own
+// number, and a break sets Time.timeScale to 0 on the frame it hit. Changes reach the UI through a
+// single-producer single-consumer ring that drain() empties into the log; a break is handed over the same way.
+// Without a game tick the UI update calls tick() itself, once per rendered frame.
+class ChangeTracker
+{
+public:
+    static constexpr int kNoBreak = -2;
+    static constexpr int kBreakOnAny = -1; // otherwise a field index
+    static constexpr size_t kMaxLog = 4096;
+
+    struct Change
+    {
+        uint64_t frame;
+        uint32_t tracked; // label via getLabel()
+        const FieldLayouts::Field* field;
+    };
+
+    struct Hit
+    {
+        uint32_t tracked;
+        const FieldLayouts::Field* field;
+        uint64_t frame;
+    };
+
+    bool track(UnityResolve::UnityType::Component* owner, const FieldLayouts::Layout& layout, std::string label);
+    void untrack(UnityResolve::UnityType::Component* owner);
+    void clear();
+    bool isTracked(UnityResolve::UnityType::Component* owner) const { return m_byOwner.count(owner) != 0; }
+    size_t trackedCount() const { return m_tracked.size(); }
+
+    // Field index to break on (kNoBreak, kBreakOnAny or an index into the layout)
+    int getBreak(UnityResolve::UnityType::Component* owner) const;
+    void setBreak(UnityResolve::UnityType::Component* owner, int field);
+
+    // Scan as `frame` and pause the game if a break condition hits while it is not already paused
+    void tick(uint64_t frame);
+    // GameTick callback; context is the ChangeTracker
+    static void onTick(void* context);
+
+    // UI side: move the changes scanned since the last call into the log. Returns true if a break paused the
+    // game since; `hit` then names it.
+    bool drain(Hit& hit);
+    bool isPaused() const { return m_paused.load(std::memory_order_acquire); }
+    // Restore the time scale from before the break
+    void resume();
+
+    // Frame a field of the layout last changed on, 0 if never (or not tracked)
+    uint64_t lastChanged(UnityResolve::UnityType::Component* owner, size_t field) const;
+
+    // Newest first
+    size_t logSize() const { return m_logCount; }
+    const Change& logEntry(size_t i) const { return m_log[(m_logHead + kMaxLog - 1 - i) % kMaxLog]; }
+    void clearLog() { m_logCount = 0; }
+    const std::string& getLabel(uint32_t tracked) const { return m_labels[tracked]; }
+
+    float getScanUs() const { return m_scanUs.load(std::memory_order_relaxed); }
+    size_t getTrackedBytes() const { return m_bytes; }
+    uint32_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint16_t kPadding = 0xFFFF;
+
+    struct Tracked
+    {
+        UnityResolve::UnityType::Component* owner;
+        const FieldLayouts::Layout* layout;
+        uint32_t label;
+        int32_t begin; // byte range of the fields in the object
+        int32_t end;
+        std::vector<uint8_t> shadow;
+        std::vector<uint16_t> fieldAt;      // per byte of the range: field index, or kPadding
+        std::vector<uint64_t> changedFrame; // per field
+        int breakField = kNoBreak;
+        bool destroyed = false;
+    };
+
+    // Guards the tracked set: held by the scan for its few microseconds, and by the UI while it changes the set
+    // or reads the per-field frames the scan writes
+    mutable std::mutex m_mutex;
+    std::vector<Tracked> m_tracked;
+    std::unordered_map<void*, size_t> m_byOwner; // -> m_tracked; changed by the UI only
+    std::vector<std::string> m_labels;           // by id, kept for the log after untrack; UI only
+
+    SpscRing<Change, 2048> m_arrivals; // scanned, not yet drained
+    std::atomic<uint32_t> m_dropped{0}; // changes lost to a full ring
+
+    std::vector<Change> m_log; // circular, kMaxLog; UI only
+    size_t m_logHead = 0;
+    size_t m_logCount = 0;
+
+    std::atomic<bool> m_paused{false};
+    std::atomic<bool> m_breakPending{false}; // m_break set by the scan, not yet taken by drain()
+    Hit m_break = {};
+    float m_resumeTimeScale = 1.0f;
+
+    size_t m_bytes = 0;
+    std::atomic<float> m_scanUs{0.0f};
+
+    bool scan(uint64_t frame, Hit& hit);
+    void record(Tracked& tracked, size_t byte, uint64_t frame, Hit& hit, bool& hitFound);
+};
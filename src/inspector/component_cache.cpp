@@ -0,0 +1,76 @@
+﻿#include "pch.h"
+#include "component_cache.h"
+#include "native_object.h"
+#include "methods/method_helpers.h"
+
+ComponentCache::ComponentCache(ComponentRegistry& registry) : m_registry(registry)
+{
+    m_stateKeys.emplace("GameObject", kGameObjectState);
+    m_stateKeys.emplace("Transform", kTransformState);
+}
+
+bool ComponentCache::update(const SceneArena& arena, NodeRef selection, float now)
+{
+    const bool selectionChanged =
+        selection.index != m_selection.index || selection.generation != m_selection.generation;
+    if (!selectionChanged && !m_dirty && now - m_fetchTime < kRevalidateInterval)
+    {
+        // Components destroyed without a journal entry (delayed Destroy) have their native pointer cleared
+        std::erase_if(m_entries, [](const Entry& entry) { return !NativeObjectLayout::getCachedPtr(entry.component); });
+        return false;
+    }
+
+    m_selection = selection;
+    m_fetchTime = now;
+    m_dirty = false;
+    m_entries.clear();
+
+    const uint32_t index = arena.resolve(selection);
+    if (index == SceneArena::kInvalid || !arena.isLive(index)) return true;
+
+    static auto componentClass = GET_CLASS("UnityEngine.CoreModule.dll", "Component");
+    try
+    {
+        for (auto component : arena[index].gameObject->GetComponents<UnityResolve::UnityType::Component*>(
+                 componentClass))
+        {
+            // Missing scripts show up as null entries
+            if (component) m_entries.push_back({component, classInfo(component)});
+        }
+    }
+    catch (...)
+    {
+        LOG_WARNING("[ComponentCache] Failed to read the components of instance %d", arena[index].instanceId);
+    }
+    m_fetches++;
+    return true;
+}
+
+const ComponentCache::ClassInfo* ComponentCache::classInfo(UnityResolve::UnityType::Component* component)
+{
+    void* klass = methods::Runtime::GetObjectClass(component);
+    auto& info = m_classes[klass];
+    if (info) return info.get();
+
+    info = std::make_unique<ClassInfo>();
+    info->klass = klass;
+    const char* name = methods::Runtime::GetClassName(klass);
+    info->name = name ? name : "Component";
+    info->stateKey = m_stateKeys.emplace(info->name, static_cast<uint32_t>(m_stateKeys.size())).first->second;
+    try
+    {
+        if (auto type = component->GetType())
+        {
+            if (auto fullName = type->GetFullName()) info->fullName = fullName->ToString();
+        }
+    }
+    catch (...)
+    {
+    }
+    if (info->fullName.empty()) info->fullName = info->name;
+
+    info->renderer = m_registry.find(klass);
+    static auto behaviourClass = GET_CLASS("UnityEngine.CoreModule.dll", "Behaviour");
+    info->behaviour = behaviourClass && methods::Runtime::IsSubclassOf(klass, behaviourClass->address);
+    return info.get();
+}
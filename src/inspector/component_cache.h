@@ -0,0 +1,64 @@
+﻿#pragma once
+
+#include "component_registry.h"
+#include "scene_arena.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Components of the inspected object. The list is fetched with one GetComponents call when the selection
+// changes and then kept: the inspector draws from it without calling into Unity, and it is fetched again only
+// after invalidate() (scene refresh, lifetime events on the selected object) or once the revalidation
+// interval has passed, which catches components added or removed by the game; one destroyed in between is
+// dropped as soon as Unity clears its native pointer. What each runtime class is (its names, which registered
+// section draws it, the key of its expanded state) is worked out once per class, not per frame.
+class ComponentCache
+{
+public:
+    struct ClassInfo
+    {
+        void* klass;
+        std::string name;     // short class name
+        std::string fullName; // with namespace
+        uint16_t renderer;    // registry entry, ComponentRegistry::kNone for the generic field view
+        uint32_t stateKey;    // small integer per class name, for per-section UI state
+        bool behaviour;       // has an enabled flag
+    };
+
+    struct Entry
+    {
+        UnityResolve::UnityType::Component* component;
+        const ClassInfo* info; // owned by the cache, stable
+    };
+
+    static constexpr float kRevalidateInterval = 1.0f; // seconds
+
+    // State keys of the sections that are not components
+    static constexpr uint32_t kGameObjectState = 0;
+    static constexpr uint32_t kTransformState = 1;
+
+    explicit ComponentCache(ComponentRegistry& registry);
+
+    // Fetch the list if the selection changed, the cache was invalidated or the interval has passed.
+    // Returns true if it was fetched during this call.
+    bool update(const SceneArena& arena, NodeRef selection, float now);
+    void invalidate() { m_dirty = true; }
+
+    const std::vector<Entry>& entries() const { return m_entries; }
+    uint32_t getFetchCount() const { return m_fetches; }
+    uint32_t getStateKeyCount() const { return static_cast<uint32_t>(m_stateKeys.size()); }
+
+private:
+    ComponentRegistry& m_registry;
+    std::vector<Entry> m_entries;
+    std::unordered_map<void*, std::unique_ptr<ClassInfo>> m_classes;
+    std::unordered_map<std::string, uint32_t> m_stateKeys; // class name -> key, so equal names share UI state
+    NodeRef m_selection;
+    float m_fetchTime = 0.0f;
+    bool m_dirty = true;
+    uint32_t m_fetches = 0;
+
+    const ClassInfo* classInfo(UnityResolve::UnityType::Component* component);
+};
@@ -0,0 +1,33 @@
+﻿#include "pch.h"
+#include "component_registry.h"
+#include "methods/method_helpers.h"
+
+#include <algorithm>
+
+uint16_t ComponentRegistry::find(void* klass)
+{
+    auto it = std::lower_bound(m_table.begin(), m_table.end(), klass,
+                               [](const std::pair<void*, uint16_t>& entry, void* key) { return entry.first < key; });
+    if (it != m_table.end() && it->first == klass) return it->second;
+
+    if (m_classes.empty())
+    {
+        for (const Entry& entry : m_entries)
+        {
+            auto known = UnityResolve::Get(entry.module) ? GET_CLASS(entry.module, entry.className) : nullptr;
+            m_classes.push_back(known ? known->address : nullptr);
+        }
+    }
+
+    uint16_t index = kNone;
+    for (size_t i = 0; i < m_classes.size(); i++)
+    {
+        if (m_classes[i] && methods::Runtime::IsSubclassOf(klass, m_classes[i]))
+        {
+            index = static_cast<uint16_t>(i);
+            break;
+        }
+    }
+    m_table.insert(it, {klass, index});
+    return index;
+}
@@ -0,0 +1,54 @@
+﻿#pragma once
+
+#include <span>
+#include <utility>
+#include <vector>
+
+// Inspector sections for specific component classes. The sections are a constexpr array of entries built with
+// Entry::of, each naming a class and the member function that draws it, so adding one is a line in that array
+// and nothing is registered at runtime. A runtime class is matched once, to the first entry it derives from,
+// and kept in a flat table sorted by class pointer; callers store the resulting index with their per-class
+// data, so drawing a component is an indexed call rather than a lookup.
+class ComponentRegistry
+{
+public:
+    using Render = void (*)(void* context, UnityResolve::UnityType::Component* component);
+
+    struct Entry
+    {
+        const char* module;
+        const char* className;
+        Render render; // null for classes drawn in a fixed section of their own
+
+        // Section drawn by a member function `void Owner::render(T*)`; the context passed to render is the Owner
+        template <auto Method>
+        static constexpr Entry of(const char* module, const char* className)
+        {
+            return {module, className, [](void* context, UnityResolve::UnityType::Component* component)
+            {
+                invoke(Method, context, component);
+            }};
+        }
+
+    private:
+        template <typename Owner, typename T>
+        static void invoke(void (Owner::*method)(T*), void* context, UnityResolve::UnityType::Component* component)
+        {
+            (static_cast<Owner*>(context)->*method)(static_cast<T*>(component));
+        }
+    };
+
+    static constexpr uint16_t kNone = 0xFFFF;
+
+    // Entries are checked in order, so more derived classes go first
+    explicit ComponentRegistry(std::span<const Entry> entries) : m_entries(entries) {}
+
+    // Entry for a runtime class, kNone if it derives from none of them
+    uint16_t find(void* klass);
+    const Entry& operator[](uint16_t index) const { return m_entries[index]; }
+
+private:
+    std::span<const Entry> m_entries;
+    std::vector<void*> m_classes; // of each entry, resolved on first use; null if its module is not loaded
+    std::vector<std::pair<void*, uint16_t>> m_table; // runtime class -> entry, sorted by class
+};
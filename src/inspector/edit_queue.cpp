@@ -0,0 +1,211 @@
+﻿#include "pch.h"
+#include "edit_queue.h"
+#include "field_layout.h"
+#include "native_object.h"
+#include "methods/method_helpers.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+void EditQueue::stage(Pending&& pending)
+{
+    std::lock_guard lock(m_mutex);
+    auto it = std::find_if(m_pending.begin(), m_pending.end(),
+                           [&](const Pending& staged) { return staged.target == pending.target; });
+    if (it != m_pending.end())
+    {
+        *it = std::move(pending); // coalesce: only the newest value of a target is written
+        return;
+    }
+    m_pending.push_back(std::move(pending));
+}
+
+void EditQueue::write(const Target& target, const void* value, std::string label, uint64_t gesture)
+{
+    if (!target.owner || target.size == 0 || target.size > kMaxValue) return;
+
+    Pending pending = {};
+    pending.target = target;
+    std::memcpy(pending.value, value, target.size);
+    pending.label = std::move(label);
+    pending.gesture = gesture;
+    stage(std::move(pending));
+}
+
+bool EditQueue::undo(uint64_t id)
+{
+    auto it = std::find_if(m_journal.begin(), m_journal.end(), [&](const Transaction& t) { return t.id == id; });
+    if (it == m_journal.end() || it->undone) return false;
+
+    Pending pending = {};
+    pending.target = it->target;
+    std::memcpy(pending.value, it->before, it->target.size);
+    pending.label = it->label;
+    pending.undoOf = id;
+    stage(std::move(pending));
+    it->undone = true; // shown right away; a failed write re-opens it in collect()
+    return true;
+}
+
+bool EditQueue::undoLast()
+{
+    for (const Transaction& transaction : m_journal)
+    {
+        if (!transaction.undone) return undo(transaction.id);
+    }
+    return false;
+}
+
+size_t EditQueue::getPendingCount()
+{
+    std::lock_guard lock(m_mutex);
+    return m_pending.size();
+}
+
+bool EditQueue::read(const Target& target, uint8_t* out)
+{
+    if (!target.setter)
+    {
+        std::memcpy(out, reinterpret_cast<const uint8_t*>(target.owner) + target.offset, target.size);
+        return true;
+    }
+
+    // Getters box value types; the data follows the object header
+    auto boxed = static_cast<const uint8_t*>(methods::Runtime::InvokeGetter(target.getter, target.owner));
+    if (!boxed) return false;
+    std::memcpy(out, boxed + FieldLayouts::kObjectHeader, target.size);
+    return true;
+}
+
+bool EditQueue::store(const Target& target, const uint8_t* value)
+{
+    if (!target.setter)
+    {
+        std::memcpy(reinterpret_cast<uint8_t*>(target.owner) + target.offset, value, target.size);
+        return true;
+    }
+    return methods::Runtime::InvokeSetter(target.setter, target.owner, const_cast<uint8_t*>(value));
+}
+
+void EditQueue::apply()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_pending.empty()) return;
+        m_batch.swap(m_pending);
+    }
+
+    m_results.clear();
+    for (Pending& pending : m_batch)
+    {
+        Applied applied = {};
+        applied.ok = false;
+        try
+        {
+            // A destroyed object keeps its managed wrapper; writing to it would go nowhere
+            if (NativeObjectLayout::getCachedPtr(pending.target.owner) && read(pending.target, applied.before))
+            {
+                applied.ok = store(pending.target, pending.value);
+            }
+        }
+        catch (...)
+        {
+        }
+        applied.write = std::move(pending);
+        m_results.push_back(std::move(applied));
+    }
+    m_batch.clear();
+
+    std::lock_guard lock(m_mutex);
+    for (Applied& applied : m_results) m_applied.push_back(std::move(applied));
+}
+
+void EditQueue::collect()
+{
+    std::vector<Applied> applied;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_applied.empty()) return;
+        applied.swap(m_applied);
+    }
+
+    for (Applied& result : applied)
+    {
+        const Pending& write = result.write;
+        if (write.undoOf != 0)
+        {
+            if (result.ok) continue;
+            for (Transaction& transaction : m_journal)
+            {
+                if (transaction.id == write.undoOf) transaction.undone = false;
+            }
+            m_failed++;
+            LOG_WARNING("[EditQueue] Failed to undo %s", write.label.c_str());
+            continue;
+        }
+        if (!result.ok)
+        {
+            m_failed++;
+            LOG_WARNING("[EditQueue] Failed to write %s", write.label.c_str());
+            continue;
+        }
+
+        // Further writes of the gesture in progress extend its transaction and keep its original value
+        if (!m_journal.empty())
+        {
+            Transaction& last = m_journal.front();
+            if (!last.undone && last.gesture == write.gesture && last.target == write.target)
+            {
+                std::memcpy(last.after, write.value, kMaxValue);
+                last.writes++;
+                continue;
+            }
+        }
+
+        Transaction transaction = {};
+        transaction.id = m_nextId++;
+        transaction.target = write.target;
+        transaction.label = write.label;
+        std::memcpy(transaction.before, result.before, kMaxValue);
+        std::memcpy(transaction.after, write.value, kMaxValue);
+        transaction.gesture = write.gesture;
+        transaction.writes = 1;
+        m_journal.push_front(std::move(transaction));
+        if (m_journal.size() > kMaxJournal) m_journal.pop_back();
+    }
+}
+
+std::string EditQueue::formatValue(const uint8_t* value, const Target& target)
+{
+    char text[96] = {};
+    switch (target.format)
+    {
+    case Format::Bool: return value[0] ? "True" : "False";
+    case Format::Int32:
+    {
+        int32_t number = 0;
+        std::memcpy(&number, value, sizeof(number));
+        std::snprintf(text, sizeof(text), "%d", number);
+        return text;
+    }
+    case Format::Floats:
+    default:
+    {
+        float numbers[kMaxValue / sizeof(float)] = {};
+        const size_t count = std::min<size_t>(target.size / sizeof(float), std::size(numbers));
+        std::memcpy(numbers, value, count * sizeof(float));
+        int written = 0;
+        for (size_t i = 0; i < count && written < static_cast<int>(sizeof(text)); i++)
+        {
+            written += std::snprintf(text + written, sizeof(text) - written, i == 0 ? "%.3f" : ", %.3f", numbers[i]);
+        }
+        return count > 1 ? "(" + std::string(text) + ")" : std::string(text);
+    }
+    }
+}
+
+void EditQueue::onTick(void* context)
+{
+    static_cast<EditQueue*>(context)->apply();
+}
@@ -0,0 +1,108 @@
+﻿#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Edits made in the inspector, written by the game rather than by the UI. write() stages a value; apply() runs
+// at a safe point of the player loop (the GameTick, after LateUpdate and before rendering) and writes everything
+// staged since the last one in a single batch. It is only ever called from there: without the GameTick hook the
+// inspector offers no editing, since Present is not a safe point. A value written again before
+// that replaces the staged one, so dragging a slider costs one write per frame. apply() also reads each
+// target's value before writing it; collect() turns these into a journal on the UI side, where all writes of
+// one drag or edit (a gesture) form a single transaction that undo() can reverse.
+class EditQueue
+{
+public:
+    static constexpr size_t kMaxValue = 16; // bytes, up to a Quaternion or Color
+    static constexpr size_t kMaxJournal = 256;
+
+    // How the bytes of a value are shown in the journal
+    enum class Format : uint8_t
+    {
+        Floats, // size / 4 floats
+        Int32,
+        Bool,
+    };
+
+    struct Target
+    {
+        UnityResolve::UnityType::UnityObject* owner = nullptr;
+        void* setter = nullptr; // property setter; null to write memory at owner + offset
+        void* getter = nullptr; // matching getter, to read the value before the write
+        int32_t offset = 0;     // of a field, for memory writes
+        uint8_t size = 0;
+        Format format = Format::Floats;
+
+        bool operator==(const Target& other) const
+        {
+            return owner == other.owner && setter == other.setter && offset == other.offset;
+        }
+    };
+
+    struct Transaction
+    {
+        uint64_t id;
+        Target target;
+        std::string label;
+        uint8_t before[kMaxValue];
+        uint8_t after[kMaxValue];
+        uint64_t gesture;
+        uint32_t writes; // applied writes merged into this transaction
+        bool undone;
+    };
+
+    // UI thread: stage a value for the next apply(). Writes with the same gesture id share a transaction.
+    void write(const Target& target, const void* value, std::string label, uint64_t gesture);
+    // UI thread: stage the value a transaction replaced. Returns false if it is unknown or already undone.
+    bool undo(uint64_t id);
+    bool undoLast();
+
+    // Safe point: write everything staged. Game thread only.
+    void apply();
+    // UI thread: move what apply() wrote into the journal
+    void collect();
+
+    // Newest first
+    const std::deque<Transaction>& journal() const { return m_journal; }
+    void clearJournal() { m_journal.clear(); }
+    size_t getPendingCount();
+    uint32_t getFailedCount() const { return m_failed; }
+
+    static std::string formatValue(const uint8_t* value, const Target& target);
+
+    // GameTick callback; context is the EditQueue
+    static void onTick(void* context);
+
+private:
+    struct Pending
+    {
+        Target target;
+        uint8_t value[kMaxValue];
+        std::string label;
+        uint64_t gesture;
+        uint64_t undoOf; // transaction id, 0 for a new edit
+    };
+
+    struct Applied
+    {
+        Pending write;
+        uint8_t before[kMaxValue];
+        bool ok;
+    };
+
+    std::mutex m_mutex; // guards m_pending and m_applied, the two hand-over points between the threads
+    std::vector<Pending> m_pending;
+    std::vector<Applied> m_applied;
+    std::vector<Pending> m_batch; // game thread scratch
+    std::vector<Applied> m_results;
+
+    std::deque<Transaction> m_journal; // UI thread only
+    uint64_t m_nextId = 1;
+    uint32_t m_failed = 0;
+
+    void stage(Pending&& pending);
+    static bool read(const Target& target, uint8_t* out);
+    static bool store(const Target& target, const uint8_t* value);
+};
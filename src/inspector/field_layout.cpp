@@ -0,0 +1,142 @@
+﻿#include "pch.h"
+#include "field_layout.h"
+#include "methods/method_helpers.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t kFieldStatic = 0x10;
+
+    using methods::TypeCode;
+
+    uint8_t sizeOf(TypeCode code)
+    {
+        switch (code)
+        {
+        case TypeCode::Boolean:
+        case TypeCode::I1:
+        case TypeCode::U1: return 1;
+        case TypeCode::Char:
+        case TypeCode::I2:
+        case TypeCode::U2: return 2;
+        case TypeCode::I4:
+        case TypeCode::U4:
+        case TypeCode::R4: return 4;
+        case TypeCode::I:
+        case TypeCode::U: return sizeof(void*);
+        default: return 8;
+        }
+    }
+
+    bool isUnityEngine(void* klass)
+    {
+        const char* space = methods::Runtime::GetClassNamespace(klass);
+        return space && std::strcmp(space, "UnityEngine") == 0;
+    }
+}
+
+bool FieldLayouts::classify(void* type, Field& field)
+{
+    const TypeCode code = methods::Runtime::GetTypeCode(type);
+    field.klass = methods::Runtime::GetTypeClass(type);
+    const char* name = methods::Runtime::GetClassName(field.klass);
+    field.typeName = name ? name : "?";
+    field.size = sizeOf(code);
+
+    switch (code)
+    {
+    case TypeCode::Boolean: field.kind = Kind::Bool; return true;
+    case TypeCode::Char: field.kind = Kind::Char; return true;
+    case TypeCode::I1:
+    case TypeCode::I2:
+    case TypeCode::I4:
+    case TypeCode::I8:
+    case TypeCode::I: field.kind = Kind::Integer; return true;
+    case TypeCode::U1:
+    case TypeCode::U2:
+    case TypeCode::U4:
+    case TypeCode::U8:
+    case TypeCode::U: field.kind = Kind::Unsigned; return true;
+    case TypeCode::R4: field.kind = Kind::Float; return true;
+    case TypeCode::R8: field.kind = Kind::Double; return true;
+    case TypeCode::String: field.kind = Kind::String; return true;
+    case TypeCode::Class:
+    case TypeCode::Object: field.kind = Kind::Reference; return true;
+    case TypeCode::SzArray:
+    case TypeCode::Array: field.kind = Kind::Array; return true;
+    case TypeCode::GenericInst:
+        field.kind = methods::Runtime::IsValueType(field.klass) ? Kind::Struct : Kind::Reference;
+        return true;
+    case TypeCode::ValueType: break;
+    default: return false; // pointers, generic parameters
+    }
+
+    if (methods::Runtime::IsEnum(field.klass))
+    {
+        field.kind = Kind::Enum;
+        field.size = sizeOf(methods::Runtime::GetTypeCode(methods::Runtime::GetEnumBaseType(field.klass)));
+        return true;
+    }
+
+    static const std::pair<const char*, Kind> unityTypes[] = {
+        {"Vector2", Kind::Vector2}, {"Vector3", Kind::Vector3}, {"Vector4", Kind::Vector4},
+        {"Quaternion", Kind::Quaternion}, {"Color", Kind::Color}, {"Color32", Kind::Color32},
+    };
+    field.kind = Kind::Struct;
+    if (isUnityEngine(field.klass))
+    {
+        for (const auto& [typeName, kind] : unityTypes)
+        {
+            if (field.typeName == typeName) field.kind = kind;
+        }
+    }
+    return true;
+}
+
+const FieldLayouts::Layout& FieldLayouts::get(void* klass)
+{
+    auto& layout = m_layouts[klass];
+    if (layout) return *layout;
+
+    layout = std::make_unique<Layout>();
+    layout->klass = klass;
+
+    // Most derived class first while walking up, then reversed so base class fields come first
+    std::vector<void*> chain;
+    for (void* current = klass; current; current = methods::Runtime::GetClassParent(current))
+    {
+        const char* name = methods::Runtime::GetClassName(current);
+        if (name && std::strcmp(name, "Object") == 0 && isUnityEngine(current)) break;
+        chain.push_back(current);
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    for (void* current : chain)
+    {
+        void* iterator = nullptr;
+        while (void* info = methods::Runtime::GetNextField(current, &iterator))
+        {
+            if (methods::Runtime::GetFieldFlags(info) & kFieldStatic) continue;
+
+            Field field = {};
+            const char* name = methods::Runtime::GetFieldName(info);
+            field.name = name ? name : "?";
+            field.offset = methods::Runtime::GetFieldOffset(info);
+            if (field.offset < 0 || !classify(methods::Runtime::GetFieldType(info), field)) continue;
+            layout->fields.push_back(std::move(field));
+        }
+    }
+    m_fieldCount += layout->fields.size();
+    return *layout;
+}
+
+int32_t FieldLayouts::findOffset(void* klass, std::string_view name)
+{
+    for (const Field& field : get(klass).fields)
+    {
+        if (field.name == name) return field.offset;
+    }
+    return -1;
+}
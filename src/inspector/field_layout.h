@@ -0,0 +1,69 @@
+﻿#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Instance field layouts of runtime classes, reflected once per class through the scripting backend and then
+// reused: name, type and byte offset of every field, base class fields first, down to (not including)
+// UnityEngine.Object. Each field is classified into the widget that draws it, so the inspector reads values
+// straight from object memory at their offsets without invoking getters or looking anything up by name.
+class FieldLayouts
+{
+public:
+    enum class Kind : uint8_t
+    {
+        Bool,
+        Char,
+        Integer,  // signed, `size` bytes
+        Unsigned, // `size` bytes
+        Float,
+        Double,
+        Enum,     // underlying integer of `size` bytes, signed
+        String,
+        Vector2,
+        Vector3,
+        Vector4,
+        Quaternion,
+        Color,
+        Color32,
+        Struct,    // other value type, laid out inline; see `klass`
+        Reference, // class instance
+        Array,
+    };
+
+    struct Field
+    {
+        std::string name;
+        std::string typeName; // short class name
+        int32_t offset;       // from the start of the object, header included, as the runtime reports it
+        Kind kind;
+        uint8_t size;
+        void* klass; // declared class of the field's type
+    };
+
+    struct Layout
+    {
+        void* klass;
+        std::vector<Field> fields;
+    };
+
+    // Object header in front of the fields. Offsets of value type fields count it too, so a struct stored
+    // inline at `address` has its fields at `address - kObjectHeader + offset`.
+    static constexpr int32_t kObjectHeader = 2 * sizeof(void*);
+
+    const Layout& get(void* klass);
+    // Offset of a field by name, -1 if the class has none
+    int32_t findOffset(void* klass, std::string_view name);
+
+    size_t classCount() const { return m_layouts.size(); }
+    size_t fieldCount() const { return m_fieldCount; }
+
+private:
+    std::unordered_map<void*, std::unique_ptr<Layout>> m_layouts;
+    size_t m_fieldCount = 0;
+
+    static bool classify(void* type, Field& field);
+};
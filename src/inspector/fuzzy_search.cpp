@@ -0,0 +1,271 @@
+﻿#include "pch.h"
+#include "fuzzy_search.h"
+#include "scene_arena.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FUZZY_SSE2 1
+#endif
+
+namespace
+{
+    // Scoring follows fzf: a matched character is worth more at a word start or camelCase hump, a run of
+    // consecutive matches keeps the bonus of its first character, and gaps cost a little per skipped character
+    constexpr int32_t kScoreMatch = 16;
+    constexpr int32_t kGapStart = -3;
+    constexpr int32_t kGapExtension = -1;
+    constexpr int32_t kBonusBoundary = kScoreMatch / 2;
+    constexpr int32_t kBonusNonWord = kScoreMatch / 2;
+    constexpr int32_t kBonusCamel = kBonusBoundary + kGapExtension;
+    constexpr int32_t kBonusConsecutive = -(kGapStart + kGapExtension);
+    constexpr int32_t kFirstCharMultiplier = 2;
+    constexpr int32_t kNone = INT32_MIN / 2;
+
+    constexpr size_t kMaxName = 256; // longer names are scored on their first 256 characters
+    constexpr size_t kMaxPattern = 64;
+
+    enum class CharClass : uint8_t
+    {
+        NonWord,
+        Lower,
+        Upper,
+        Digit,
+    };
+
+    CharClass classOf(char c)
+    {
+        if (c >= 'a' && c <= 'z') return CharClass::Lower;
+        if (c >= 'A' && c <= 'Z') return CharClass::Upper;
+        if (c >= '0' && c <= '9') return CharClass::Digit;
+        return static_cast<uint8_t>(c) >= 0x80 ? CharClass::Lower : CharClass::NonWord;
+    }
+
+    int32_t bonusOf(CharClass previous, CharClass current)
+    {
+        if (previous == CharClass::NonWord && current != CharClass::NonWord) return kBonusBoundary;
+        if ((previous == CharClass::Lower && current == CharClass::Upper) ||
+            (previous != CharClass::Digit && current == CharClass::Digit))
+            return kBonusCamel;
+        if (current == CharClass::NonWord) return kBonusNonWord;
+        return 0;
+    }
+
+    // Names whose mask contains every bit of `required`
+    void prefilter(const uint64_t* masks, size_t count, uint64_t required, std::vector<uint32_t>& out)
+    {
+        size_t i = 0;
+#ifdef FUZZY_SSE2
+        // Two masks per register: a lane passes when all eight of its bytes compare equal after the AND
+        const __m128i need = _mm_set1_epi64x(static_cast<long long>(required));
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + i + 2));
+            const int hitsA = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(a, need), need));
+            const int hitsB = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(b, need), need));
+            if ((hitsA & 0x00FF) == 0x00FF) out.push_back(static_cast<uint32_t>(i));
+            if ((hitsA & 0xFF00) == 0xFF00) out.push_back(static_cast<uint32_t>(i + 1));
+            if ((hitsB & 0x00FF) == 0x00FF) out.push_back(static_cast<uint32_t>(i + 2));
+            if ((hitsB & 0xFF00) == 0xFF00) out.push_back(static_cast<uint32_t>(i + 3));
+        }
+#endif
+        for (; i < count; i++)
+        {
+            if ((masks[i] & required) == required) out.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+uint64_t FuzzySearch::charMask(std::string_view text)
+{
+    // Letters and digits get a bit each; other ASCII shares the remaining bits and non-ASCII bytes the last
+    uint64_t mask = 0;
+    for (char c : text)
+    {
+        const char lower = toLowerAscii(c);
+        const auto byte = static_cast<uint8_t>(lower);
+        if (lower >= 'a' && lower <= 'z') mask |= 1ULL << (lower - 'a');
+        else if (lower >= '0' && lower <= '9') mask |= 1ULL << (26 + lower - '0');
+        else if (byte < 0x80) mask |= 1ULL << (36 + byte % 27);
+        else mask |= 1ULL << 63;
+    }
+    return mask;
+}
+
+int32_t FuzzySearch::score(std::string_view name, std::string_view pattern)
+{
+    const size_t n = std::min(name.size(), kMaxName);
+    const size_t m = pattern.size();
+    if (m == 0 || m > n) return -1;
+
+    // Greedy subsequence check first; most prefilter survivors that fail are rejected here in one pass
+    size_t matched = 0;
+    for (size_t j = 0; j < n && matched < m; j++)
+    {
+        if (toLowerAscii(name[j]) == pattern[matched]) matched++;
+    }
+    if (matched < m) return -1;
+
+    int32_t bonus[kMaxName];
+    int32_t single = kNone; // a one-character pattern scores its best placed occurrence
+    CharClass previous = CharClass::NonWord;
+    for (size_t j = 0; j < n; j++)
+    {
+        const CharClass current = classOf(name[j]);
+        bonus[j] = bonusOf(previous, current);
+        previous = current;
+        if (m == 1 && toLowerAscii(name[j]) == pattern[0])
+            single = std::max(single, kScoreMatch + bonus[j] * kFirstCharMultiplier);
+    }
+    if (m == 1) return single;
+
+    // score[j]: best alignment of the pattern so far with its last character at j; chunk[j]: the bonus the
+    // run of consecutive matches ending at j started with
+    int32_t rows[2][kMaxName];
+    int32_t chunks[2][kMaxName];
+    int32_t* before = rows[0];
+    int32_t* score = rows[1];
+    int32_t* chunkBefore = chunks[0];
+    int32_t* chunk = chunks[1];
+
+    for (size_t i = 0; i < m; i++)
+    {
+        std::swap(before, score);
+        std::swap(chunkBefore, chunk);
+        std::fill(score, score + n, kNone);
+
+        int32_t gap = kNone; // best of before[k] + gap cost for k <= j - 2
+        for (size_t j = i; j < n; j++)
+        {
+            if (i > 0 && j >= 2) gap = std::max(gap + kGapExtension, before[j - 2] + kGapStart);
+            if (toLowerAscii(name[j]) != pattern[i]) continue;
+
+            if (i == 0)
+            {
+                score[j] = kScoreMatch + bonus[j] * kFirstCharMultiplier;
+                chunk[j] = bonus[j];
+                continue;
+            }
+
+            if (before[j - 1] > kNone)
+            {
+                const int32_t runBonus = std::max({bonus[j], chunkBefore[j - 1], kBonusConsecutive});
+                score[j] = before[j - 1] + kScoreMatch + runBonus;
+                chunk[j] = std::max(chunkBefore[j - 1], bonus[j]);
+            }
+            if (gap > kNone && gap + kScoreMatch + bonus[j] > score[j])
+            {
+                score[j] = gap + kScoreMatch + bonus[j];
+                chunk[j] = bonus[j];
+            }
+        }
+    }
+
+    const int32_t best = *std::max_element(score, score + n);
+    return best > kNone ? std::max(best, 0) : -1;
+}
+
+void FuzzySearch::updateMasks(const NameTable& names)
+{
+    if (names.generation() != m_generation || names.size() < m_masks.size())
+    {
+        m_masks.clear();
+        m_generation = names.generation();
+    }
+
+    m_masks.reserve(names.size());
+    for (size_t id = m_masks.size(); id < names.size(); id++)
+    {
+        m_masks.push_back(charMask(names.get(static_cast<uint32_t>(id))));
+    }
+}
+
+bool FuzzySearch::update(const SceneArena& arena, std::string_view text)
+{
+    const bool arenaChanged = m_dirty || m_revision != arena.revision();
+    if (!arenaChanged && text == m_source) return false;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::string pattern;
+    for (char c : text)
+    {
+        if (c != ' ' && pattern.size() < kMaxPattern) pattern.push_back(toLowerAscii(c));
+    }
+
+    // A longer pattern that starts with the previous one only matches names the previous one matched
+    const bool narrowing = !arenaChanged && !m_pattern.empty() && pattern.rfind(m_pattern, 0) == 0;
+
+    m_source = text;
+    m_pattern = std::move(pattern);
+    m_dirty = false;
+    m_revision = arena.revision();
+    m_results.clear();
+    m_matchCount = 0;
+
+    if (m_pattern.empty())
+    {
+        m_candidates.clear();
+        m_scores.clear();
+        m_lastMs = 0.0;
+        return true;
+    }
+
+    const NameTable& names = arena.names();
+    updateMasks(names);
+    m_groups.build(arena);
+
+    const uint64_t required = charMask(m_pattern);
+    m_candidates.clear();
+    if (narrowing)
+    {
+        for (const NameScore& previous : m_scores)
+        {
+            if ((m_masks[previous.nameId] & required) == required) m_candidates.push_back(previous.nameId);
+        }
+    }
+    else
+    {
+        prefilter(m_masks.data(), m_masks.size(), required, m_candidates);
+    }
+
+    m_scores.clear();
+    for (uint32_t id : m_candidates)
+    {
+        const uint32_t nodes = m_groups.count(id);
+        if (nodes == 0) continue; // no linked object carries this name anymore
+
+        const std::string_view name = names.get(id);
+        const int32_t value = score(name, m_pattern);
+        if (value < 0) continue;
+
+        m_scores.push_back({id, value, static_cast<uint32_t>(name.size())});
+        m_matchCount += nodes;
+    }
+
+    // Every scored name has at least one node, so the best kMaxResults names always fill the result list
+    const size_t top = std::min(m_scores.size(), kMaxResults);
+    auto better = [](const NameScore& a, const NameScore& b)
+    {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.length != b.length) return a.length < b.length;
+        return a.nameId < b.nameId;
+    };
+    std::partial_sort(m_scores.begin(), m_scores.begin() + top, m_scores.end(), better);
+
+    for (size_t i = 0; i < top && m_results.size() < kMaxResults; i++)
+    {
+        const NameScore& name = m_scores[i];
+        for (const uint32_t* node = m_groups.begin(name.nameId); node != m_groups.end(name.nameId); node++)
+        {
+            if (m_results.size() == kMaxResults) break;
+            m_results.push_back({*node, name.score});
+        }
+    }
+
+    m_lastMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
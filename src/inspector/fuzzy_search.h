@@ -0,0 +1,67 @@
+﻿#pragma once
+
+#include "name_index.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+class SceneArena;
+
+// fzf-style fuzzy search over object names: the query's characters must appear in order, and matches are
+// scored by where they land (word starts, camelCase humps, runs of consecutive characters) minus the gaps in
+// between. Every interned name carries a 64-bit mask of the characters it contains; a SIMD pass over those
+// masks rejects the names missing any query character before the scoring pass looks at a single string.
+class FuzzySearch
+{
+public:
+    struct Result
+    {
+        uint32_t index; // arena node
+        int32_t score;
+    };
+
+    static constexpr size_t kMaxResults = 1000;
+
+    // Re-rank if the text or the arena changed. Returns true when the results changed.
+    bool update(const SceneArena& arena, std::string_view text);
+    void invalidate()
+    {
+        m_dirty = true;
+        m_groups.invalidate();
+    }
+
+    const std::vector<Result>& results() const { return m_results; } // best first, at most kMaxResults
+    size_t matchCount() const { return m_matchCount; }                // nodes that matched at all
+    size_t candidateCount() const { return m_candidates.size(); }     // names that passed the prefilter
+    double getLastMs() const { return m_lastMs; }
+
+    // Score of the best alignment of `pattern` (lowercase, no spaces) in `name`, or -1 if it does not match
+    static int32_t score(std::string_view name, std::string_view pattern);
+    static uint64_t charMask(std::string_view text);
+
+private:
+    struct NameScore
+    {
+        uint32_t nameId;
+        int32_t score;
+        uint32_t length;
+    };
+
+    std::vector<uint64_t> m_masks; // per interned name
+    uint32_t m_generation = 0;
+    NameGroups m_groups;
+
+    std::string m_source;
+    std::string m_pattern;
+    uint64_t m_revision = UINT64_MAX;
+    bool m_dirty = true;
+
+    std::vector<uint32_t> m_candidates;
+    std::vector<NameScore> m_scores;
+    std::vector<Result> m_results;
+    size_t m_matchCount = 0;
+    double m_lastMs = 0.0;
+
+    void updateMasks(const NameTable& names);
+};
@@ -0,0 +1,99 @@
+﻿#include "pch.h"
+#include "game_tick.h"
+#include "memory/hook_manager.h"
+
+GameTick::SendWillRenderCanvases_t GameTick::m_originalSendWillRenderCanvases = nullptr;
+
+GameTick& GameTick::getInstance()
+{
+    static GameTick instance;
+    return instance;
+}
+
+bool GameTick::install()
+{
+    if (m_installed) return true;
+
+    auto& hookManager = HookManager::getInstance();
+    if (!hookManager.initialize()) return false;
+
+    // The hook created by an earlier install() is only disabled on uninstall
+    if (m_target)
+    {
+        hookManager.enableHook(m_target);
+        m_installed = true;
+        return true;
+    }
+
+    try
+    {
+        auto uiModule = UnityResolve::Get("UnityEngine.UIModule.dll");
+        auto canvas = uiModule ? uiModule->Get("Canvas") : nullptr;
+        auto method = canvas ? canvas->Get<UnityResolve::Method>("SendWillRenderCanvases") : nullptr;
+        if (!method || !method->function)
+        {
+            LOG_WARNING("[GameTick] Canvas.SendWillRenderCanvases not found, no main thread tick");
+            return false;
+        }
+
+        if (!hookManager.createHook(method->function, hookedSendWillRenderCanvases, &m_originalSendWillRenderCanvases))
+        {
+            LOG_ERROR("[GameTick] Failed to hook Canvas.SendWillRenderCanvases");
+            return false;
+        }
+        m_target = method->function;
+    }
+    catch (...)
+    {
+        LOG_ERROR("[GameTick] Exception while installing hook");
+        return false;
+    }
+
+    m_installed = true;
+    LOG_INFO("[GameTick] Main thread tick installed");
+    return true;
+}
+
+void GameTick::uninstall()
+{
+    if (m_target) HookManager::getInstance().disableHook(m_target);
+    m_installed = false;
+}
+
+void GameTick::add(Callback callback, void* context)
+{
+    std::lock_guard lock(m_mutex);
+    m_listeners.push_back({callback, context});
+}
+
+void GameTick::remove(Callback callback, void* context)
+{
+    std::lock_guard lock(m_mutex);
+    std::erase_if(m_listeners, [&](const Listener& listener)
+    {
+        return listener.callback == callback && listener.context == context;
+    });
+}
+
+void GameTick::run()
+{
+    m_frame.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard lock(m_mutex);
+    for (const Listener& listener : m_listeners)
+    {
+        try
+        {
+            listener.callback(listener.context);
+        }
+        catch (...)
+        {
+        }
+    }
+}
+
+void GameTick::hookedSendWillRenderCanvases(void* method)
+{
+    m_originalSendWillRenderCanvases(method);
+    getInstance().run();
+}
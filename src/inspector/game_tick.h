@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// A per-frame callback on the game's main thread, for work that must run there rather than on the render
+// thread that draws the UI. Hooks UnityEngine.Canvas.SendWillRenderCanvases, which the engine calls once per
+// frame after LateUpdate, before rendering. Games without the UI module have no tick; callers then fall back
+// to running their work from the UI update.
+class GameTick
+{
+public:
+    using Callback = void (*)(void* context);
+
+    static GameTick& getInstance();
+
+    // Install the hook. Returns false if the method could not be resolved or hooked.
+    bool install();
+    void uninstall();
+    bool isInstalled() const { return m_installed; }
+
+    // Called on every tick, in the order added
+    void add(Callback callback, void* context);
+    void remove(Callback callback, void* context);
+
+    // Ticks since install
+    uint64_t getFrame() const { return m_frame.load(std::memory_order_relaxed); }
+
+private:
+    GameTick() = default;
+
+    GameTick(const GameTick&) = delete;
+    GameTick& operator=(const GameTick&) = delete;
+
+    struct Listener
+    {
+        Callback callback;
+        void* context;
+    };
+
+    std::mutex m_mutex; // guards m_listeners; only contended while a listener is being added or removed
+    std::vector<Listener> m_listeners;
+    std::atomic<uint64_t> m_frame{0};
+    void* m_target = nullptr;
+    bool m_installed = false;
+
+    void run();
+
+    static void hookedSendWillRenderCanvases(void* method);
+
+    using SendWillRenderCanvases_t = void (*)(void*);
+
+    static SendWillRenderCanvases_t m_originalSendWillRenderCanvases;
+};
@@ -0,0 +1,626 @@
+﻿#include "pch.h"
+#include "hierarchy_builder.h"
+#include "methods/method_helpers.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Number of objects processed between deadline checks
+    constexpr size_t kCheckInterval = 32;
+
+    std::string readName(UnityResolve::UnityType::GameObject* go)
+    {
+        try
+        {
+            if (auto nameStr = go->GetName()) return nameStr->ToString();
+            return "Unknown GameObject";
+        }
+        catch (...)
+        {
+            return "Error reading GameObject";
+        }
+    }
+}
+
+void HierarchyBuilder::begin(Mode mode, std::vector<int> scenes)
+{
+    m_mode = mode;
+    m_scenes = mode == Mode::Lazy ? std::move(scenes) : std::vector<int>();
+    m_phase = Phase::Enumerate;
+    m_cursor = 0;
+    m_startTime = Clock::now();
+    m_pendingStats = {};
+    m_destroyedDuringScan.clear();
+    m_objects.clear();
+    m_origins.clear();
+    m_records.clear();
+}
+
+void HierarchyBuilder::cancel()
+{
+    m_phase = Phase::Idle;
+    m_objects.clear();
+    m_origins.clear();
+    m_records.clear();
+    m_scenes.clear();
+    m_destroyedDuringScan.clear();
+}
+
+void HierarchyBuilder::loadChildren(SceneArena& arena, uint32_t index)
+{
+    if (arena[index].flags & SceneNode::ChildrenLoaded) return;
+
+    // A scan in flight commits as the next generation; tag the new nodes with it so they are not dropped
+    const uint32_t generation = isRunning() ? m_generation + 1 : m_generation;
+    auto* transform = arena[index].transform;
+    const int32_t scene = arena[index].scene;
+
+    try
+    {
+        const int count = transform ? methods::Transform::GetChildCount(transform) : 0;
+
+        // link() prepends, so walk backwards to keep the sibling order
+        for (int i = count - 1; i >= 0; i--)
+        {
+            auto* childTransform = methods::Transform::GetChild(transform, i);
+            auto* go = childTransform ? childTransform->GetGameObject() : nullptr;
+            if (!go) continue;
+
+            const int32_t instanceId = methods::Object::GetInstanceID(go);
+            uint32_t child = arena.findByInstanceId(instanceId);
+            if (child == SceneArena::kInvalid)
+            {
+                child = arena.create(instanceId, go, childTransform, internName(arena, go));
+            }
+
+            // create() may have grown the arena, so index afresh
+            SceneNode& node = arena[child];
+            node.gameObject = go;
+            node.lastSeen = generation;
+            node.parentTransform = transform;
+            node.scene = scene;
+            node.childCount = static_cast<uint32_t>(methods::Transform::GetChildCount(childTransform));
+            node.setFlag(SceneNode::Active, go->GetActiveSelf());
+            arena.link(child, index);
+        }
+    }
+    catch (...)
+    {
+        LOG_ERROR("[HierarchyBuilder] Failed to load children of %s", arena.names().c_str(arena[index].nameId));
+    }
+
+    arena[index].setFlag(SceneNode::ChildrenLoaded, true);
+}
+
+void HierarchyBuilder::setZeroAlloc(bool enabled)
+{
+    m_zeroAlloc = enabled;
+    m_calibrationAttempted = false;
+    m_layout.reset();
+}
+
+bool HierarchyBuilder::step(SceneArena& arena, uint32_t budgetUs)
+{
+    if (m_phase == Phase::Idle) return false;
+
+    const auto deadline = budgetUs > 0 ? Clock::now() + std::chrono::microseconds(budgetUs) : Clock::time_point::max();
+    m_pendingStats.frames++;
+
+    // Heap growth while we run; the game's own allocations on other threads fall into this window too
+    const int64_t heapBefore = methods::Runtime::GetGcUsedSize();
+    const bool committed = advance(arena, deadline);
+    const int64_t heapAfter = methods::Runtime::GetGcUsedSize();
+
+    if (heapBefore >= 0 && heapAfter > heapBefore)
+    {
+        m_pendingStats.managedBytes += heapAfter - heapBefore;
+    }
+    if (committed)
+    {
+        m_stats.managedBytes = m_pendingStats.managedBytes;
+    }
+    return committed;
+}
+
+bool HierarchyBuilder::advance(SceneArena& arena, Clock::time_point deadline)
+{
+    try
+    {
+        if (m_phase == Phase::Enumerate)
+        {
+            m_walk = m_mode == Mode::Lazy;
+
+            if (m_zeroAlloc && !m_calibrationAttempted && arena.liveCount() > 0)
+            {
+                m_layout.calibrate(arena);
+                m_calibrationAttempted = true;
+            }
+
+            if (m_zeroAlloc && !isPartial() && arena.rootCount() > 0)
+            {
+                enumerateKnownRoots(arena);
+                m_walk = true;
+            }
+            else if (m_mode == Mode::Lazy)
+            {
+                enumerateRoots();
+            }
+            else
+            {
+                auto gameObjectClass = GET_CLASS("UnityEngine.CoreModule.dll", "GameObject");
+                if (!gameObjectClass)
+                {
+                    LOG_ERROR("[HierarchyBuilder] Could not find GameObject class");
+                    cancel();
+                    return false;
+                }
+
+                m_objects = gameObjectClass->FindObjectsByType<UnityResolve::UnityType::GameObject*>();
+            }
+
+            m_records.reserve(m_objects.size());
+            m_cursor = 0;
+            m_phase = Phase::Sample;
+        }
+
+        if (m_phase == Phase::Sample)
+        {
+            if (!sample(arena, deadline)) return false;
+            m_cursor = 0;
+            // A walk reaches every object through its parent, so the parent is already known
+            m_phase = m_walk ? Phase::Commit : Phase::Link;
+        }
+
+        if (m_phase == Phase::Link)
+        {
+            if (!link(deadline)) return false;
+            m_phase = Phase::Commit;
+        }
+
+        if (m_phase == Phase::Commit)
+        {
+            commit(arena);
+            m_phase = Phase::Idle;
+            return true;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("[HierarchyBuilder] Exception during scan: %s", e.what());
+        cancel();
+    } catch (...)
+    {
+        LOG_ERROR("[HierarchyBuilder] Unknown exception during scan");
+        cancel();
+    }
+
+    return false;
+}
+
+HierarchyBuilder::Stats HierarchyBuilder::applyChanges(SceneArena& arena,
+                                                       const std::vector<ObjectRegistry::Change>& changes)
+{
+    Stats stats;
+    const bool lazy = m_mode == Mode::Lazy;
+    bool rootsChanged = false;
+    int32_t activeScene = -1;
+
+    // Objects created and destroyed within the same batch never reach the arena
+    m_batchDestroyed.clear();
+    for (const auto& change : changes)
+    {
+        if (change.type == ObjectRegistry::ChangeType::Destroyed)
+        {
+            m_batchDestroyed.insert(static_cast<uint32_t>(change.instanceId), 0);
+        }
+    }
+
+    for (const auto& change : changes)
+    {
+        if (change.type == ObjectRegistry::ChangeType::ComponentDestroyed) continue; // the tree is unchanged
+        if (change.type == ObjectRegistry::ChangeType::Destroyed)
+        {
+            if (isRunning()) m_destroyedDuringScan.insert(static_cast<uint32_t>(change.instanceId), 0);
+
+            const uint32_t index = arena.findByInstanceId(change.instanceId);
+            if (index == SceneArena::kInvalid) continue;
+
+            stats.removed += prune(arena, index);
+            continue;
+        }
+
+        if (m_batchDestroyed.find(static_cast<uint32_t>(change.instanceId)) != FlatIndexMap::kNotFound) continue;
+        if (arena.findByInstanceId(change.instanceId) != SceneArena::kInvalid) continue;
+
+        try
+        {
+            auto* go = change.gameObject;
+            auto* transform = go->GetTransform();
+            auto* parentTransform = transform ? transform->GetParent() : nullptr;
+            const uint32_t parent = arena.findByTransform(parentTransform);
+
+            // Parent is below a node that was never expanded (lazy) or not known yet; a later scan finds it
+            if (parentTransform && parent == SceneArena::kInvalid) continue;
+            if (lazy && parent != SceneArena::kInvalid && !(arena[parent].flags & SceneNode::ChildrenLoaded))
+            {
+                arena[parent].childCount++;
+                continue;
+            }
+
+            // New roots go to the active scene
+            int32_t scene = 0;
+            if (lazy)
+            {
+                if (parent != SceneArena::kInvalid)
+                {
+                    scene = arena[parent].scene;
+                }
+                else
+                {
+                    if (activeScene < 0) activeScene = methods::SceneManager::GetActiveScene();
+                    scene = activeScene;
+                }
+            }
+
+            const size_t before = arena.liveCount();
+            insertObject(arena, go, transform, parent, scene);
+            stats.added += arena.liveCount() - before;
+            rootsChanged |= parent == SceneArena::kInvalid;
+        }
+        catch (...)
+        {
+            // Destroyed before we got to it; nothing to insert
+        }
+    }
+
+    if (rootsChanged)
+    {
+        arena.sortRoots();
+    }
+
+    stats.total = arena.liveCount();
+    return stats;
+}
+
+size_t HierarchyBuilder::pruneDead(SceneArena& arena, uint32_t maxNodes)
+{
+    size_t removed = 0;
+    const size_t count = std::min<size_t>(maxNodes, arena.capacity());
+    for (size_t i = 0; i < count; i++)
+    {
+        // The arena may shrink its live set below the cursor, but never its capacity
+        if (m_livenessCursor >= arena.capacity()) m_livenessCursor = 0;
+        const uint32_t index = m_livenessCursor++;
+
+        if (arena[index].isAlive() && !arena.isLive(index))
+        {
+            removed += prune(arena, index);
+        }
+    }
+    return removed;
+}
+
+size_t HierarchyBuilder::prune(SceneArena& arena, uint32_t index)
+{
+    // Keep a scan in flight from bringing the object back at its commit
+    if (isRunning()) m_destroyedDuringScan.insert(static_cast<uint32_t>(arena[index].instanceId), 0);
+
+    const uint32_t parent = arena[index].parent;
+    if (parent != SceneArena::kInvalid && arena[parent].childCount > 0) arena[parent].childCount--;
+    return arena.destroySubtree(index);
+}
+
+uint32_t HierarchyBuilder::insertObject(SceneArena& arena, UnityResolve::UnityType::GameObject* go,
+                                        UnityResolve::UnityType::Transform* transform, uint32_t parent,
+                                        int32_t scene)
+{
+    const bool lazy = m_mode == Mode::Lazy;
+    // A scan in flight commits as the next generation; tag the new nodes with it so they are not dropped
+    const uint32_t generation = isRunning() ? m_generation + 1 : m_generation;
+    uint32_t root = SceneArena::kInvalid;
+
+    // Lazy mode inserts the object alone; full mode also inserts the hierarchy that came with it (Instantiate)
+    m_insertStack.clear();
+    m_insertStack.emplace_back(transform, parent);
+    while (!m_insertStack.empty())
+    {
+        auto [current, parentIndex] = m_insertStack.back();
+        m_insertStack.pop_back();
+
+        auto* currentGo = current == transform ? go : current->GetGameObject();
+        if (!currentGo) continue;
+
+        const uint32_t index = arena.create(methods::Object::GetInstanceID(currentGo), currentGo, current,
+                                            internName(arena, currentGo));
+        const int childCount = methods::Transform::GetChildCount(current);
+
+        SceneNode& node = arena[index];
+        node.lastSeen = generation;
+        node.scene = scene;
+        node.parentTransform = parentIndex != SceneArena::kInvalid ? arena[parentIndex].transform : nullptr;
+        node.setFlag(SceneNode::Active, currentGo->GetActiveSelf());
+        if (lazy)
+        {
+            node.childCount = static_cast<uint32_t>(childCount);
+        }
+        else
+        {
+            node.setFlag(SceneNode::ChildrenLoaded, true);
+            // Popped last-first and link() prepends, so pushing in order keeps the sibling order
+            for (int i = 0; i < childCount; i++)
+            {
+                if (auto* child = methods::Transform::GetChild(current, i)) m_insertStack.emplace_back(child, index);
+            }
+        }
+
+        arena.link(index, parentIndex);
+        if (lazy && parentIndex != SceneArena::kInvalid) arena[parentIndex].childCount++;
+        if (root == SceneArena::kInvalid) root = index;
+    }
+    return root;
+}
+
+void HierarchyBuilder::enumerateKnownRoots(const SceneArena& arena)
+{
+    for (uint32_t root = arena.firstRoot(); root != SceneArena::kInvalid; root = arena[root].nextSibling)
+    {
+        m_objects.push_back(arena[root].gameObject);
+        m_origins.push_back({nullptr, arena[root].scene});
+    }
+}
+
+uint32_t HierarchyBuilder::internName(SceneArena& arena, UnityResolve::UnityType::GameObject* go)
+{
+    if (m_zeroAlloc && m_layout.isCalibrated())
+    {
+        std::string_view name = m_layout.readName(go);
+        if (!name.empty()) return arena.names().intern(name);
+    }
+    return arena.names().intern(readName(go));
+}
+
+void HierarchyBuilder::enumerateRoots()
+{
+    // Objects moved to DontDestroyOnLoad live in a scene SceneManager does not list; full mode still sees them
+    const int sceneCount = methods::SceneManager::GetSceneCount();
+    for (int i = 0; i < sceneCount; i++)
+    {
+        const int scene = methods::SceneManager::GetSceneAt(i);
+        if (!methods::Scene::IsLoaded(scene)) continue;
+        if (isPartial() && std::find(m_scenes.begin(), m_scenes.end(), scene) == m_scenes.end()) continue;
+
+        for (auto* root : methods::Scene::GetRootGameObjects(scene))
+        {
+            m_objects.push_back(root);
+            m_origins.push_back({nullptr, scene});
+        }
+    }
+}
+
+bool HierarchyBuilder::sample(SceneArena& arena, Clock::time_point deadline)
+{
+    // During a walk m_objects grows while it is consumed: children are queued behind their parent
+    while (m_cursor < m_objects.size())
+    {
+        const size_t entry = m_cursor++;
+        auto* go = m_objects[entry];
+        if (!go) continue;
+
+        // Destroyed objects keep their managed wrapper but lose the native object
+        if (m_walk && !NativeObjectLayout::getCachedPtr(go)) continue;
+
+        Record record{};
+        record.gameObject = go;
+        record.instanceId = methods::Object::GetInstanceID(go);
+        record.existing = arena.findByInstanceId(record.instanceId);
+        record.nameId = SceneArena::kInvalid;
+
+        try
+        {
+            record.isActive = go->GetActiveSelf();
+            if (record.existing != SceneArena::kInvalid)
+            {
+                // Transform and name of a known object do not change; skip the managed calls
+                record.transform = arena[record.existing].transform;
+            }
+            else
+            {
+                record.transform = go->GetTransform();
+                record.nameId = internName(arena, go);
+            }
+
+            if (m_walk && record.transform)
+            {
+                // A root from the previous scan may have been parented since; its new parent reaches it
+                if (!m_origins[entry].parent && record.transform->GetParent()) continue;
+
+                record.parentTransform = m_origins[entry].parent;
+                record.scene = m_origins[entry].scene;
+                record.childCount = static_cast<uint32_t>(methods::Transform::GetChildCount(record.transform));
+
+                // Full mode walks everything; lazy mode only below nodes that have been expanded
+                const bool expanded = m_mode == Mode::Full || (record.existing != SceneArena::kInvalid &&
+                    (arena[record.existing].flags & SceneNode::ChildrenLoaded));
+                for (uint32_t i = 0; expanded && i < record.childCount; i++)
+                {
+                    auto* child = methods::Transform::GetChild(record.transform, static_cast<int>(i));
+                    if (!child) continue;
+                    m_objects.push_back(child->GetGameObject());
+                    m_origins.push_back({record.transform, record.scene});
+                }
+            }
+        }
+        catch (...)
+        {
+            record.isActive = false;
+        }
+
+        m_records.push_back(record);
+
+        if (m_cursor % kCheckInterval == 0 && Clock::now() >= deadline) return false;
+    }
+
+    m_objects.clear();
+    m_origins.clear();
+    return true;
+}
+
+bool HierarchyBuilder::link(Clock::time_point deadline)
+{
+    while (m_cursor < m_records.size())
+    {
+        Record& record = m_records[m_cursor++];
+        try
+        {
+            record.parentTransform = record.transform ? record.transform->GetParent() : nullptr;
+        }
+        catch (...)
+        {
+            // If we can't get parent info, treat as root
+            record.parentTransform = nullptr;
+        }
+
+        if (m_cursor % kCheckInterval == 0 && Clock::now() >= deadline) return false;
+    }
+    return true;
+}
+
+void HierarchyBuilder::commit(SceneArena& arena)
+{
+    Stats& stats = m_pendingStats;
+    const uint32_t generation = ++m_generation;
+
+    // Match records against the arena. New nodes are created before anything is destroyed,
+    // so a freed slot is never handed to a new object within the same commit.
+    for (Record& record : m_records)
+    {
+        if (m_destroyedDuringScan.find(static_cast<uint32_t>(record.instanceId)) != FlatIndexMap::kNotFound)
+        {
+            record.existing = SceneArena::kInvalid;
+            continue;
+        }
+
+        uint32_t index = arena.findByInstanceId(record.instanceId);
+        if (index == SceneArena::kInvalid)
+        {
+            // Object was unknown at sample time, or got pruned since. Without a name we pick it up next scan.
+            if (record.nameId == SceneArena::kInvalid)
+            {
+                record.existing = SceneArena::kInvalid;
+                continue;
+            }
+            index = arena.create(record.instanceId, record.gameObject, record.transform, record.nameId);
+            stats.added++;
+        }
+        else if (arena[index].lastSeen == generation)
+        {
+            record.existing = SceneArena::kInvalid; // duplicate entry
+            continue;
+        }
+
+        SceneNode& node = arena[index];
+        node.gameObject = record.gameObject;
+        node.lastSeen = generation;
+        node.setFlag(SceneNode::Active, record.isActive);
+        if (m_mode == Mode::Lazy)
+        {
+            node.childCount = record.childCount;
+            node.scene = record.scene;
+        }
+        else
+        {
+            // The full scan links every child itself; nothing is left to load on expand
+            node.setFlag(SceneNode::ChildrenLoaded, true);
+        }
+        record.existing = index;
+    }
+
+    // Find nodes whose parent changed. New nodes always need linking.
+    m_relink.clear();
+    for (const Record& record : m_records)
+    {
+        if (record.existing == SceneArena::kInvalid) continue;
+
+        SceneNode& node = arena[record.existing];
+        auto parentTransform = record.parentTransform;
+        uint32_t parent = arena.findByTransform(parentTransform);
+        if (parent != SceneArena::kInvalid && arena[parent].lastSeen != generation) parent = SceneArena::kInvalid;
+        if (parent == SceneArena::kInvalid) parentTransform = nullptr;
+
+        if (node.isLinked() && parentTransform == node.parentTransform && parent == node.parent) continue;
+
+        if (node.isLinked()) stats.reparented++;
+        node.parentTransform = parentTransform;
+        m_relink.emplace_back(record.existing, parent);
+    }
+
+    // Drop nodes that were not seen this scan
+    for (uint32_t index = 0; index < arena.capacity(); index++)
+    {
+        const SceneNode& node = arena[index];
+        if (!node.isAlive() || node.lastSeen == generation) continue;
+        if (isPartial() && std::find(m_scenes.begin(), m_scenes.end(), node.scene) == m_scenes.end()) continue;
+
+        arena.destroy(index);
+        stats.removed++;
+    }
+
+    bool rootsChanged = stats.removed > 0;
+    for (auto& [index, parent] : m_relink)
+    {
+        arena.link(index, parent);
+        rootsChanged |= parent == SceneArena::kInvalid;
+    }
+    for (auto& [index, parent] : m_relink)
+    {
+        uint16_t depth = parent != SceneArena::kInvalid ? static_cast<uint16_t>(arena[parent].depth + 1) : 0;
+        arena.updateDepth(index, depth);
+    }
+
+    // Sort root objects by name for consistency
+    if (rootsChanged)
+    {
+        arena.sortRoots();
+    }
+
+    stats.total = arena.liveCount();
+    stats.elapsedMs = std::chrono::duration<float, std::milli>(Clock::now() - m_startTime).count();
+    m_stats = stats;
+    m_records.clear();
+    m_scenes.clear();
+}
+
+const char* HierarchyBuilder::getPhaseName() const
+{
+    switch (m_phase)
+    {
+    case Phase::Idle:
+        return "Idle";
+    case Phase::Enumerate:
+        return "Enumerating";
+    case Phase::Sample:
+        return "Sampling";
+    case Phase::Link:
+        return "Linking";
+    case Phase::Commit:
+        return "Committing";
+    default:
+        return "Unknown";
+    }
+}
+
+float HierarchyBuilder::getProgress() const
+{
+    switch (m_phase)
+    {
+    case Phase::Sample:
+        return m_objects.empty() ? 0.0f : 0.5f * m_cursor / m_objects.size();
+    case Phase::Link:
+        return m_records.empty() ? 0.5f : 0.5f + 0.5f * m_cursor / m_records.size();
+    case Phase::Commit:
+        return 1.0f;
+    default:
+        return 0.0f;
+    }
+}
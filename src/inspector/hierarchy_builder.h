@@ -0,0 +1,136 @@
+﻿#pragma once
+
+#include <chrono>
+
+#include "native_object.h"
+#include "object_registry.h"
+#include "scene_arena.h"
+
+// Resumable scene scan. Each call to step() does at most a given number of microseconds of Unity work,
+// so a large scene is scanned over several frames. The arena is only modified by the final commit,
+// which means the UI keeps showing the previous complete snapshot until the new one is ready.
+class HierarchyBuilder
+{
+public:
+    enum class Mode
+    {
+        Full, // every GameObject via FindObjectsByType
+        Lazy, // scene roots plus the children of nodes that have been expanded
+    };
+
+    enum class Phase
+    {
+        Idle,
+        Enumerate, // FindObjectsByType, or the scene roots in lazy mode
+        Sample, // instance ID, active flag and (for new objects) transform and name
+        Link, // parent transform of every object (full mode only)
+        Commit, // apply the diff to the arena
+    };
+
+    struct Stats
+    {
+        size_t added = 0;
+        size_t removed = 0;
+        size_t reparented = 0;
+        size_t total = 0;
+        float elapsedMs = 0.0f; // wall time from begin() to commit
+        int frames = 0; // number of step() calls the scan was spread over
+        int64_t managedBytes = 0; // managed heap growth during step() calls, includes other threads
+
+        size_t changed() const { return added + removed + reparented; }
+    };
+
+    // Start a new scan. Restarts from scratch if one is already running. A lazy scan can be limited to a
+    // set of scene handles; nodes of other scenes are then left untouched by the commit.
+    void begin(Mode mode = Mode::Full, std::vector<int> scenes = {});
+    void cancel();
+
+    // Populate the direct children of a node right away (lazy mode on-expand). Children found this way are
+    // kept alive by the scan in flight, if any, and are refreshed by every later lazy scan.
+    void loadChildren(SceneArena& arena, uint32_t index);
+
+    // Patch the arena from the object lifetime journal without scanning. Created objects are inserted under
+    // their parent, or as roots; in lazy mode an object below a node that was never expanded only bumps that
+    // node's child count. Returns the number of nodes added and removed.
+    Stats applyChanges(SceneArena& arena, const std::vector<ObjectRegistry::Change>& changes);
+
+    // Liveness sweep: check up to maxNodes nodes, continuing where the previous call stopped, and remove the
+    // dead ones together with their subtree. Costs one memory read per node and no Unity calls.
+    size_t pruneDead(SceneArena& arena, uint32_t maxNodes);
+    // Remove a node whose object is gone, with its subtree. Returns the number of nodes removed.
+    size_t prune(SceneArena& arena, uint32_t index);
+
+    // Advance the scan. Returns true when the scan has been committed during this call.
+    // A budget of 0 runs the whole scan to completion.
+    bool step(SceneArena& arena, uint32_t budgetUs);
+
+    // Zero-GC scanning: rescans walk the tree from the roots already in the arena through allocation-free
+    // accessors (GetChild, childCount, activeSelf) and read names from native memory. Only the first scan and
+    // scene loads enumerate through managed arrays; new root objects are otherwise found by live tracking.
+    void setZeroAlloc(bool enabled);
+    bool isZeroAlloc() const { return m_zeroAlloc; }
+
+    bool isRunning() const { return m_phase != Phase::Idle; }
+    Mode getMode() const { return m_mode; }
+    const std::vector<int>& getScenes() const { return m_scenes; }
+    bool isPartial() const { return !m_scenes.empty(); }
+    Phase getPhase() const { return m_phase; }
+    const char* getPhaseName() const;
+    float getProgress() const;
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    struct Record
+    {
+        UnityResolve::UnityType::GameObject* gameObject;
+        UnityResolve::UnityType::Transform* transform;
+        UnityResolve::UnityType::Transform* parentTransform;
+        int32_t instanceId;
+        uint32_t nameId; // only valid for new objects
+        uint32_t existing; // arena index, or kInvalid for new objects
+        uint32_t childCount; // lazy mode only
+        int32_t scene; // lazy mode only
+        bool isActive;
+    };
+
+    // Where a lazily enumerated object was reached from
+    struct Origin
+    {
+        UnityResolve::UnityType::Transform* parent;
+        int32_t scene;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    Mode m_mode = Mode::Full;
+    Phase m_phase = Phase::Idle;
+    bool m_walk = false; // objects are reached through their parent, so the Link phase is skipped
+    bool m_zeroAlloc = false;
+    bool m_calibrationAttempted = false;
+    NativeObjectLayout m_layout;
+    size_t m_cursor = 0;
+    uint32_t m_livenessCursor = 0;
+    uint32_t m_generation = 0;
+    Clock::time_point m_startTime;
+    Stats m_stats;
+    Stats m_pendingStats;
+
+    std::vector<UnityResolve::UnityType::GameObject*> m_objects;
+    std::vector<Origin> m_origins; // lazy mode: one per entry in m_objects
+    std::vector<int> m_scenes; // scenes a partial scan is limited to, empty for all
+    std::vector<Record> m_records;
+    std::vector<std::pair<uint32_t, uint32_t>> m_relink; // node, new parent
+    FlatIndexMap m_destroyedDuringScan; // instance IDs the commit must not bring back
+    FlatIndexMap m_batchDestroyed;
+    std::vector<std::pair<UnityResolve::UnityType::Transform*, uint32_t>> m_insertStack; // transform, parent node
+
+    bool advance(SceneArena& arena, Clock::time_point deadline);
+    void enumerateRoots();
+    void enumerateKnownRoots(const SceneArena& arena);
+    uint32_t internName(SceneArena& arena, UnityResolve::UnityType::GameObject* go);
+    bool sample(SceneArena& arena, Clock::time_point deadline);
+    bool link(Clock::time_point deadline);
+    void commit(SceneArena& arena);
+    uint32_t insertObject(SceneArena& arena, UnityResolve::UnityType::GameObject* go,
+                          UnityResolve::UnityType::Transform* transform, uint32_t parent, int32_t scene);
+};
@@ -0,0 +1,106 @@
+﻿#include "pch.h"
+#include "hierarchy_view.h"
+#include "scene_arena.h"
+
+#include <algorithm>
+
+void HierarchyView::setFilter(const std::string& text, bool showInactive)
+{
+    if (text == m_filterText && showInactive == m_showInactive) return;
+    if (text != m_filterText)
+    {
+        m_collapsedMatches.clear();
+        m_revealMatches = true;
+    }
+    m_filterText = text;
+    m_showInactive = showInactive;
+    m_dirty = true;
+}
+
+void HierarchyView::update(const SceneArena& arena, std::vector<uint32_t>& pendingExpand)
+{
+    if (m_filter.update(arena, m_filterText)) m_dirty = true;
+    if (!m_dirty && m_revision == arena.revision()) return;
+    m_dirty = false;
+    m_revision = arena.revision();
+    m_rebuilds++;
+
+    m_rows.clear();
+    m_stack.clear();
+
+    // Depth-first with an explicit stack; siblings are pushed in reverse so they pop in list order. Inactive
+    // nodes hide their subtree, matches included; with a filter set, only matches and their ancestors remain.
+    const bool filtered = m_filter.isActive();
+    auto pushSiblings = [&](uint32_t first, uint16_t depth)
+    {
+        const size_t mark = m_stack.size();
+        for (uint32_t index = first; index != SceneArena::kInvalid; index = arena[index].nextSibling)
+        {
+            const SceneNode& node = arena[index];
+            if (!node.gameObject || (!m_showInactive && !node.isActive())) continue;
+            if (filtered && !m_filter.isVisible(index)) continue;
+            m_stack.push_back({index, depth});
+        }
+        std::reverse(m_stack.begin() + mark, m_stack.end());
+    };
+
+    pushSiblings(arena.firstRoot(), 0);
+    while (!m_stack.empty())
+    {
+        const Row row = m_stack.back();
+        m_stack.pop_back();
+        m_rows.push_back(row);
+
+        const SceneNode& node = arena[row.index];
+        if (!node.mayHaveChildren() || !isExpanded(node, row.index)) continue;
+
+        if (!(node.flags & SceneNode::ChildrenLoaded)) pendingExpand.push_back(row.index);
+        pushSiblings(node.firstChild, static_cast<uint16_t>(row.depth + 1));
+    }
+}
+
+bool HierarchyView::isRevealed(uint32_t index) const
+{
+    return m_revealMatches && m_filter.isActive() && m_filter.hasMatchBelow(index);
+}
+
+bool HierarchyView::isExpanded(const SceneNode& node, uint32_t index) const
+{
+    if (isRevealed(index)) return !m_collapsedMatches.count(node.instanceId);
+    return m_expanded.count(node.instanceId) != 0;
+}
+
+void HierarchyView::setExpanded(const SceneNode& node, uint32_t index, bool expanded)
+{
+    // Nodes opened by the filter are tracked separately so clearing the filter restores the saved expansion
+    if (isRevealed(index))
+    {
+        if (expanded) m_collapsedMatches.erase(node.instanceId);
+        else m_collapsedMatches.insert(node.instanceId);
+    }
+    else if (expanded)
+    {
+        m_expanded.insert(node.instanceId);
+    }
+    else
+    {
+        m_expanded.erase(node.instanceId);
+    }
+    m_dirty = true;
+}
+
+void HierarchyView::collapseAll()
+{
+    m_expanded.clear();
+    m_collapsedMatches.clear();
+    m_revealMatches = false; // until the filter changes
+    m_dirty = true;
+}
+
+void HierarchyView::reveal(const SceneArena& arena, uint32_t index)
+{
+    for (uint32_t parent = arena[index].parent; parent != SceneArena::kInvalid; parent = arena[parent].parent)
+    {
+        setExpanded(arena[parent], parent, true);
+    }
+}
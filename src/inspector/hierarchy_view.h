@@ -0,0 +1,70 @@
+﻿#pragma once
+
+#include "scene_filter.h"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class SceneArena;
+struct SceneNode;
+
+// The Scene Explorer tree flattened into the rows that are currently visible: every node that passes the
+// filter and whose ancestors are all expanded, in display order. The list is rebuilt only when the arena
+// structure, the expansion state or the filter changes, so drawing a frame is a clipped walk over an array.
+// Expansion is kept per instance ID, which survives rescans that recreate the arena. While a filter is set,
+// nodes above a match are opened without touching the saved expansion, unless collapsed under that filter.
+class HierarchyView
+{
+public:
+    struct Row
+    {
+        uint32_t index; // arena node
+        uint16_t depth;
+    };
+
+    // Marks the rows stale when the filter text or the inactive toggle differ from the last call
+    void setFilter(const std::string& text, bool showInactive);
+    void invalidate()
+    {
+        m_dirty = true;
+        m_filter.invalidate();
+    }
+
+    // Rebuild the rows if anything changed. Expanded nodes whose children are not loaded yet are appended to
+    // `pendingExpand`.
+    void update(const SceneArena& arena, std::vector<uint32_t>& pendingExpand);
+
+    bool isExpanded(const SceneNode& node, uint32_t index) const;
+    void setExpanded(const SceneNode& node, uint32_t index, bool expanded);
+    void collapseAll();
+    // Expand every ancestor of the node so its row becomes visible
+    void reveal(const SceneArena& arena, uint32_t index);
+
+    // Advance a running filter query; its results mark the rows stale once it finishes
+    void stepFilter(const SceneArena& arena, uint32_t budgetUs)
+    {
+        if (m_filter.step(arena, budgetUs)) m_dirty = true;
+    }
+
+    const SceneFilter& filter() const { return m_filter; }
+
+    const std::vector<Row>& rows() const { return m_rows; }
+    size_t size() const { return m_rows.size(); }
+    uint32_t getRebuildCount() const { return m_rebuilds; }
+
+private:
+    std::vector<Row> m_rows;
+    std::unordered_set<int32_t> m_expanded;
+    std::unordered_set<int32_t> m_collapsedMatches; // revealed by the current filter, then closed by the user
+    std::vector<Row> m_stack;
+    SceneFilter m_filter;
+    std::string m_filterText;
+    bool m_showInactive = false;
+    bool m_revealMatches = true;
+    bool m_dirty = true;
+    uint64_t m_revision = UINT64_MAX;
+    uint32_t m_rebuilds = 0;
+
+    bool isRevealed(uint32_t index) const;
+};
@@ -0,0 +1,128 @@
+﻿#include "pch.h"
+#include "name_index.h"
+#include "scene_arena.h"
+
+#include <algorithm>
+
+bool containsLowercase(std::string_view name, std::string_view needle)
+{
+    if (needle.size() > name.size()) return false;
+
+    // Names are folded one character at a time instead of lowercasing a copy
+    const char first = needle[0];
+    const size_t last = name.size() - needle.size();
+    for (size_t i = 0; i <= last; i++)
+    {
+        if (toLowerAscii(name[i]) != first) continue;
+
+        size_t j = 1;
+        while (j < needle.size() && toLowerAscii(name[i + j]) == needle[j]) j++;
+        if (j == needle.size()) return true;
+    }
+    return false;
+}
+
+void NameTrigramIndex::update(const NameTable& names)
+{
+    if (names.generation() != m_generation || names.size() < m_indexed)
+    {
+        clear();
+        m_generation = names.generation();
+    }
+
+    for (; m_indexed < names.size(); m_indexed++)
+    {
+        const std::string_view name = names.get(m_indexed);
+        if (name.size() < 3) continue;
+
+        m_lower.resize(name.size());
+        for (size_t i = 0; i < name.size(); i++) m_lower[i] = toLowerAscii(name[i]);
+        for (size_t i = 0; i + 3 <= name.size(); i++)
+        {
+            // Ids arrive in ascending order, so a repeated trigram within one name is the list's last entry
+            std::vector<uint32_t>& list = m_postings[trigram(m_lower.data() + i)];
+            if (list.empty() || list.back() != m_indexed) list.push_back(m_indexed);
+        }
+    }
+}
+
+void NameTrigramIndex::clear()
+{
+    m_postings.clear();
+    m_indexed = 0;
+}
+
+void NameTrigramIndex::find(const NameTable& names, std::string_view needle, std::vector<uint32_t>& out) const
+{
+    const auto count = static_cast<uint32_t>(std::min<size_t>(names.size(), m_indexed));
+    if (needle.size() < 3)
+    {
+        for (uint32_t id = 0; id < count; id++)
+        {
+            if (containsLowercase(names.get(id), needle)) out.push_back(id);
+        }
+        return;
+    }
+
+    m_lists.clear();
+    for (size_t i = 0; i + 3 <= needle.size(); i++)
+    {
+        auto it = m_postings.find(trigram(needle.data() + i));
+        if (it == m_postings.end()) return; // some trigram occurs in no name at all
+        m_lists.push_back(&it->second);
+    }
+    std::sort(m_lists.begin(), m_lists.end(), [](auto* a, auto* b)
+    {
+        return a->size() != b->size() ? a->size() < b->size() : a < b;
+    });
+    m_lists.erase(std::unique(m_lists.begin(), m_lists.end()), m_lists.end());
+
+    // Intersect into the smallest list; the others are only probed, with a search window that only moves forward
+    m_candidates.assign(m_lists[0]->begin(), m_lists[0]->end());
+    for (size_t list = 1; list < m_lists.size() && !m_candidates.empty(); list++)
+    {
+        auto from = m_lists[list]->begin();
+        const auto end = m_lists[list]->end();
+        size_t kept = 0;
+        for (uint32_t id : m_candidates)
+        {
+            from = std::lower_bound(from, end, id);
+            if (from == end) break;
+            if (*from == id) m_candidates[kept++] = id;
+        }
+        m_candidates.resize(kept);
+    }
+
+    for (uint32_t id : m_candidates)
+    {
+        if (containsLowercase(names.get(id), needle)) out.push_back(id);
+    }
+}
+
+size_t NameTrigramIndex::memoryUsage() const
+{
+    size_t bytes = m_postings.size() * (sizeof(uint32_t) + sizeof(std::vector<uint32_t>) + 2 * sizeof(void*));
+    for (const auto& [key, list] : m_postings) bytes += list.capacity() * sizeof(uint32_t);
+    return bytes;
+}
+
+void NameGroups::build(const SceneArena& arena)
+{
+    if (m_revision == arena.revision() && m_offsets.size() == arena.names().size() + 1) return;
+    m_revision = arena.revision();
+
+    // offsets[id]..offsets[id + 1] are the nodes named `id`
+    m_offsets.assign(arena.names().size() + 1, 0);
+    for (uint32_t index = 0; index < arena.capacity(); index++)
+    {
+        if (arena[index].isLinked()) m_offsets[arena[index].nameId + 1]++;
+    }
+    for (size_t id = 1; id < m_offsets.size(); id++) m_offsets[id] += m_offsets[id - 1];
+
+    m_nodes.resize(m_offsets.back());
+    m_fill.assign(m_offsets.begin(), m_offsets.end() - 1);
+    for (uint32_t index = 0; index < arena.capacity(); index++)
+    {
+        if (arena[index].isLinked()) m_nodes[m_fill[arena[index].nameId]++] = index;
+    }
+}
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class NameTable;
+class SceneArena;
+
+// ASCII case folding for the object search; everything outside A-Z compares as is
+inline char toLowerAscii(char c)
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Whether `name` contains `needle` ignoring case. `needle` must already be lowercase and not empty.
+bool containsLowercase(std::string_view name, std::string_view needle);
+
+// Inverted index from every lowercase trigram to the ascending list of interned name ids containing it. The
+// name table only grows between clears, so updating indexes just the ids added since the last call. A query
+// intersects the posting lists of the needle's trigrams, smallest first, and verifies the survivors, since
+// sharing all trigrams does not imply containing the substring. Needles shorter than a trigram scan the names.
+class NameTrigramIndex
+{
+public:
+    void update(const NameTable& names);
+    void clear();
+
+    // Appends the ids of names containing `needle` (lowercase, not empty) to `out` in ascending order.
+    // The index must be up to date with `names`.
+    void find(const NameTable& names, std::string_view needle, std::vector<uint32_t>& out) const;
+
+    size_t size() const { return m_indexed; } // names indexed
+    size_t trigramCount() const { return m_postings.size(); }
+    size_t memoryUsage() const;
+
+private:
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings;
+    uint32_t m_indexed = 0;
+    uint32_t m_generation = 0;
+    std::string m_lower; // update scratch
+
+    mutable std::vector<const std::vector<uint32_t>*> m_lists; // query scratch
+    mutable std::vector<uint32_t> m_candidates;
+
+    static uint32_t trigram(const char* chars)
+    {
+        return static_cast<uint8_t>(chars[0]) | static_cast<uint8_t>(chars[1]) << 8 |
+            static_cast<uint32_t>(static_cast<uint8_t>(chars[2])) << 16;
+    }
+};
+
+// The arena's linked nodes grouped by name ID, so a set of matching names maps to its nodes without scanning
+// the scene. Built by a counting sort over the slots and rebuilt only when the arena changes.
+class NameGroups
+{
+public:
+    void build(const SceneArena& arena); // no-op while current
+    void invalidate() { m_revision = UINT64_MAX; }
+
+    const uint32_t* begin(uint32_t nameId) const { return m_nodes.data() + m_offsets[nameId]; }
+    const uint32_t* end(uint32_t nameId) const { return m_nodes.data() + m_offsets[nameId + 1]; }
+    uint32_t count(uint32_t nameId) const { return m_offsets[nameId + 1] - m_offsets[nameId]; }
+
+private:
+    std::vector<uint32_t> m_offsets; // per name ID, into m_nodes
+    std::vector<uint32_t> m_nodes;
+    std::vector<uint32_t> m_fill;
+    uint64_t m_revision = UINT64_MAX;
+};
@@ -0,0 +1,106 @@
+﻿#include "pch.h"
+#include "native_object.h"
+#include "scene_arena.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr size_t kMaxNameLength = 1024;
+    constexpr int kMaxNameOffset = 0x100; // search window into the native GameObject
+    constexpr size_t kCalibrationSamples = 8;
+    constexpr size_t kMinCalibrationSamples = 4;
+
+    // C string behind a pointer field of a native object, or nullptr if the pointer is implausible or a read faults
+    const char* readStringField(const void* base, int offset, size_t* length)
+    {
+        __try
+        {
+            auto str = *reinterpret_cast<const char* const*>(static_cast<const char*>(base) + offset);
+            if (reinterpret_cast<uintptr_t>(str) < 0x10000) return nullptr;
+
+            *length = strnlen(str, kMaxNameLength);
+            return *length < kMaxNameLength ? str : nullptr;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER)
+        {
+            return nullptr;
+        }
+    }
+}
+
+void* NativeObjectLayout::getCachedPtr(UnityResolve::UnityType::UnityObject* object)
+{
+    static int offset = -1;
+    if (offset < 0)
+    {
+        auto field = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Object")->Get<UnityResolve::Field>(
+            "m_CachedPtr");
+        offset = field ? field->offset : 0;
+    }
+    if (!object || offset <= 0) return nullptr;
+
+    return *reinterpret_cast<void**>(reinterpret_cast<char*>(object) + offset);
+}
+
+bool NativeObjectLayout::calibrate(const SceneArena& arena)
+{
+    struct Sample
+    {
+        void* native;
+        std::string_view name;
+    };
+
+    // Distinct, non-empty names only; a common name like "Cube" would match by accident more easily
+    Sample samples[kCalibrationSamples];
+    uint32_t sampleNames[kCalibrationSamples];
+    size_t count = 0;
+    for (uint32_t index = 0; index < arena.capacity() && count < kCalibrationSamples; index++)
+    {
+        const SceneNode& node = arena[index];
+        if (!node.isAlive() || !node.gameObject || arena.nameOf(index).empty()) continue;
+        if (std::find(sampleNames, sampleNames + count, node.nameId) != sampleNames + count) continue;
+
+        void* native = getCachedPtr(node.gameObject);
+        if (!native) continue;
+
+        samples[count] = {native, arena.nameOf(index)};
+        sampleNames[count] = node.nameId;
+        count++;
+    }
+
+    if (count < kMinCalibrationSamples) return false;
+
+    for (int offset = 0; offset < kMaxNameOffset; offset += sizeof(void*))
+    {
+        bool matches = true;
+        for (size_t i = 0; i < count && matches; i++)
+        {
+            size_t length = 0;
+            const char* str = readStringField(samples[i].native, offset, &length);
+            matches = str && std::string_view(str, length) == samples[i].name;
+        }
+
+        if (matches)
+        {
+            m_nameOffset = offset;
+            LOG_INFO("[NativeObjectLayout] GameObject name found at native offset 0x%X", offset);
+            return true;
+        }
+    }
+
+    LOG_WARNING("[NativeObjectLayout] Could not locate the native GameObject name, using managed names");
+    return false;
+}
+
+std::string_view NativeObjectLayout::readName(UnityResolve::UnityType::GameObject* gameObject) const
+{
+    if (m_nameOffset < 0) return {};
+
+    void* native = getCachedPtr(gameObject);
+    if (!native) return {};
+
+    size_t length = 0;
+    const char* str = readStringField(native, m_nameOffset, &length);
+    return str ? std::string_view(str, length) : std::string_view();
+}
@@ -0,0 +1,26 @@
+﻿#pragma once
+
+#include <string_view>
+
+class SceneArena;
+
+// Reads GameObject data straight from the native object behind UnityEngine.Object.m_CachedPtr, so no managed
+// strings are allocated. The native layout differs between Unity versions; the name field offset is found at
+// runtime by matching native memory against names that were already read through the managed API.
+class NativeObjectLayout
+{
+public:
+    // Native object behind a managed wrapper; null once the object has been destroyed
+    static void* getCachedPtr(UnityResolve::UnityType::UnityObject* object);
+
+    // Look for the name offset using live nodes whose name is known. Needs a handful of distinct names.
+    bool calibrate(const SceneArena& arena);
+    bool isCalibrated() const { return m_nameOffset >= 0; }
+    void reset() { m_nameOffset = -1; }
+
+    // Name of a GameObject from native memory. Empty if uncalibrated or unreadable.
+    std::string_view readName(UnityResolve::UnityType::GameObject* gameObject) const;
+
+private:
+    int m_nameOffset = -1;
+};
@@ -0,0 +1,258 @@
+﻿#include "pch.h"
+#include "object_registry.h"
+#include "memory/hook_manager.h"
+
+ObjectRegistry::CloneSingle_t ObjectRegistry::m_originalCloneSingle = nullptr;
+ObjectRegistry::CloneSingleWithParent_t ObjectRegistry::m_originalCloneSingleWithParent = nullptr;
+ObjectRegistry::InstantiateSingle_t ObjectRegistry::m_originalInstantiateSingle = nullptr;
+ObjectRegistry::InstantiateSingleWithParent_t ObjectRegistry::m_originalInstantiateSingleWithParent = nullptr;
+ObjectRegistry::CreateGameObject_t ObjectRegistry::m_originalCreateGameObject = nullptr;
+ObjectRegistry::Destroy_t ObjectRegistry::m_originalDestroy = nullptr;
+ObjectRegistry::DestroyImmediate_t ObjectRegistry::m_originalDestroyImmediate = nullptr;
+
+namespace
+{
+    void* resolveMethod(const char* className, const char* name, const std::vector<std::string>& args)
+    {
+        auto klass = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get(className);
+        if (!klass) return nullptr;
+
+        auto method = klass->Get<UnityResolve::Method>(name, args);
+        return method ? method->function : nullptr;
+    }
+}
+
+ObjectRegistry& ObjectRegistry::getInstance()
+{
+    static ObjectRegistry instance;
+    return instance;
+}
+
+bool ObjectRegistry::install()
+{
+    if (m_installed) return true;
+
+    auto& hookManager = HookManager::getInstance();
+    if (!hookManager.initialize()) return false;
+
+    // Hooks created by an earlier install() are only disabled on uninstall
+    if (!m_targets.empty())
+    {
+        for (void* target : m_targets) hookManager.enableHook(target);
+        m_installed = true;
+        return true;
+    }
+
+    std::vector<void*> created;
+    auto removeCreated = [&]
+    {
+        for (void* target : created) hookManager.removeHook(target);
+    };
+
+    try
+    {
+        auto gameObjectClass = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("GameObject");
+        auto componentClass = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Component");
+        if (!gameObjectClass || !componentClass) return false;
+        m_gameObjectClass = gameObjectClass->address;
+        m_componentClass = componentClass->address;
+
+        // Every public Instantiate overload ends up in one of these
+        void* cloneSingle = resolveMethod("Object", "Internal_CloneSingle", {"UnityEngine.Object"});
+        void* cloneSingleWithParent = resolveMethod(
+            "Object", "Internal_CloneSingleWithParent",
+            {"UnityEngine.Object", "UnityEngine.Transform", "System.Boolean"});
+        void* instantiateSingle = resolveMethod(
+            "Object", "Internal_InstantiateSingle",
+            {"UnityEngine.Object", "UnityEngine.Vector3", "UnityEngine.Quaternion"});
+        void* instantiateSingleWithParent = resolveMethod("Object", "Internal_InstantiateSingleWithParent",
+                                                          {"UnityEngine.Object", "UnityEngine.Transform",
+                                                           "UnityEngine.Vector3", "UnityEngine.Quaternion"});
+        // Called by every GameObject constructor
+        void* createGameObject = resolveMethod("GameObject", "Internal_CreateGameObject",
+                                               {"UnityEngine.GameObject", "System.String"});
+        void* destroy = resolveMethod("Object", "Destroy", {"UnityEngine.Object", "System.Single"});
+        void* destroyImmediate = resolveMethod("Object", "DestroyImmediate",
+                                               {"UnityEngine.Object", "System.Boolean"});
+
+        if (!cloneSingle || !destroy || !destroyImmediate)
+        {
+            LOG_WARNING("[ObjectRegistry] Instantiate/Destroy not found, live tracking unavailable");
+            return false;
+        }
+
+        auto hook = [&](void* target, auto detour, auto* original)
+        {
+            if (!target || !hookManager.createHook(target, detour, original)) return false;
+            created.push_back(target);
+            return true;
+        };
+
+        // All three or none: a partial set would report live tracking while missing creations or destroys
+        if (!hook(cloneSingle, hookedCloneSingle, &m_originalCloneSingle) ||
+            !hook(destroy, hookedDestroy, &m_originalDestroy) ||
+            !hook(destroyImmediate, hookedDestroyImmediate, &m_originalDestroyImmediate))
+        {
+            LOG_ERROR("[ObjectRegistry] Failed to hook Instantiate/Destroy");
+            removeCreated();
+            return false;
+        }
+
+        // Optional funnels; older Unity versions route everything through Internal_CloneSingle
+        hook(cloneSingleWithParent, hookedCloneSingleWithParent, &m_originalCloneSingleWithParent);
+        hook(instantiateSingle, hookedInstantiateSingle, &m_originalInstantiateSingle);
+        hook(instantiateSingleWithParent, hookedInstantiateSingleWithParent, &m_originalInstantiateSingleWithParent);
+        hook(createGameObject, hookedCreateGameObject, &m_originalCreateGameObject);
+    }
+    catch (...)
+    {
+        LOG_ERROR("[ObjectRegistry] Exception while installing hooks");
+        removeCreated();
+        return false;
+    }
+
+    m_targets = std::move(created);
+
+    m_installed = true;
+    LOG_INFO("[ObjectRegistry] Installed %zu object lifetime hooks", m_targets.size());
+    return true;
+}
+
+void ObjectRegistry::uninstall()
+{
+    for (void* target : m_targets)
+    {
+        HookManager::getInstance().disableHook(target);
+    }
+    m_installed = false;
+
+    std::lock_guard lock(m_mutex);
+    m_journal.clear();
+    m_stats = {};
+}
+
+void ObjectRegistry::poll(std::vector<Change>& out)
+{
+    out.clear();
+    std::lock_guard lock(m_mutex);
+    out.swap(m_journal);
+}
+
+ObjectRegistry::Stats ObjectRegistry::getStats()
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+void ObjectRegistry::recordCreated(void* object)
+{
+    if (!object) return;
+
+    try
+    {
+        // Instantiate(component) returns the cloned component; the clone's GameObject is what was created
+        void* klass = methods::Runtime::GetObjectClass(object);
+        UnityResolve::UnityType::GameObject* go = nullptr;
+        if (klass == m_gameObjectClass)
+        {
+            go = static_cast<UnityResolve::UnityType::GameObject*>(object);
+        }
+        else if (methods::Runtime::IsSubclassOf(klass, m_componentClass))
+        {
+            go = static_cast<UnityResolve::UnityType::Component*>(object)->GetGameObject();
+        }
+        if (!go) return;
+
+        // Read the ID now: the object may already be gone by the time the journal is consumed
+        const int32_t instanceId = methods::Object::GetInstanceID(go);
+
+        std::lock_guard lock(m_mutex);
+        m_journal.push_back({ChangeType::Created, instanceId, go});
+        m_stats.created++;
+    }
+    catch (...)
+    {
+    }
+}
+
+void ObjectRegistry::recordDestroyed(void* object, float delay)
+{
+    // A delayed destroy happens after `delay` seconds of Time.time, which slows or stops with timeScale; the
+    // liveness sweep sees the object go when it does, so neither the journal nor the count has it
+    if (!object || delay > 0.0f) return;
+
+    try
+    {
+        void* klass = methods::Runtime::GetObjectClass(object);
+        if (klass != m_gameObjectClass)
+        {
+            // A destroyed component is journaled under its GameObject, so an inspector showing it refetches
+            if (!methods::Runtime::IsSubclassOf(klass, m_componentClass)) return;
+            auto go = static_cast<UnityResolve::UnityType::Component*>(object)->GetGameObject();
+            if (!go) return;
+
+            const int32_t instanceId = methods::Object::GetInstanceID(go);
+            std::lock_guard lock(m_mutex);
+            m_journal.push_back({ChangeType::ComponentDestroyed, instanceId, nullptr});
+            return;
+        }
+
+        const int32_t instanceId = methods::Object::GetInstanceID(static_cast<UnityResolve::UnityType::UnityObject*>(
+            object));
+
+        std::lock_guard lock(m_mutex);
+        m_journal.push_back({ChangeType::Destroyed, instanceId, nullptr});
+        m_stats.destroyed++;
+    }
+    catch (...)
+    {
+    }
+}
+
+void* ObjectRegistry::hookedCloneSingle(void* data, void* method)
+{
+    void* clone = m_originalCloneSingle(data, method);
+    getInstance().recordCreated(clone);
+    return clone;
+}
+
+void* ObjectRegistry::hookedCloneSingleWithParent(void* data, void* parent, bool worldPositionStays, void* method)
+{
+    void* clone = m_originalCloneSingleWithParent(data, parent, worldPositionStays, method);
+    getInstance().recordCreated(clone);
+    return clone;
+}
+
+void* ObjectRegistry::hookedInstantiateSingle(void* data, Vector3 position, Quaternion rotation, void* method)
+{
+    void* clone = m_originalInstantiateSingle(data, position, rotation, method);
+    getInstance().recordCreated(clone);
+    return clone;
+}
+
+void* ObjectRegistry::hookedInstantiateSingleWithParent(void* data, void* parent, Vector3 position,
+                                                        Quaternion rotation, void* method)
+{
+    void* clone = m_originalInstantiateSingleWithParent(data, parent, position, rotation, method);
+    getInstance().recordCreated(clone);
+    return clone;
+}
+
+void ObjectRegistry::hookedCreateGameObject(void* self, void* name, void* method)
+{
+    m_originalCreateGameObject(self, name, method);
+    getInstance().recordCreated(self);
+}
+
+void ObjectRegistry::hookedDestroy(void* object, float delay, void* method)
+{
+    // Record before calling through, while the object is certainly still alive
+    getInstance().recordDestroyed(object, delay);
+    m_originalDestroy(object, delay, method);
+}
+
+void ObjectRegistry::hookedDestroyImmediate(void* object, bool allowDestroyingAssets, void* method)
+{
+    getInstance().recordDestroyed(object, 0.0f);
+    m_originalDestroyImmediate(object, allowDestroyingAssets, method);
+}
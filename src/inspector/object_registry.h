@@ -0,0 +1,95 @@
+﻿#pragma once
+
+#include <mutex>
+#include <vector>
+
+// Hooks the funnels behind Object.Instantiate, the GameObject constructors, Object.Destroy and
+// Object.DestroyImmediate, and records every GameObject created or destroyed in a change journal, along with
+// components destroyed (under their GameObject).
+// The explorer seeds its arena with one scan and then keeps it live by applying the journal each frame,
+// so the cost per frame is proportional to the number of changes rather than the size of the scene.
+class ObjectRegistry
+{
+public:
+    enum class ChangeType
+    {
+        Created,
+        Destroyed,
+        ComponentDestroyed, // instanceId is the GameObject that loses the component
+    };
+
+    struct Change
+    {
+        ChangeType type;
+        int32_t instanceId;
+        UnityResolve::UnityType::GameObject* gameObject; // only valid for Created
+    };
+
+    struct Stats
+    {
+        size_t created = 0;
+        size_t destroyed = 0;
+    };
+
+    static ObjectRegistry& getInstance();
+
+    // Install the hooks. Returns false if the Instantiate/Destroy funnels could not be resolved or hooked.
+    bool install();
+    void uninstall();
+    bool isInstalled() const { return m_installed; }
+
+    // Move all recorded changes into `out` (which is cleared first). Destroy(obj, t) with a delay is not
+    // recorded: the delay runs in scaled game time, so the node is left to the liveness sweep, which removes it
+    // once the object is actually gone.
+    void poll(std::vector<Change>& out);
+
+    // Lifetime totals since install(), of the changes recorded in the journal
+    Stats getStats();
+
+private:
+    ObjectRegistry() = default;
+
+    ObjectRegistry(const ObjectRegistry&) = delete;
+    ObjectRegistry& operator=(const ObjectRegistry&) = delete;
+
+    std::mutex m_mutex;
+    std::vector<Change> m_journal;
+    Stats m_stats;
+    std::vector<void*> m_targets;
+    bool m_installed = false;
+
+    void* m_gameObjectClass = nullptr;
+    void* m_componentClass = nullptr;
+
+    void recordCreated(void* object);
+    void recordDestroyed(void* object, float delay);
+
+    using Vector3 = UnityResolve::UnityType::Vector3;
+    using Quaternion = UnityResolve::UnityType::Quaternion;
+
+    // Detours. The trailing pointer is the IL2CPP MethodInfo; Mono does not pass one and it is ignored.
+    static void* hookedCloneSingle(void* data, void* method);
+    static void* hookedCloneSingleWithParent(void* data, void* parent, bool worldPositionStays, void* method);
+    static void* hookedInstantiateSingle(void* data, Vector3 position, Quaternion rotation, void* method);
+    static void* hookedInstantiateSingleWithParent(void* data, void* parent, Vector3 position, Quaternion rotation,
+                                                   void* method);
+    static void hookedCreateGameObject(void* self, void* name, void* method);
+    static void hookedDestroy(void* object, float delay, void* method);
+    static void hookedDestroyImmediate(void* object, bool allowDestroyingAssets, void* method);
+
+    using CloneSingle_t = void* (*)(void*, void*);
+    using CloneSingleWithParent_t = void* (*)(void*, void*, bool, void*);
+    using InstantiateSingle_t = void* (*)(void*, Vector3, Quaternion, void*);
+    using InstantiateSingleWithParent_t = void* (*)(void*, void*, Vector3, Quaternion, void*);
+    using CreateGameObject_t = void (*)(void*, void*, void*);
+    using Destroy_t = void (*)(void*, float, void*);
+    using DestroyImmediate_t = void (*)(void*, bool, void*);
+
+    static CloneSingle_t m_originalCloneSingle;
+    static CloneSingleWithParent_t m_originalCloneSingleWithParent;
+    static InstantiateSingle_t m_originalInstantiateSingle;
+    static InstantiateSingleWithParent_t m_originalInstantiateSingleWithParent;
+    static CreateGameObject_t m_originalCreateGameObject;
+    static Destroy_t m_originalDestroy;
+    static DestroyImmediate_t m_originalDestroyImmediate;
+};
@@ -0,0 +1,76 @@
+﻿#include "pch.h"
+#include "property_sampler.h"
+
+namespace
+{
+    // Slots not drawn for this many batches are dropped
+    constexpr uint32_t kMaxIdleBatches = 20;
+    constexpr float kAverageWeight = 0.1f;
+}
+
+void PropertySampler::run(const char* panel, SlotBase& slot)
+{
+    const auto start = Clock::now();
+    try
+    {
+        slot.fetch();
+    }
+    catch (...)
+    {
+        // The previous values stay; the panel shows them until a fetch succeeds
+    }
+    const float us = std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+
+    PanelCost& cost = m_costs[panel];
+    cost.lastUs = us;
+    cost.averageUs = cost.fetches == 0 ? us : cost.averageUs + (us - cost.averageUs) * kAverageWeight;
+    cost.fetches++;
+}
+
+void PropertySampler::tick()
+{
+    const auto now = Clock::now();
+    if (m_rateHz > 0 && now - m_lastBatch < std::chrono::microseconds(1000000 / m_rateHz)) return;
+    m_lastBatch = now;
+
+    // One batch: every panel drawn since the previous one, costs summed per panel across objects
+    m_batchCosts.clear();
+    for (auto it = m_slots.begin(); it != m_slots.end();)
+    {
+        SlotBase& slot = *it->second;
+        if (!slot.used)
+        {
+            it = ++slot.idleBatches > kMaxIdleBatches ? m_slots.erase(it) : std::next(it);
+            continue;
+        }
+
+        const auto start = Clock::now();
+        try
+        {
+            slot.fetch();
+        }
+        catch (...)
+        {
+        }
+        m_batchCosts[it->first.panel] += std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+        slot.used = false;
+        slot.idleBatches = 0;
+        ++it;
+    }
+
+    for (const auto& [panel, us] : m_batchCosts)
+    {
+        PanelCost& cost = m_costs[panel];
+        cost.lastUs = us;
+        cost.averageUs = cost.fetches == 0 ? us : cost.averageUs + (us - cost.averageUs) * kAverageWeight;
+        cost.fetches++;
+    }
+    m_batchUs = std::chrono::duration<float, std::micro>(Clock::now() - now).count();
+}
+
+const PropertySampler::PanelCost& PropertySampler::getCost(const char* panel) const
+{
+    static const PanelCost none;
+    auto it = m_costs.find(panel);
+    return it != m_costs.end() ? it->second : none;
+}
@@ -0,0 +1,94 @@
+﻿#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+// Rate-controlled reads of managed properties for the inspector panels. A panel asks for its values with
+// sample(), naming itself, the object it shows and a fetch function that fills a plain struct. The first
+// request fetches right away; after that the struct is returned as is, and tick() refreshes every panel that
+// was drawn since the previous batch, all at once, at the configured rate. Panels that stop being drawn
+// (collapsed, another selection) stop being fetched and are dropped after a while. Fetch time is recorded
+// per panel so the cost of each open section can be shown next to it.
+class PropertySampler
+{
+public:
+    struct PanelCost
+    {
+        float lastUs = 0.0f;    // last batch, all objects of this panel
+        float averageUs = 0.0f; // moving average over batches
+        uint32_t fetches = 0;
+    };
+
+    // Values of `panel` for `target`, fetched now if new and otherwise as of the last batch. `panel` must be a
+    // string literal (it is keyed by address). Writes to the result (an edit shown before the next batch reads
+    // it back) last until that batch.
+    template <typename T, typename Fetch>
+    T& sample(const char* panel, const void* target, Fetch&& fetch)
+    {
+        auto& slot = m_slots[Key{panel, target}];
+        if (!slot)
+        {
+            auto typed = std::make_unique<Slot<T>>();
+            typed->fetcher = std::forward<Fetch>(fetch);
+            slot = std::move(typed);
+            run(panel, *slot);
+        }
+        slot->used = true;
+        return static_cast<Slot<T>*>(slot.get())->value;
+    }
+
+    // Refresh the panels drawn since the last batch, if the interval has passed. Call once per frame.
+    void tick();
+    // Fetch everything again on the next tick (e.g. a new scene)
+    void invalidate() { m_slots.clear(); }
+
+    void setRate(int hz) { m_rateHz = hz; }
+    int getRate() const { return m_rateHz; }
+    const PanelCost& getCost(const char* panel) const;
+    float getBatchUs() const { return m_batchUs; }
+
+private:
+    struct SlotBase
+    {
+        virtual ~SlotBase() = default;
+        virtual void fetch() = 0;
+        bool used = true; // drawn since the last batch
+        uint32_t idleBatches = 0;
+    };
+
+    template <typename T>
+    struct Slot : SlotBase
+    {
+        T value{};
+        std::function<void(T&)> fetcher;
+        void fetch() override { fetcher(value); }
+    };
+
+    struct Key
+    {
+        const char* panel;
+        const void* target;
+        bool operator==(const Key& other) const { return panel == other.panel && target == other.target; }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<const void*>()(key.panel) * 31 + std::hash<const void*>()(key.target);
+        }
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    std::unordered_map<Key, std::unique_ptr<SlotBase>, KeyHash> m_slots;
+    std::unordered_map<const char*, PanelCost> m_costs;
+    std::unordered_map<const char*, float> m_batchCosts; // scratch for one batch
+    int m_rateHz = 10; // 0 = every frame
+    Clock::time_point m_lastBatch;
+    float m_batchUs = 0.0f;
+
+    void run(const char* panel, SlotBase& slot);
+};
@@ -0,0 +1,416 @@
+﻿#include "pch.h"
+#include "scene_arena.h"
+#include "native_object.h"
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// FlatIndexMap
+// ---------------------------------------------------------------------------
+
+size_t FlatIndexMap::hash(uintptr_t key)
+{
+    // Pointers are 8/16-byte aligned and instance IDs are small, so mix the bits (splitmix64 finalizer)
+    uint64_t x = static_cast<uint64_t>(key);
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return static_cast<size_t>(x);
+}
+
+uint32_t FlatIndexMap::find(uintptr_t key) const
+{
+    if (m_slots.empty()) return kNotFound;
+
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = hash(key) & mask;; i = (i + 1) & mask)
+    {
+        const Slot& slot = m_slots[i];
+        if (slot.key == key) return slot.value;
+        if (slot.key == kEmpty) return kNotFound;
+    }
+}
+
+void FlatIndexMap::insert(uintptr_t key, uint32_t value)
+{
+    if ((m_used + 1) * 10 > m_slots.size() * 7)
+    {
+        rehash(m_slots.empty() ? 64 : (m_size * 2 > m_slots.size() / 2 ? m_slots.size() * 2 : m_slots.size()));
+    }
+
+    const size_t mask = m_slots.size() - 1;
+    size_t tombstone = SIZE_MAX;
+    for (size_t i = hash(key) & mask;; i = (i + 1) & mask)
+    {
+        Slot& slot = m_slots[i];
+        if (slot.key == key)
+        {
+            slot.value = value;
+            return;
+        }
+        if (slot.key == kTombstone && tombstone == SIZE_MAX)
+        {
+            tombstone = i;
+        }
+        else if (slot.key == kEmpty)
+        {
+            if (tombstone != SIZE_MAX)
+            {
+                m_slots[tombstone] = {key, value};
+            }
+            else
+            {
+                slot = {key, value};
+                m_used++;
+            }
+            m_size++;
+            return;
+        }
+    }
+}
+
+void FlatIndexMap::erase(uintptr_t key)
+{
+    if (m_slots.empty()) return;
+
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = hash(key) & mask;; i = (i + 1) & mask)
+    {
+        Slot& slot = m_slots[i];
+        if (slot.key == key)
+        {
+            slot.key = kTombstone;
+            m_size--;
+            return;
+        }
+        if (slot.key == kEmpty) return;
+    }
+}
+
+void FlatIndexMap::clear()
+{
+    std::fill(m_slots.begin(), m_slots.end(), Slot{kEmpty, 0});
+    m_size = 0;
+    m_used = 0;
+}
+
+void FlatIndexMap::reserve(size_t count)
+{
+    size_t capacity = 64;
+    while (capacity * 7 < count * 10) capacity *= 2;
+    if (capacity > m_slots.size()) rehash(capacity);
+}
+
+void FlatIndexMap::rehash(size_t capacity)
+{
+    std::vector<Slot> old;
+    old.swap(m_slots);
+    m_slots.assign(capacity, Slot{kEmpty, 0});
+    m_size = 0;
+    m_used = 0;
+
+    for (const Slot& slot : old)
+    {
+        if (slot.key != kEmpty && slot.key != kTombstone) insert(slot.key, slot.value);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// NameTable
+// ---------------------------------------------------------------------------
+
+size_t NameTable::hash(std::string_view name)
+{
+    // FNV-1a
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : name)
+    {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return static_cast<size_t>(h);
+}
+
+uint32_t NameTable::intern(std::string_view name)
+{
+    if ((m_offsets.size() + 1) * 10 > m_buckets.size() * 7)
+    {
+        rehash(m_buckets.empty() ? 256 : m_buckets.size() * 2);
+    }
+
+    const size_t mask = m_buckets.size() - 1;
+    size_t i = hash(name) & mask;
+    for (;; i = (i + 1) & mask)
+    {
+        uint32_t id = m_buckets[i];
+        if (id == kEmpty) break;
+        if (get(id) == name) return id;
+    }
+
+    auto id = static_cast<uint32_t>(m_offsets.size());
+    m_offsets.push_back(static_cast<uint32_t>(m_chars.size()));
+    m_lengths.push_back(static_cast<uint32_t>(name.size()));
+    m_chars.insert(m_chars.end(), name.begin(), name.end());
+    m_chars.push_back('\0');
+    m_buckets[i] = id;
+    return id;
+}
+
+std::string_view NameTable::get(uint32_t id) const
+{
+    if (id >= m_offsets.size()) return {};
+    return std::string_view(m_chars.data() + m_offsets[id], m_lengths[id]);
+}
+
+size_t NameTable::memoryUsage() const
+{
+    return m_chars.capacity() + (m_offsets.capacity() + m_lengths.capacity() + m_buckets.capacity()) * sizeof(uint32_t);
+}
+
+void NameTable::clear()
+{
+    m_chars.clear();
+    m_offsets.clear();
+    m_lengths.clear();
+    std::fill(m_buckets.begin(), m_buckets.end(), kEmpty);
+    m_generation++;
+}
+
+void NameTable::rehash(size_t capacity)
+{
+    m_buckets.assign(capacity, kEmpty);
+    const size_t mask = capacity - 1;
+    for (uint32_t id = 0; id < m_offsets.size(); id++)
+    {
+        size_t i = hash(get(id)) & mask;
+        while (m_buckets[i] != kEmpty) i = (i + 1) & mask;
+        m_buckets[i] = id;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SceneArena
+// ---------------------------------------------------------------------------
+
+uint32_t SceneArena::create(int32_t instanceId, UnityResolve::UnityType::GameObject* gameObject,
+                            UnityResolve::UnityType::Transform* transform, std::string_view name)
+{
+    return create(instanceId, gameObject, transform, m_names.intern(name));
+}
+
+uint32_t SceneArena::create(int32_t instanceId, UnityResolve::UnityType::GameObject* gameObject,
+                            UnityResolve::UnityType::Transform* transform, uint32_t nameId)
+{
+    uint32_t index;
+    if (m_freeList != kInvalid)
+    {
+        index = m_freeList;
+        m_freeList = m_nodes[index].nextSibling;
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+        if (m_generations.size() < m_nodes.size()) m_generations.push_back(0);
+    }
+
+    SceneNode& node = m_nodes[index];
+    node = SceneNode{};
+    node.gameObject = gameObject;
+    node.transform = transform;
+    node.native = NativeObjectLayout::getCachedPtr(gameObject);
+    node.instanceId = instanceId;
+    node.nameId = nameId;
+    node.flags = SceneNode::Alive;
+
+    m_byInstanceId.insert(static_cast<uint32_t>(instanceId), index);
+    if (transform) m_byTransform.insert(reinterpret_cast<uintptr_t>(transform), index);
+    m_liveCount++;
+    return index;
+}
+
+void SceneArena::destroy(uint32_t index)
+{
+    SceneNode& node = m_nodes[index];
+    if (!node.isAlive()) return;
+
+    unlink(index);
+
+    // Orphan any children that are still linked; the caller either destroys or relinks them
+    for (uint32_t child = node.firstChild; child != kInvalid;)
+    {
+        SceneNode& childNode = m_nodes[child];
+        uint32_t next = childNode.nextSibling;
+        childNode.parent = kInvalid;
+        childNode.nextSibling = kInvalid;
+        childNode.prevSibling = kInvalid;
+        childNode.setFlag(SceneNode::Linked, false);
+        child = next;
+    }
+
+    m_byInstanceId.erase(static_cast<uint32_t>(node.instanceId));
+    if (node.transform) m_byTransform.erase(reinterpret_cast<uintptr_t>(node.transform));
+
+    node = SceneNode{};
+    node.nextSibling = m_freeList;
+    m_freeList = index;
+    m_generations[index]++;
+    m_liveCount--;
+    m_revision++;
+}
+
+size_t SceneArena::destroySubtree(uint32_t index)
+{
+    // destroy() unlinks the child, so firstChild advances every iteration
+    size_t removed = 0;
+    while (m_nodes[index].firstChild != kInvalid)
+    {
+        removed += destroySubtree(m_nodes[index].firstChild);
+    }
+    destroy(index);
+    return removed + 1;
+}
+
+size_t SceneArena::destroyScene(int32_t scene)
+{
+    size_t removed = 0;
+    for (uint32_t index = 0; index < m_nodes.size(); index++)
+    {
+        const SceneNode& node = m_nodes[index];
+        if (!node.isAlive() || node.scene != scene) continue;
+
+        destroy(index);
+        removed++;
+    }
+    return removed;
+}
+
+void SceneArena::clear()
+{
+    // Generations survive a clear so that references taken before it stay invalid
+    for (uint32_t& generation : m_generations) generation++;
+    m_nodes.clear();
+    m_freeList = kInvalid;
+    m_firstRoot = kInvalid;
+    m_liveCount = 0;
+    m_rootCount = 0;
+    m_revision++;
+    m_names.clear();
+    m_byInstanceId.clear();
+    m_byTransform.clear();
+}
+
+void SceneArena::reserve(size_t count)
+{
+    m_nodes.reserve(count);
+    m_generations.reserve(count);
+    m_byInstanceId.reserve(count);
+    m_byTransform.reserve(count);
+}
+
+void SceneArena::link(uint32_t index, uint32_t parent)
+{
+    SceneNode& node = m_nodes[index];
+    if (node.isLinked()) unlink(index);
+
+    uint32_t& head = parent != kInvalid ? m_nodes[parent].firstChild : m_firstRoot;
+    node.parent = parent;
+    node.prevSibling = kInvalid;
+    node.nextSibling = head;
+    if (head != kInvalid) m_nodes[head].prevSibling = index;
+    head = index;
+
+    node.depth = parent != kInvalid ? static_cast<uint16_t>(m_nodes[parent].depth + 1) : 0;
+    node.setFlag(SceneNode::Linked, true);
+    if (parent == kInvalid) m_rootCount++;
+    m_revision++;
+}
+
+void SceneArena::unlink(uint32_t index)
+{
+    SceneNode& node = m_nodes[index];
+    if (!node.isLinked()) return;
+
+    if (node.prevSibling != kInvalid)
+    {
+        m_nodes[node.prevSibling].nextSibling = node.nextSibling;
+    }
+    else if (node.parent != kInvalid)
+    {
+        m_nodes[node.parent].firstChild = node.nextSibling;
+    }
+    else
+    {
+        m_firstRoot = node.nextSibling;
+    }
+
+    if (node.nextSibling != kInvalid) m_nodes[node.nextSibling].prevSibling = node.prevSibling;
+    if (node.parent == kInvalid) m_rootCount--;
+
+    node.parent = kInvalid;
+    node.nextSibling = kInvalid;
+    node.prevSibling = kInvalid;
+    node.setFlag(SceneNode::Linked, false);
+    m_revision++;
+}
+
+void SceneArena::updateDepth(uint32_t index, uint16_t depth)
+{
+    m_nodes[index].depth = depth;
+    for (uint32_t child = m_nodes[index].firstChild; child != kInvalid; child = m_nodes[child].nextSibling)
+    {
+        updateDepth(child, static_cast<uint16_t>(depth + 1));
+    }
+}
+
+void SceneArena::sortRoots()
+{
+    m_sortScratch.clear();
+    for (uint32_t root = m_firstRoot; root != kInvalid; root = m_nodes[root].nextSibling)
+    {
+        m_sortScratch.push_back(root);
+    }
+
+    std::sort(m_sortScratch.begin(), m_sortScratch.end(),
+              [this](uint32_t a, uint32_t b) { return nameOf(a) < nameOf(b); });
+
+    uint32_t prev = kInvalid;
+    for (uint32_t index : m_sortScratch)
+    {
+        m_nodes[index].prevSibling = prev;
+        m_nodes[index].nextSibling = kInvalid;
+        if (prev != kInvalid) m_nodes[prev].nextSibling = index;
+        prev = index;
+    }
+    m_firstRoot = m_sortScratch.empty() ? kInvalid : m_sortScratch.front();
+    m_revision++;
+}
+
+bool SceneArena::isLive(uint32_t index) const
+{
+    const SceneNode& node = m_nodes[index];
+    if (!node.isAlive()) return false;
+    if (!node.native) return true; // m_CachedPtr unavailable, nothing to compare against
+
+    return NativeObjectLayout::getCachedPtr(node.gameObject) == node.native;
+}
+
+uint32_t SceneArena::findByInstanceId(int32_t instanceId) const
+{
+    return m_byInstanceId.find(static_cast<uint32_t>(instanceId));
+}
+
+uint32_t SceneArena::findByTransform(UnityResolve::UnityType::Transform* transform) const
+{
+    if (!transform) return kInvalid;
+    return m_byTransform.find(reinterpret_cast<uintptr_t>(transform));
+}
+
+size_t SceneArena::memoryUsage() const
+{
+    return m_nodes.capacity() * sizeof(SceneNode) + m_generations.capacity() * sizeof(uint32_t) +
+        m_names.memoryUsage() + m_byInstanceId.memoryUsage() + m_byTransform.memoryUsage() +
+        m_sortScratch.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,177 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Open-addressing hash from a pointer-sized key to a node index (linear probing, tombstone deletes)
+class FlatIndexMap
+{
+public:
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    uint32_t find(uintptr_t key) const;
+    void insert(uintptr_t key, uint32_t value);
+    void erase(uintptr_t key);
+    void clear();
+    void reserve(size_t count);
+
+    size_t size() const { return m_size; }
+    size_t memoryUsage() const { return m_slots.capacity() * sizeof(Slot); }
+
+private:
+    struct Slot
+    {
+        uintptr_t key;
+        uint32_t value;
+    };
+
+    static constexpr uintptr_t kEmpty = UINTPTR_MAX;
+    static constexpr uintptr_t kTombstone = UINTPTR_MAX - 1;
+
+    std::vector<Slot> m_slots;
+    size_t m_size = 0;
+    size_t m_used = 0; // live entries + tombstones
+
+    static size_t hash(uintptr_t key);
+    void rehash(size_t capacity);
+};
+
+// Interned, immutable name storage. Each distinct string is stored once in a shared character buffer.
+class NameTable
+{
+public:
+    uint32_t intern(std::string_view name);
+    std::string_view get(uint32_t id) const;
+    const char* c_str(uint32_t id) const { return m_chars.data() + m_offsets[id]; }
+
+    size_t size() const { return m_offsets.size(); }
+    size_t memoryUsage() const;
+    void clear();
+
+    // Names are only appended between clears; bumped by clear() so indexes over the ids know to start over
+    uint32_t generation() const { return m_generation; }
+
+private:
+    std::vector<char> m_chars; // null-terminated names, back to back
+    std::vector<uint32_t> m_offsets;
+    std::vector<uint32_t> m_lengths;
+    std::vector<uint32_t> m_buckets; // open-addressing id table, kEmpty when free
+    uint32_t m_generation = 0;
+
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+
+    static size_t hash(std::string_view name);
+    void rehash(size_t capacity);
+};
+
+// Flat, index-linked storage for the scene hierarchy
+struct SceneNode
+{
+    enum Flags : uint8_t
+    {
+        Alive = 1 << 0,
+        Active = 1 << 1,
+        Linked = 1 << 2,
+        ChildrenLoaded = 1 << 3, // direct children are present in the arena
+    };
+
+    UnityResolve::UnityType::GameObject* gameObject = nullptr;
+    UnityResolve::UnityType::Transform* transform = nullptr;
+    UnityResolve::UnityType::Transform* parentTransform = nullptr;
+    void* native = nullptr; // m_CachedPtr when the node was created; the wrapper must still point here
+    int32_t instanceId = 0;
+    int32_t scene = 0; // Scene handle the object belongs to; 0 when unknown (full scans)
+    uint32_t parent = UINT32_MAX;
+    uint32_t firstChild = UINT32_MAX;
+    uint32_t nextSibling = UINT32_MAX;
+    uint32_t prevSibling = UINT32_MAX;
+    uint32_t nameId = 0;
+    uint32_t lastSeen = 0;
+    uint32_t childCount = 0; // Transform.childCount as of the last lazy scan
+    uint16_t depth = 0;
+    uint8_t flags = 0;
+
+    bool isAlive() const { return flags & Alive; }
+    bool isActive() const { return flags & Active; }
+    bool isLinked() const { return flags & Linked; }
+    bool hasChildren() const { return firstChild != UINT32_MAX; }
+    bool mayHaveChildren() const { return hasChildren() || childCount > 0; }
+
+    void setFlag(Flags flag, bool value) { flags = value ? (flags | flag) : (flags & ~flag); }
+};
+
+// Index plus slot generation. Stays safe to hold across frames: once the node is destroyed and its slot
+// reused, the generation no longer matches and the reference resolves to kInvalid.
+struct NodeRef
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+class SceneArena
+{
+public:
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+
+    // Allocate a node slot and register it under its instance ID and transform
+    uint32_t create(int32_t instanceId, UnityResolve::UnityType::GameObject* gameObject,
+                    UnityResolve::UnityType::Transform* transform, std::string_view name);
+    uint32_t create(int32_t instanceId, UnityResolve::UnityType::GameObject* gameObject,
+                    UnityResolve::UnityType::Transform* transform, uint32_t nameId);
+    void destroy(uint32_t index);
+    size_t destroySubtree(uint32_t index);
+    size_t destroyScene(int32_t scene);
+    void clear();
+    void reserve(size_t count);
+
+    // Sibling-list maintenance. A parent of kInvalid links the node into the root list.
+    void link(uint32_t index, uint32_t parent);
+    void unlink(uint32_t index);
+    void updateDepth(uint32_t index, uint16_t depth);
+    void sortRoots();
+
+    NodeRef ref(uint32_t index) const { return {index, m_generations[index]}; }
+    uint32_t resolve(NodeRef ref) const
+    {
+        return ref.index < m_nodes.size() && m_generations[ref.index] == ref.generation ? ref.index : kInvalid;
+    }
+
+    // Whether the managed wrapper still points at the native object it had when the node was created.
+    // Unity clears m_CachedPtr on destroy, and a wrapper reused for another object points elsewhere.
+    bool isLive(uint32_t index) const;
+
+    uint32_t findByInstanceId(int32_t instanceId) const;
+    uint32_t findByTransform(UnityResolve::UnityType::Transform* transform) const;
+
+    SceneNode& operator[](uint32_t index) { return m_nodes[index]; }
+    const SceneNode& operator[](uint32_t index) const { return m_nodes[index]; }
+
+    uint32_t firstRoot() const { return m_firstRoot; }
+    size_t capacity() const { return m_nodes.size(); }
+    size_t liveCount() const { return m_liveCount; }
+    size_t rootCount() const { return m_rootCount; }
+
+    // Bumped by every change to the tree structure, so views built from it know when to rebuild
+    uint64_t revision() const { return m_revision; }
+
+    NameTable& names() { return m_names; }
+    const NameTable& names() const { return m_names; }
+    std::string_view nameOf(uint32_t index) const { return m_names.get(m_nodes[index].nameId); }
+
+    size_t memoryUsage() const;
+
+private:
+    std::vector<SceneNode> m_nodes;
+    std::vector<uint32_t> m_generations; // per slot, bumped on destroy
+    uint32_t m_freeList = kInvalid; // threaded through nextSibling
+    uint32_t m_firstRoot = kInvalid;
+    size_t m_liveCount = 0;
+    size_t m_rootCount = 0;
+    uint64_t m_revision = 0;
+
+    NameTable m_names;
+    FlatIndexMap m_byInstanceId;
+    FlatIndexMap m_byTransform;
+    std::vector<uint32_t> m_sortScratch;
+};
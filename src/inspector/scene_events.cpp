@@ -0,0 +1,131 @@
+﻿#include "pch.h"
+#include "scene_events.h"
+#include "memory/hook_manager.h"
+
+SceneEvents::SceneLoaded_t SceneEvents::m_originalSceneLoaded = nullptr;
+SceneEvents::SceneUnloaded_t SceneEvents::m_originalSceneUnloaded = nullptr;
+SceneEvents::ActiveSceneChanged_t SceneEvents::m_originalActiveSceneChanged = nullptr;
+
+namespace
+{
+    void* resolveCallback(const char* name)
+    {
+        auto sceneManager = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("SceneManager");
+        if (!sceneManager) return nullptr;
+
+        auto method = sceneManager->Get<UnityResolve::Method>(name);
+        return method ? method->function : nullptr;
+    }
+}
+
+SceneEvents& SceneEvents::getInstance()
+{
+    static SceneEvents instance;
+    return instance;
+}
+
+bool SceneEvents::install()
+{
+    if (m_installed) return true;
+
+    auto& hookManager = HookManager::getInstance();
+    if (!hookManager.initialize()) return false;
+
+    // Hooks created by an earlier install() are only disabled on uninstall
+    if (!m_targets.empty())
+    {
+        for (void* target : m_targets) hookManager.enableHook(target);
+        m_installed = true;
+        return true;
+    }
+
+    std::vector<void*> created;
+    auto removeCreated = [&]
+    {
+        for (void* target : created) hookManager.removeHook(target);
+    };
+
+    try
+    {
+        void* sceneLoaded = resolveCallback("Internal_SceneLoaded");
+        void* sceneUnloaded = resolveCallback("Internal_SceneUnloaded");
+        void* activeSceneChanged = resolveCallback("Internal_ActiveSceneChanged");
+        if (!sceneLoaded || !sceneUnloaded || !activeSceneChanged)
+        {
+            LOG_WARNING("[SceneEvents] SceneManager callbacks not found, falling back to polling");
+            return false;
+        }
+
+        auto hook = [&](void* target, auto detour, auto* original)
+        {
+            if (!hookManager.createHook(target, detour, original)) return false;
+            created.push_back(target);
+            return true;
+        };
+
+        // Hooks created before a failure are removed, not just disabled, so a later install() can create them
+        if (!hook(sceneLoaded, hookedSceneLoaded, &m_originalSceneLoaded) ||
+            !hook(sceneUnloaded, hookedSceneUnloaded, &m_originalSceneUnloaded) ||
+            !hook(activeSceneChanged, hookedActiveSceneChanged, &m_originalActiveSceneChanged))
+        {
+            LOG_ERROR("[SceneEvents] Failed to hook SceneManager callbacks");
+            removeCreated();
+            return false;
+        }
+    }
+    catch (...)
+    {
+        LOG_ERROR("[SceneEvents] Exception while installing hooks");
+        removeCreated();
+        return false;
+    }
+
+    m_targets = std::move(created);
+
+    m_installed = true;
+    LOG_INFO("[SceneEvents] Scene load/unload hooks installed");
+    return true;
+}
+
+void SceneEvents::uninstall()
+{
+    for (void* target : m_targets)
+    {
+        HookManager::getInstance().disableHook(target);
+    }
+    m_installed = false;
+
+    std::lock_guard lock(m_mutex);
+    m_queue.clear();
+}
+
+void SceneEvents::poll(std::vector<Event>& out)
+{
+    out.clear();
+    std::lock_guard lock(m_mutex);
+    out.swap(m_queue);
+}
+
+void SceneEvents::push(Type type, int scene)
+{
+    std::lock_guard lock(m_mutex);
+    m_queue.push_back({type, scene});
+}
+
+void SceneEvents::hookedSceneLoaded(int scene, int mode, void* method)
+{
+    m_originalSceneLoaded(scene, mode, method);
+    getInstance().push(Type::Loaded, scene);
+}
+
+void SceneEvents::hookedSceneUnloaded(int scene, void* method)
+{
+    m_originalSceneUnloaded(scene, method);
+    getInstance().push(Type::Unloaded, scene);
+}
+
+void SceneEvents::hookedActiveSceneChanged(int previous, int next, void* method)
+{
+    m_originalActiveSceneChanged(previous, next, method);
+    getInstance().push(Type::ActiveChanged, next);
+}
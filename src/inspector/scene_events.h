@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include <mutex>
+#include <vector>
+
+// Hooks the internal SceneManager callbacks that raise sceneLoaded, sceneUnloaded and activeSceneChanged.
+// Events are queued from the game thread and drained by the explorer on the UI side.
+class SceneEvents
+{
+public:
+    enum class Type
+    {
+        Loaded,
+        Unloaded,
+        ActiveChanged,
+    };
+
+    struct Event
+    {
+        Type type;
+        int scene; // Scene handle; for ActiveChanged the newly active scene
+    };
+
+    static SceneEvents& getInstance();
+
+    // Install the hooks. Returns false if any callback could not be resolved or hooked.
+    bool install();
+    void uninstall();
+    bool isInstalled() const { return m_installed; }
+
+    // Move all queued events into `out` (which is cleared first)
+    void poll(std::vector<Event>& out);
+
+private:
+    SceneEvents() = default;
+
+    SceneEvents(const SceneEvents&) = delete;
+    SceneEvents& operator=(const SceneEvents&) = delete;
+
+    std::mutex m_mutex;
+    std::vector<Event> m_queue;
+    std::vector<void*> m_targets;
+    bool m_installed = false;
+
+    void push(Type type, int scene);
+
+    // Detours. The trailing pointer is the IL2CPP MethodInfo; Mono does not pass one and it is ignored.
+    static void hookedSceneLoaded(int scene, int mode, void* method);
+    static void hookedSceneUnloaded(int scene, void* method);
+    static void hookedActiveSceneChanged(int previous, int next, void* method);
+
+    using SceneLoaded_t = void (*)(int, int, void*);
+    using SceneUnloaded_t = void (*)(int, void*);
+    using ActiveSceneChanged_t = void (*)(int, int, void*);
+
+    static SceneLoaded_t m_originalSceneLoaded;
+    static SceneUnloaded_t m_originalSceneUnloaded;
+    static ActiveSceneChanged_t m_originalActiveSceneChanged;
+};
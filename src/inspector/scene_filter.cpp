@@ -0,0 +1,171 @@
+﻿#include "pch.h"
+#include "scene_filter.h"
+#include "scene_arena.h"
+
+#include <algorithm>
+#include <chrono>
+
+void SceneFilter::prepare(const SceneArena& arena)
+{
+    m_index.update(arena.names());
+    m_groups.build(arena);
+}
+
+bool SceneFilter::update(const SceneArena& arena, std::string_view text)
+{
+    const bool arenaChanged = m_dirty || m_revision != arena.revision();
+    if (!arenaChanged && text == m_source) return false;
+    // A running query finishes first; the arena change is picked up by the next call after it
+    if (m_running && text == m_source) return false;
+    m_running = false;
+
+    std::string lower(text);
+    for (char& c : lower) c = toLowerAscii(c);
+
+    // Anything that contains the new text also contains the old one, so the new matches are a subset
+    const bool structured = SceneQuery::isStructured(text);
+    const bool narrowing = !arenaChanged && !structured && !m_structured && !m_text.empty() &&
+        lower.find(m_text) != std::string::npos;
+    if (structured && (text != m_source || !m_structured)) m_query.compile(text);
+
+    m_structured = structured;
+    m_source = text;
+    m_text = std::move(lower);
+    m_dirty = false;
+    m_revision = arena.revision();
+    m_index.update(arena.names()); // only names added since the last change
+
+    if (m_text.empty())
+    {
+        m_matchNames.clear();
+        m_matchList.clear();
+        m_matches.clear();
+        m_ancestors.clear();
+        return true;
+    }
+
+    if (structured)
+    {
+        startQuery(arena);
+        return false;
+    }
+    if (narrowing) narrow(arena);
+    else search(arena);
+    markAncestors(arena);
+    return true;
+}
+
+bool SceneFilter::step(const SceneArena& arena, uint32_t budgetUs)
+{
+    if (!m_running) return false;
+
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = budgetUs > 0 ? Clock::now() + std::chrono::microseconds(budgetUs) : Clock::time_point::max();
+    if (!m_query.step(arena, m_columns, m_candidates, deadline)) return false;
+    m_running = false;
+
+    // Nodes unlinked while the query ran are dropped; the arena change behind it starts the next run
+    m_matchNames.clear();
+    m_nameMatches.clear();
+    m_matches.assign((arena.capacity() + 63) / 64, 0);
+    m_matchList.clear();
+    for (uint32_t index : m_candidates)
+    {
+        if (index >= arena.capacity() || !arena[index].isLinked()) continue;
+        set(m_matches, index);
+        m_matchList.push_back(index);
+    }
+    markAncestors(arena);
+    return true;
+}
+
+void SceneFilter::search(const SceneArena& arena)
+{
+    m_searches++;
+
+    const NameTable& names = arena.names();
+    m_matchNames.clear();
+    m_index.find(names, m_text, m_matchNames);
+    m_nameMatches.assign((names.size() + 63) / 64, 0);
+    for (uint32_t id : m_matchNames) set(m_nameMatches, id);
+
+    m_groups.build(arena);
+    m_matches.assign((arena.capacity() + 63) / 64, 0);
+    m_matchList.clear();
+    for (uint32_t id : m_matchNames)
+    {
+        for (const uint32_t* node = m_groups.begin(id); node != m_groups.end(id); node++)
+        {
+            set(m_matches, *node);
+            m_matchList.push_back(*node);
+        }
+    }
+}
+
+void SceneFilter::startQuery(const SceneArena& arena)
+{
+    m_searches++;
+    m_candidates.clear();
+    m_query.begin();
+    m_running = true;
+    if (m_query.terms().empty()) return; // failed to compile: finishes with no matches
+
+    // Seed from the name index when a name must be present, otherwise start from every linked node
+    auto seed = std::find_if(m_query.terms().begin(), m_query.terms().end(), [](const SceneQuery::Term& term)
+    {
+        return term.field == SceneQuery::Field::Name && !term.negate;
+    });
+    if (seed != m_query.terms().end())
+    {
+        std::vector<uint32_t> names;
+        m_groups.build(arena);
+        m_index.find(arena.names(), seed->text, names);
+        for (uint32_t id : names)
+        {
+            m_candidates.insert(m_candidates.end(), m_groups.begin(id), m_groups.end(id));
+        }
+    }
+    else
+    {
+        for (uint32_t index = 0; index < arena.capacity(); index++)
+        {
+            if (arena[index].isLinked()) m_candidates.push_back(index);
+        }
+    }
+}
+
+void SceneFilter::narrow(const SceneArena& arena)
+{
+    m_narrowings++;
+
+    const NameTable& names = arena.names();
+    size_t kept = 0;
+    for (uint32_t id : m_matchNames)
+    {
+        if (containsLowercase(names.get(id), m_text)) m_matchNames[kept++] = id;
+        else m_nameMatches[id >> 6] &= ~(1ULL << (id & 63));
+    }
+    m_matchNames.resize(kept);
+
+    kept = 0;
+    for (uint32_t index : m_matchList)
+    {
+        if (test(m_nameMatches, arena[index].nameId)) m_matchList[kept++] = index;
+        else m_matches[index >> 6] &= ~(1ULL << (index & 63));
+    }
+    m_matchList.resize(kept);
+}
+
+void SceneFilter::markAncestors(const SceneArena& arena)
+{
+    // Each climb stops at the first ancestor already marked, so every node is marked at most once
+    m_ancestors.assign((arena.capacity() + 63) / 64, 0);
+    for (uint32_t index : m_matchList)
+    {
+        for (uint32_t parent = arena[index].parent; parent != SceneArena::kInvalid; parent = arena[parent].parent)
+        {
+            if (test(m_ancestors, parent)) break;
+            set(m_ancestors, parent);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+﻿#pragma once
+
+#include "name_index.h"
+#include "scene_query.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+class SceneArena;
+
+// The hierarchy search evaluated into bitsets over arena slots: the nodes whose name contains the filter
+// (case-insensitive) and the ancestors of those nodes, so a match stays reachable under parents that do not
+// match themselves. Matching names come from a trigram index over the interned names, and the nodes carrying
+// them from a grouping of nodes by name, so a search costs in proportion to its matches, not the scene. The
+// sets are recomputed only when the filter text or the arena changes; a filter that contains the previous one
+// only re-tests the previous matches. Text using query fields (see SceneQuery) is compiled once per change and
+// run over the same candidates; since its property reads are managed calls, that run is resumable like the
+// hierarchy scan: step() advances it within a time budget and the previous sets stay until it finishes. A run
+// completes against the arena it started on, and a change made meanwhile starts the next one. Children that
+// are not loaded yet (lazy hierarchy) are not searched.
+class SceneFilter
+{
+public:
+    // Bring the name index and the grouping of nodes by name up to date ahead of a search. Only names added
+    // since the last call are indexed; the grouping is rebuilt once per arena change, by the first search
+    // after it when not prepared.
+    void prepare(const SceneArena& arena);
+
+    // Re-evaluate if the text or the arena changed. Returns true when the sets changed; a query only starts
+    // here and changes them from step().
+    bool update(const SceneArena& arena, std::string_view text);
+    // Advance a running query for at most budgetUs (0 = until done). Returns true when it finished and its
+    // results replaced the sets.
+    bool step(const SceneArena& arena, uint32_t budgetUs);
+    bool isRunning() const { return m_running; }
+    // Names may have changed without a structural change (refresh). Queried properties are kept per object.
+    void invalidate()
+    {
+        m_dirty = true;
+        m_groups.invalidate();
+    }
+
+    bool isActive() const { return !m_text.empty(); }
+    bool matches(uint32_t index) const { return test(m_matches, index); }
+    bool hasMatchBelow(uint32_t index) const { return test(m_ancestors, index); }
+    bool isVisible(uint32_t index) const { return matches(index) || hasMatchBelow(index); }
+
+    size_t matchCount() const { return m_matchList.size(); }
+    bool isQuery() const { return m_structured; }
+    const std::string& getQueryError() const { return m_query.getError(); }
+    const NameTrigramIndex& index() const { return m_index; }
+    uint32_t getSearches() const { return m_searches; }
+    uint32_t getNarrowings() const { return m_narrowings; }
+
+private:
+    std::string m_source;
+    std::string m_text; // lowercase
+    std::vector<uint64_t> m_nameMatches; // per interned name id
+    std::vector<uint64_t> m_matches;     // per arena slot
+    std::vector<uint64_t> m_ancestors;   // per arena slot: a strict descendant matches
+    std::vector<uint32_t> m_matchNames;  // name ids set in m_nameMatches
+    std::vector<uint32_t> m_matchList;   // arena slots set in m_matches
+    uint64_t m_revision = UINT64_MAX;
+    bool m_dirty = true;
+    uint32_t m_searches = 0;
+
+    NameTrigramIndex m_index;
+    NameGroups m_groups;
+
+    SceneQuery m_query;
+    SceneColumns m_columns;
+    std::vector<uint32_t> m_candidates; // of the running query, filtered in place
+    bool m_running = false;
+    bool m_structured = false;
+    uint32_t m_narrowings = 0;
+
+    static bool test(const std::vector<uint64_t>& bits, uint32_t index)
+    {
+        const size_t word = index >> 6;
+        return word < bits.size() && (bits[word] >> (index & 63) & 1);
+    }
+
+    static void set(std::vector<uint64_t>& bits, uint32_t index) { bits[index >> 6] |= 1ULL << (index & 63); }
+
+    void search(const SceneArena& arena);
+    void startQuery(const SceneArena& arena);
+    void narrow(const SceneArena& arena);
+    void markAncestors(const SceneArena& arena);
+};
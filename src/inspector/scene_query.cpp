@@ -0,0 +1,475 @@
+﻿#include "pch.h"
+#include "scene_query.h"
+#include "name_index.h"
+#include "scene_arena.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Candidates tested between deadline checks; a tag or component test costs a managed call
+    constexpr size_t kCheckInterval = 16;
+
+    // The shared component type array is compacted once this much of it belongs to reused slots
+    constexpr size_t kCompactThreshold = 4096;
+
+    std::string toLowerString(std::string_view text)
+    {
+        std::string lower(text);
+        for (char& c : lower) c = toLowerAscii(c);
+        return lower;
+    }
+
+    bool parseInteger(std::string_view text, int base, int64_t& out)
+    {
+        if (text.empty()) return false;
+        const std::string value(text);
+        char* end = nullptr;
+        if (base == 10) out = strtoll(value.c_str(), &end, base);
+        else out = static_cast<int64_t>(strtoull(value.c_str(), &end, base));
+        return *end == '\0';
+    }
+
+    bool parseAddress(std::string_view text, int64_t& out)
+    {
+        if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) text.remove_prefix(2);
+        return parseInteger(text, 16, out);
+    }
+
+    // LayerMask.LayerToName for all 32 layers, read once
+    int findLayer(const std::string& lowerName)
+    {
+        static std::vector<std::string> names;
+        if (names.empty())
+        {
+            names.resize(32);
+            for (int layer = 0; layer < 32; layer++)
+            {
+                try
+                {
+                    if (auto name = methods::LayerMask::LayerToName(layer))
+                        names[layer] = toLowerString(name->ToString());
+                }
+                catch (...)
+                {
+                }
+            }
+        }
+
+        for (int layer = 0; layer < 32; layer++)
+        {
+            if (!names[layer].empty() && names[layer] == lowerName) return layer;
+        }
+        return -1;
+    }
+
+    bool isField(const std::string& key)
+    {
+        static const char* const fields[] = {"name", "component", "tag", "layer", "active", "id", "addr"};
+        return std::find(std::begin(fields), std::end(fields), key) != std::end(fields);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SceneColumns
+// ---------------------------------------------------------------------------
+
+bool SceneColumns::has(const SceneArena& arena, uint32_t index, Column column)
+{
+    if (m_generations.size() < arena.capacity())
+    {
+        const size_t capacity = arena.capacity();
+        m_generations.resize(capacity, UINT32_MAX);
+        m_collected.resize(capacity, 0);
+        m_layers.resize(capacity, 0);
+        m_tags.resize(capacity, 0);
+        m_componentOffsets.resize(capacity, 0);
+        m_componentCounts.resize(capacity, 0);
+    }
+
+    // The slot may hold another object than the one the values were read from
+    const uint32_t generation = arena.ref(index).generation;
+    if (m_generations[index] != generation)
+    {
+        if (m_collected[index] & Components) m_componentGarbage += m_componentCounts[index];
+        m_generations[index] = generation;
+        m_collected[index] = 0;
+    }
+    if (m_collected[index] & column) return true;
+
+    m_collected[index] |= column;
+    return false;
+}
+
+int SceneColumns::layer(const SceneArena& arena, uint32_t index)
+{
+    if (!has(arena, index, Layer))
+    {
+        m_layers[index] = 0;
+        if (arena.isLive(index))
+        {
+            try
+            {
+                m_layers[index] = static_cast<uint8_t>(methods::GameObject::GetLayer(arena[index].gameObject));
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+    return m_layers[index];
+}
+
+uint16_t SceneColumns::tag(const SceneArena& arena, uint32_t index)
+{
+    if (!has(arena, index, Tag))
+    {
+        std::string name = "untagged";
+        if (arena.isLive(index))
+        {
+            try
+            {
+                if (auto tag = methods::GameObject::GetTag(arena[index].gameObject))
+                    name = toLowerString(tag->ToString());
+            }
+            catch (...)
+            {
+            }
+        }
+        m_tags[index] = internTag(name);
+    }
+    return m_tags[index];
+}
+
+const uint16_t* SceneColumns::components(const SceneArena& arena, uint32_t index, uint16_t& count)
+{
+    if (m_componentGarbage > kCompactThreshold && m_componentGarbage > m_componentTypes.size() / 2)
+    {
+        compactComponents();
+    }
+    if (!has(arena, index, Components))
+    {
+        m_componentOffsets[index] = static_cast<uint32_t>(m_componentTypes.size());
+        m_componentCounts[index] = 0;
+        if (arena.isLive(index))
+        {
+            static auto componentClass = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Component");
+            try
+            {
+                for (auto component : arena[index].gameObject->GetComponents<UnityResolve::UnityType::Component*>(
+                         componentClass))
+                {
+                    if (!component || m_componentCounts[index] == UINT16_MAX) continue;
+                    m_componentTypes.push_back(internType(methods::Runtime::GetObjectClass(component)));
+                    m_componentCounts[index]++;
+                }
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    count = m_componentCounts[index];
+    return m_componentTypes.data() + m_componentOffsets[index];
+}
+
+void SceneColumns::compactComponents()
+{
+    // Re-read slots append at the end, so ranges are not in slot order; copy the live ones out
+    std::vector<uint16_t> live;
+    live.reserve(m_componentTypes.size() - m_componentGarbage);
+    for (size_t slot = 0; slot < m_collected.size(); slot++)
+    {
+        if (!(m_collected[slot] & Components)) continue;
+        const auto first = m_componentTypes.begin() + m_componentOffsets[slot];
+        m_componentOffsets[slot] = static_cast<uint32_t>(live.size());
+        live.insert(live.end(), first, first + m_componentCounts[slot]);
+    }
+    m_componentTypes = std::move(live);
+    m_componentGarbage = 0;
+}
+
+size_t SceneColumns::memoryUsage() const
+{
+    return m_generations.capacity() * sizeof(uint32_t) + m_collected.capacity() + m_layers.capacity() +
+        m_tags.capacity() * sizeof(uint16_t) + m_componentOffsets.capacity() * sizeof(uint32_t) +
+        (m_componentCounts.capacity() + m_componentTypes.capacity()) * sizeof(uint16_t);
+}
+
+uint16_t SceneColumns::internTag(const std::string& name)
+{
+    auto [it, inserted] = m_tagIds.try_emplace(name, static_cast<uint16_t>(m_tagNames.size()));
+    if (inserted) m_tagNames.push_back(name);
+    return it->second;
+}
+
+uint16_t SceneColumns::internType(void* klass)
+{
+    auto [it, inserted] = m_typeIds.try_emplace(klass, static_cast<uint16_t>(m_types.size()));
+    if (!inserted) return it->second;
+
+    // Names of the whole base class chain, so "component:Collider" also finds a BoxCollider
+    ComponentType type = {klass, {}};
+    for (void* current = klass; current; current = methods::Runtime::GetClassParent(current))
+    {
+        if (const char* name = methods::Runtime::GetClassName(current)) type.names.push_back(toLowerString(name));
+    }
+    m_types.push_back(std::move(type));
+    return it->second;
+}
+
+// ---------------------------------------------------------------------------
+// SceneQuery
+// ---------------------------------------------------------------------------
+
+bool SceneQuery::isStructured(std::string_view text)
+{
+    size_t start = 0;
+    while (start < text.size())
+    {
+        const size_t end = std::min(text.find(' ', start), text.size());
+        const std::string_view token = text.substr(start, end - start);
+        start = end + 1;
+        if (token.empty()) continue;
+
+        if (token.size() > 1 && token[0] == '-') return true;
+        if (token.size() > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X')) return true;
+        if (token.rfind("name~", 0) == 0) return true;
+
+        const size_t colon = token.find(':');
+        if (colon != std::string_view::npos && isField(toLowerString(token.substr(0, colon)))) return true;
+    }
+    return false;
+}
+
+bool SceneQuery::compile(std::string_view text)
+{
+    m_terms.clear();
+    m_error.clear();
+
+    size_t start = 0;
+    while (start < text.size())
+    {
+        if (text[start] == ' ')
+        {
+            start++;
+            continue;
+        }
+
+        // A regex runs to its closing slash and may contain spaces
+        size_t end = std::min(text.find(' ', start), text.size());
+        const size_t regex = text.find("name~/", start);
+        if (regex == start || (regex == start + 1 && text[start] == '-'))
+        {
+            size_t close = regex + 6;
+            while (close < text.size() && (text[close] != '/' || text[close - 1] == '\\')) close++;
+            if (close >= text.size()) return fail("missing closing '/' in name~/regex/");
+            end = close + 1;
+        }
+
+        if (!parseTerm(text.substr(start, end - start))) return false;
+        start = end;
+    }
+
+    // Cheapest property first: the terms filter one candidate list in this order
+    std::stable_sort(m_terms.begin(), m_terms.end(), [](const Term& a, const Term& b) { return a.field < b.field; });
+    return true;
+}
+
+bool SceneQuery::parseTerm(std::string_view token)
+{
+    Term term;
+    if (token.size() > 1 && token[0] == '-')
+    {
+        term.negate = true;
+        token.remove_prefix(1);
+    }
+
+    if (token.rfind("name~", 0) == 0)
+    {
+        const std::string_view pattern = token.substr(5);
+        if (pattern.size() < 2 || pattern.front() != '/' || pattern.back() != '/') return fail("expected name~/regex/");
+        try
+        {
+            term.field = Field::NameRegex;
+            term.text = std::string(pattern.substr(1, pattern.size() - 2));
+            term.regex = std::regex(term.text, std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+        }
+        catch (const std::regex_error& e)
+        {
+            return fail("invalid regex: " + std::string(e.what()));
+        }
+        m_terms.push_back(std::move(term));
+        return true;
+    }
+
+    if (token.size() > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X'))
+    {
+        term.field = Field::Address;
+        if (!parseAddress(token, term.number)) return fail("invalid address '" + std::string(token) + "'");
+        m_terms.push_back(std::move(term));
+        return true;
+    }
+
+    // Anything that is not a known field is part of a name, colons included
+    const size_t colon = token.find(':');
+    const std::string key = colon != std::string_view::npos ? toLowerString(token.substr(0, colon)) : std::string();
+    if (!isField(key))
+    {
+        term.field = Field::Name;
+        term.text = toLowerString(token);
+        m_terms.push_back(std::move(term));
+        return true;
+    }
+
+    const std::string_view value = token.substr(colon + 1);
+    if (value.empty()) return fail("missing value for '" + key + "'");
+
+    if (key == "name")
+    {
+        term.field = Field::Name;
+        term.text = toLowerString(value);
+    }
+    else if (key == "component")
+    {
+        term.field = Field::Component;
+        term.text = toLowerString(value);
+    }
+    else if (key == "tag")
+    {
+        term.field = Field::Tag;
+        term.text = toLowerString(value);
+    }
+    else if (key == "layer")
+    {
+        term.field = Field::Layer;
+        if (!parseInteger(value, 10, term.number))
+        {
+            term.number = findLayer(toLowerString(value));
+            if (term.number < 0) return fail("unknown layer '" + std::string(value) + "'");
+        }
+        if (term.number < 0 || term.number > 31) return fail("layer must be between 0 and 31");
+    }
+    else if (key == "active")
+    {
+        term.field = Field::Active;
+        const std::string lower = toLowerString(value);
+        if (lower == "true" || lower == "1" || lower == "yes") term.number = 1;
+        else if (lower == "false" || lower == "0" || lower == "no") term.number = 0;
+        else return fail("active expects true or false");
+    }
+    else if (key == "id")
+    {
+        term.field = Field::InstanceId;
+        if (!parseInteger(value, 10, term.number)) return fail("invalid instance ID '" + std::string(value) + "'");
+    }
+    else if (key == "addr")
+    {
+        term.field = Field::Address;
+        if (!parseAddress(value, term.number)) return fail("invalid address '" + std::string(value) + "'");
+    }
+
+    m_terms.push_back(std::move(term));
+    return true;
+}
+
+bool SceneQuery::fail(std::string message)
+{
+    m_terms.clear();
+    m_error = std::move(message);
+    return false;
+}
+
+void SceneQuery::begin()
+{
+    m_term = 0;
+    m_cursor = 0;
+    m_kept = 0;
+    m_cache.clear();
+}
+
+bool SceneQuery::step(const SceneArena& arena, SceneColumns& columns, std::vector<uint32_t>& candidates,
+                      std::chrono::steady_clock::time_point deadline)
+{
+    while (m_term < m_terms.size() && !candidates.empty())
+    {
+        const Term& term = m_terms[m_term];
+        while (m_cursor < candidates.size())
+        {
+            const uint32_t index = candidates[m_cursor++];
+            // The arena may have been rebuilt since the candidates were taken; dropped nodes are skipped
+            if (index >= arena.capacity() || !arena[index].isLinked()) continue;
+            if (test(term, arena, columns, index) != term.negate) candidates[m_kept++] = index;
+            if (m_cursor % kCheckInterval == 0 && std::chrono::steady_clock::now() >= deadline) return false;
+        }
+
+        candidates.resize(m_kept);
+        m_term++;
+        m_cursor = 0;
+        m_kept = 0;
+        m_cache.clear();
+    }
+    return true;
+}
+
+bool SceneQuery::test(const Term& term, const SceneArena& arena, SceneColumns& columns, uint32_t index)
+{
+    const SceneNode& node = arena[index];
+    switch (term.field)
+    {
+    case Field::InstanceId:
+        return node.instanceId == term.number;
+    case Field::Address:
+    {
+        const auto address = static_cast<uintptr_t>(term.number);
+        return reinterpret_cast<uintptr_t>(node.gameObject) == address ||
+            reinterpret_cast<uintptr_t>(node.transform) == address ||
+            reinterpret_cast<uintptr_t>(node.native) == address;
+    }
+    case Field::Active:
+        return node.isActive() == (term.number != 0);
+    case Field::Name:
+    {
+        int8_t& result = cacheSlot(node.nameId);
+        if (result < 0) result = containsLowercase(arena.nameOf(index), term.text);
+        return result;
+    }
+    case Field::NameRegex:
+    {
+        int8_t& result = cacheSlot(node.nameId);
+        if (result < 0)
+        {
+            const std::string_view name = arena.nameOf(index);
+            result = std::regex_search(name.begin(), name.end(), term.regex);
+        }
+        return result;
+    }
+    case Field::Layer:
+        return columns.layer(arena, index) == term.number;
+    case Field::Tag:
+    {
+        const uint16_t tag = columns.tag(arena, index);
+        int8_t& result = cacheSlot(tag);
+        if (result < 0) result = columns.tagName(tag) == term.text;
+        return result;
+    }
+    case Field::Component:
+    {
+        uint16_t count = 0;
+        const uint16_t* types = columns.components(arena, index, count);
+        for (uint16_t i = 0; i < count; i++)
+        {
+            int8_t& result = cacheSlot(types[i]);
+            if (result < 0)
+            {
+                const auto& names = columns.componentType(types[i]).names;
+                result = std::find(names.begin(), names.end(), term.text) != names.end();
+            }
+            if (result) return true;
+        }
+        return false;
+    }
+    }
+    return false;
+}
@@ -0,0 +1,131 @@
+﻿#pragma once
+
+#include <chrono>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class SceneArena;
+
+// Per-node properties that cost a managed call to read: layer, tag and component types. Each column is stored
+// per arena slot and read on first use, then kept for as long as the slot holds the same object (its
+// generation), across refreshes; only reused slots are read again. Tags and component classes are interned into
+// small tables, so the columns hold integer IDs.
+class SceneColumns
+{
+public:
+    struct ComponentType
+    {
+        void* klass;
+        std::vector<std::string> names; // lowercase class name, then its base classes
+    };
+
+    int layer(const SceneArena& arena, uint32_t index);
+    uint16_t tag(const SceneArena& arena, uint32_t index);
+    // Component type IDs of the node; the pointer is valid until the next call
+    const uint16_t* components(const SceneArena& arena, uint32_t index, uint16_t& count);
+
+    const std::string& tagName(uint16_t id) const { return m_tagNames[id]; } // lowercase
+    const ComponentType& componentType(uint16_t id) const { return m_types[id]; }
+    size_t tagCount() const { return m_tagNames.size(); }
+    size_t componentTypeCount() const { return m_types.size(); }
+
+    size_t memoryUsage() const;
+
+private:
+    enum Column : uint8_t
+    {
+        Layer = 1 << 0,
+        Tag = 1 << 1,
+        Components = 1 << 2,
+    };
+
+    std::vector<uint32_t> m_generations; // arena slot generation the values belong to
+    std::vector<uint8_t> m_collected;    // Column bits
+    std::vector<uint8_t> m_layers;
+    std::vector<uint16_t> m_tags;
+    std::vector<uint32_t> m_componentOffsets; // into m_componentTypes
+    std::vector<uint16_t> m_componentCounts;
+    std::vector<uint16_t> m_componentTypes;
+    size_t m_componentGarbage = 0; // entries of m_componentTypes left behind by reused slots
+
+    std::vector<std::string> m_tagNames;
+    std::unordered_map<std::string, uint16_t> m_tagIds;
+    std::vector<ComponentType> m_types;
+    std::unordered_map<void*, uint16_t> m_typeIds;
+
+    bool has(const SceneArena& arena, uint32_t index, Column column);
+    uint16_t internTag(const std::string& name);
+    uint16_t internType(void* klass);
+    void compactComponents();
+};
+
+// Structured scene search. Terms are separated by spaces and must all hold:
+//   text, name:text     name contains text (case-insensitive)
+//   name~/regex/        name matches an ECMAScript regex (case-insensitive)
+//   component:Type      has a component whose class or a base class is named Type
+//   tag:Name            layer:8, layer:Water, active:true
+//   id:12345            instance ID
+//   0x1A2B, addr:0x1A2B managed or native address of the GameObject or its Transform
+// A leading '-' negates a term. Compiling orders the terms from the cheapest property to the most expensive one,
+// and running filters a candidate list through them in that order, so managed calls are only made for nodes
+// that passed every cheaper test. Name terms are answered per distinct interned name, not per node. A run can
+// be spread over frames: step() stops at a deadline and resumes where it stopped.
+class SceneQuery
+{
+public:
+    enum class Field : uint8_t
+    {
+        InstanceId,
+        Address,
+        Active,
+        Name,
+        NameRegex,
+        Layer,
+        Tag,
+        Component,
+    };
+
+    struct Term
+    {
+        Field field;
+        bool negate = false;
+        int64_t number = 0; // instance ID, address, layer or active
+        std::string text;   // lowercase name, tag or component class
+        std::regex regex;
+    };
+
+    // Whether the text uses anything beyond a plain name search
+    static bool isStructured(std::string_view text);
+
+    bool compile(std::string_view text);
+    const std::string& getError() const { return m_error; }
+    const std::vector<Term>& terms() const { return m_terms; }
+
+    // Start filtering a new candidate list
+    void begin();
+    // Filter `candidates` (linked arena slots) down to the nodes matching every term, until `deadline`. Returns
+    // true when done; otherwise call again with the same list.
+    bool step(const SceneArena& arena, SceneColumns& columns, std::vector<uint32_t>& candidates,
+              std::chrono::steady_clock::time_point deadline);
+
+private:
+    std::vector<Term> m_terms;
+    std::string m_error;
+    std::vector<int8_t> m_cache; // per name, tag or type ID while a term runs: -1 unknown, else the result
+    size_t m_term = 0;   // running term
+    size_t m_cursor = 0; // next candidate to test
+    size_t m_kept = 0;   // candidates that passed the running term, compacted to the front
+
+    bool parseTerm(std::string_view token);
+    bool test(const Term& term, const SceneArena& arena, SceneColumns& columns, uint32_t index);
+    bool fail(std::string message);
+
+    int8_t& cacheSlot(size_t id)
+    {
+        if (id >= m_cache.size()) m_cache.resize(id + 1, -1);
+        return m_cache[id];
+    }
+};
@@ -0,0 +1,197 @@
+﻿#include "pch.h"
+#include "snapshot_exporter.h"
+#include "scene_arena.h"
+#include "transform_sampler.h"
+
+#include <chrono>
+
+namespace
+{
+    // Component type names, resolved once per runtime class
+    class ComponentTypeTable
+    {
+    public:
+        explicit ComponentTypeTable(snapshot::StringTableBuilder& strings) : m_strings(strings) {}
+
+        uint32_t idOf(UnityResolve::UnityType::Component* component)
+        {
+            void* klass = methods::Runtime::GetObjectClass(component);
+            auto it = m_ids.find(klass);
+            if (it != m_ids.end()) return it->second;
+
+            std::string name = "Component";
+            try
+            {
+                if (auto type = component->GetType())
+                {
+                    if (auto fullName = type->GetFullName()) name = fullName->ToString();
+                }
+            }
+            catch (...)
+            {
+            }
+
+            const uint32_t id = static_cast<uint32_t>(m_names.size());
+            m_names.push_back(m_strings.intern(name));
+            m_ids.emplace(klass, id);
+            return id;
+        }
+
+        const std::vector<uint32_t>& names() const { return m_names; }
+
+    private:
+        snapshot::StringTableBuilder& m_strings;
+        std::unordered_map<void*, uint32_t> m_ids;
+        std::vector<uint32_t> m_names; // string index per type id
+    };
+}
+
+void SnapshotExporter::capture(const SceneArena& arena, const Options& options, bool partial,
+                               snapshot::Capture& out)
+{
+    out = snapshot::Capture();
+    out.flags = partial ? snapshot::PartialHierarchy : 0;
+    out.createdUnixMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    // Preorder walk over the sibling lists. Links are filled in as nodes are emitted: a node's first child is
+    // always the next record, and its next sibling is patched when that sibling is reached.
+    std::vector<snapshot::NodeRecord>& nodes = out.nodes;
+    nodes.reserve(arena.liveCount());
+    std::vector<UnityResolve::UnityType::Transform*> transforms;
+    if (options.transforms) transforms.reserve(arena.liveCount());
+
+    std::vector<uint32_t> nameIds(arena.names().size(), snapshot::kNone);
+    ComponentTypeTable componentTypes(out.strings);
+    auto componentClass = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Component");
+
+    std::vector<uint32_t> remap(arena.capacity(), snapshot::kNone);
+    std::vector<uint32_t> lastChild; // per record, most recently emitted child
+    uint32_t lastRoot = snapshot::kNone;
+
+    uint32_t index = arena.firstRoot();
+    while (index != SceneArena::kInvalid)
+    {
+        const SceneNode& node = arena[index];
+        const uint32_t id = static_cast<uint32_t>(nodes.size());
+        remap[index] = id;
+
+        snapshot::NodeRecord record = {};
+        record.instanceId = node.instanceId;
+        record.parent = node.parent != SceneArena::kInvalid ? remap[node.parent] : snapshot::kNone;
+        record.firstChild = snapshot::kNone;
+        record.nextSibling = snapshot::kNone;
+        record.depth = record.parent != snapshot::kNone ? static_cast<uint16_t>(nodes[record.parent].depth + 1) : 0;
+        record.childCount = node.childCount;
+        record.flags = static_cast<uint16_t>((node.isActive() ? snapshot::NodeActive : 0) |
+            (!partial || node.flags & SceneNode::ChildrenLoaded ? snapshot::NodeChildrenLoaded : 0));
+
+        if (nameIds[node.nameId] == snapshot::kNone) nameIds[node.nameId] = out.strings.intern(arena.nameOf(index));
+        record.name = nameIds[node.nameId];
+
+        uint32_t& previous = record.parent != snapshot::kNone ? lastChild[record.parent] : lastRoot;
+        if (previous != snapshot::kNone) nodes[previous].nextSibling = id;
+        else if (record.parent != snapshot::kNone) nodes[record.parent].firstChild = id;
+        previous = id;
+
+        record.firstComponent = static_cast<uint32_t>(out.components.size());
+        if (options.components && node.gameObject && arena.isLive(index))
+        {
+            try
+            {
+                for (auto component : node.gameObject->GetComponents<UnityResolve::UnityType::Component*>(
+                         componentClass))
+                {
+                    if (!component || record.componentCount == UINT16_MAX) continue;
+                    out.components.push_back(componentTypes.idOf(component));
+                    record.componentCount++;
+                }
+            }
+            catch (...)
+            {
+            }
+        }
+
+        nodes.push_back(record);
+        lastChild.push_back(snapshot::kNone);
+        if (options.transforms) transforms.push_back(arena.isLive(index) ? node.transform : nullptr);
+
+        if (node.hasChildren())
+        {
+            index = node.firstChild;
+            continue;
+        }
+        while (index != SceneArena::kInvalid && arena[index].nextSibling == SceneArena::kInvalid)
+            index = arena[index].parent;
+        if (index != SceneArena::kInvalid) index = arena[index].nextSibling;
+    }
+    out.componentTypes = componentTypes.names();
+
+    // World transforms as SoA floats, parallel to the node table
+    if (!transforms.empty())
+    {
+        TransformSoA soa;
+        TransformSampler::getInstance().sample(transforms.data(), transforms.size(), TransformSampler::Space::World,
+                                               soa);
+
+        const size_t count = transforms.size();
+        out.transforms.resize(count * 10);
+        float* positions = out.transforms.data();
+        float* rotations = positions + count * 3;
+        float* scales = positions + count * 7;
+        for (size_t i = 0; i < count; i++)
+        {
+            memcpy(positions + i * 3, &soa.positions[i], sizeof(float) * 3);
+            rotations[i * 4 + 0] = soa.rotations[i].x;
+            rotations[i * 4 + 1] = soa.rotations[i].y;
+            rotations[i * 4 + 2] = soa.rotations[i].z;
+            rotations[i * 4 + 3] = soa.rotations[i].w;
+            memcpy(scales + i * 3, &soa.scales[i], sizeof(float) * 3);
+        }
+    }
+}
+
+SnapshotExporter::Result SnapshotExporter::save(const SceneArena& arena, const std::string& directory,
+                                                const Options& options, bool partial)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    Result result;
+
+    const auto rawTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    tm gmtm;
+    gmtime_s(&gmtm, &rawTime);
+    result.path = Utils::string_format("%s\\scene_%04d-%02d-%02d_%02d-%02d-%02d.urisnap", directory.c_str(),
+                                       1900 + gmtm.tm_year, gmtm.tm_mon + 1, gmtm.tm_mday, gmtm.tm_hour,
+                                       gmtm.tm_min, gmtm.tm_sec);
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    snapshot::Capture snapshot;
+    capture(arena, options, partial, snapshot);
+
+    snapshot::Writer writer;
+    writer.setCompression(options.compress);
+    result.success = snapshot.write(writer, result.path.c_str());
+
+    result.error = writer.getError();
+    result.nodes = snapshot.nodes.size();
+    result.componentTypes = snapshot.componentTypes.size();
+    result.components = snapshot.components.size();
+    result.bytes = writer.bytesWritten();
+    result.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    if (result.success)
+    {
+        LOG_INFO("[SnapshotExporter] Saved %zu nodes (%zu components) to %s, %llu bytes in %.1f ms", result.nodes,
+                 result.components, result.path.c_str(), static_cast<unsigned long long>(result.bytes),
+                 result.elapsedMs);
+    }
+    else
+    {
+        LOG_ERROR("[SnapshotExporter] Could not write %s: %s", result.path.c_str(), result.error.c_str());
+    }
+    return result;
+}
@@ -0,0 +1,42 @@
+﻿#pragma once
+
+#include "snapshot/snapshot_writer.h"
+
+#include <cstdint>
+#include <string>
+
+class SceneArena;
+
+// Captures the explorer's hierarchy as a snapshot (see snapshot_format.h), either in memory for diffing or as
+// a file for offline analysis with tools/snapshot_viewer. The arena is walked once in depth-first preorder,
+// which yields the node table, the string table and the component list together; transforms are then read
+// in one bulk pass. Files are written block after block with no seeking.
+class SnapshotExporter
+{
+public:
+    struct Options
+    {
+        bool compress = true;   // LZ4 per block
+        bool components = true; // one GetComponents call per node
+        bool transforms = true; // world position, rotation and lossy scale
+    };
+
+    struct Result
+    {
+        bool success = false;
+        std::string path;
+        std::string error;
+        size_t nodes = 0;
+        size_t componentTypes = 0;
+        size_t components = 0;
+        uint64_t bytes = 0;
+        double elapsedMs = 0.0;
+    };
+
+    // `partial` marks a capture from a lazy hierarchy, where unexpanded subtrees are missing
+    static void capture(const SceneArena& arena, const Options& options, bool partial, snapshot::Capture& out);
+
+    // Capture and write to `directory`/scene_<UTC time>.urisnap
+    static Result save(const SceneArena& arena, const std::string& directory, const Options& options,
+                       bool partial);
+};
@@ -0,0 +1,643 @@
+﻿#include "pch.h"
+#include "spatial_index.h"
+#include "methods/method_helpers.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Number of objects collected between deadline checks; each costs up to two GetComponent calls
+    constexpr size_t kCheckInterval = 16;
+    // Transforms per bulk position sample in the Sample phase
+    constexpr size_t kSampleSlice = 4096;
+    // Items per slice of a large split; nodes up to this size are split in one go, at the median
+    constexpr uint32_t kSplitSlice = 4096;
+    // A midpoint split leaving less than 1/kMinSplitFraction on one side is redone around a sampled median
+    constexpr uint32_t kMinSplitFraction = 8;
+    constexpr uint32_t kMedianSamples = 63;
+    constexpr uint32_t kLeafSize = 4;
+    constexpr uint32_t kNoParent = UINT32_MAX;
+
+    // Items whose position moved less than this are left alone by refit()
+    constexpr float kMoveEpsilon = 1e-4f;
+
+    // Depth-first traversal stack. Two children are pushed per popped node, so it never holds more than the
+    // tree depth plus one; deeper trees than the local buffer allows spill to the heap.
+    class TraversalStack
+    {
+    public:
+        explicit TraversalStack(uint32_t depth)
+        {
+            if (depth + 2 <= kLocal) return;
+            m_heap.resize(depth + 2);
+            m_data = m_heap.data();
+        }
+
+        void push(uint32_t node) { m_data[m_size++] = node; }
+        uint32_t pop() { return m_data[--m_size]; }
+        bool empty() const { return m_size == 0; }
+
+    private:
+        static constexpr uint32_t kLocal = 64;
+        uint32_t m_local[kLocal];
+        std::vector<uint32_t> m_heap;
+        uint32_t* m_data = m_local;
+        uint32_t m_size = 0;
+    };
+
+    bool sameBox(const Aabb& a, const Aabb& b)
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (a.min[axis] != b.min[axis] || a.max[axis] != b.max[axis]) return false;
+        }
+        return true;
+    }
+
+    Aabb fromBounds(const UnityResolve::UnityType::Bounds& bounds)
+    {
+        const auto& c = bounds.m_vCenter;
+        const auto& e = bounds.m_vExtents;
+        Aabb box;
+        box.min[0] = c.x - e.x, box.min[1] = c.y - e.y, box.min[2] = c.z - e.z;
+        box.max[0] = c.x + e.x, box.max[1] = c.y + e.y, box.max[2] = c.z + e.z;
+        return box;
+    }
+
+    // Entry distance of a ray into a box (slab test), or -1 if it misses or the box lies behind the origin
+    float intersect(const Aabb& box, const float origin[3], const float inverse[3], float maxT)
+    {
+        float tMin = 0.0f;
+        float tMax = maxT;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float t0 = (box.min[axis] - origin[axis]) * inverse[axis];
+            float t1 = (box.max[axis] - origin[axis]) * inverse[axis];
+            if (t0 > t1) std::swap(t0, t1);
+            tMin = t0 > tMin ? t0 : tMin; // NaN from 0 * inf keeps the previous bound
+            tMax = t1 < tMax ? t1 : tMax;
+            if (tMin > tMax) return -1.0f;
+        }
+        return tMin;
+    }
+}
+
+bool Aabb::overlaps(const Aabb& other) const
+{
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (other.min[axis] > max[axis] || other.max[axis] < min[axis]) return false;
+    }
+    return true;
+}
+
+float Aabb::distanceSq(const float point[3]) const
+{
+    float sum = 0.0f;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        const float d = std::max({min[axis] - point[axis], 0.0f, point[axis] - max[axis]});
+        sum += d * d;
+    }
+    return sum;
+}
+
+void SpatialIndex::begin(const SceneArena& arena)
+{
+    cancel();
+    for (uint32_t index = 0; index < arena.capacity(); index++)
+    {
+        if (arena[index].isLinked()) m_queue.push_back(arena.ref(index));
+    }
+    m_pending.reserve(m_queue.size());
+    m_startTime = Clock::now();
+    m_building = true;
+}
+
+void SpatialIndex::cancel()
+{
+    m_building = false;
+    m_phase = Phase::Collect;
+    m_queue.clear();
+    m_cursor = 0;
+    m_pending.clear();
+    m_pendingBounded = 0;
+    m_sampled = 0;
+    m_tasks.clear();
+    m_large.active = false;
+    m_pendingNodes.clear();
+    m_pendingParents.clear();
+    m_pendingLeafOf.clear();
+}
+
+float SpatialIndex::getProgress() const
+{
+    // Collection is by far the slowest phase
+    switch (m_phase)
+    {
+    case Phase::Collect:
+        return m_queue.empty() ? 0.0f : 0.8f * m_cursor / m_queue.size();
+    case Phase::Sample:
+        return m_pending.empty() ? 0.8f : 0.8f + 0.1f * m_sampled / m_pending.size();
+    default:
+        return m_pending.empty() ? 0.9f : 0.9f + 0.1f * (m_pendingNodes.size() / 2.0f) / m_pending.size();
+    }
+}
+
+bool SpatialIndex::collect(const SceneArena& arena, uint32_t index, Item& item)
+{
+    const SceneNode& node = arena[index];
+    item.node = arena.ref(index);
+    item.transform = node.transform;
+
+    static auto rendererClass = GET_CLASS("UnityEngine.CoreModule.dll", "Renderer");
+    static auto colliderClass = GET_CLASS("UnityEngine.PhysicsModule.dll", "Collider");
+    try
+    {
+        if (rendererClass)
+        {
+            if (auto renderer = node.gameObject->GetComponent<UnityResolve::UnityType::Renderer*>(rendererClass))
+            {
+                item.box = fromBounds(renderer->GetBounds());
+                return true;
+            }
+        }
+        if (colliderClass)
+        {
+            if (auto collider = node.gameObject->GetComponent<UnityResolve::UnityType::Collider*>(colliderClass))
+            {
+                item.box = fromBounds(collider->GetBounds());
+                return true;
+            }
+        }
+    }
+    catch (...)
+    {
+    }
+    return false;
+}
+
+bool SpatialIndex::step(const SceneArena& arena, uint32_t budgetUs)
+{
+    if (!m_building) return false;
+
+    const auto deadline = budgetUs > 0 ? Clock::now() + std::chrono::microseconds(budgetUs) : Clock::time_point::max();
+    switch (m_phase)
+    {
+    case Phase::Collect:
+        if (!collectBounds(arena, deadline)) return false;
+        [[fallthrough]];
+    case Phase::Sample:
+        if (!samplePositions(deadline)) return false;
+        [[fallthrough]];
+    case Phase::Tree:
+        if (!buildTree(deadline)) return false;
+    }
+
+    finish();
+    return true;
+}
+
+bool SpatialIndex::collectBounds(const SceneArena& arena, Clock::time_point deadline)
+{
+    while (m_cursor < m_queue.size())
+    {
+        const uint32_t index = arena.resolve(m_queue[m_cursor++]);
+        if (index != SceneArena::kInvalid && arena.isLive(index) && arena[index].transform)
+        {
+            Item item = {};
+            if (collect(arena, index, item)) m_pendingBounded++;
+            else item.box = Aabb(); // a point at the position, filled in by samplePositions()
+            m_pending.push_back(item);
+        }
+
+        if (m_cursor % kCheckInterval == 0 && Clock::now() >= deadline) return false;
+    }
+
+    m_phase = Phase::Sample;
+    m_sampled = 0;
+    return true;
+}
+
+bool SpatialIndex::samplePositions(Clock::time_point deadline)
+{
+    while (m_sampled < m_pending.size())
+    {
+        const size_t count = std::min(kSampleSlice, m_pending.size() - m_sampled);
+        m_refitTransforms.resize(count);
+        for (size_t i = 0; i < count; i++) m_refitTransforms[i] = m_pending[m_sampled + i].transform;
+        TransformSampler::getInstance().sample(m_refitTransforms.data(), count, TransformSampler::Space::World,
+                                               m_sample);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Item& item = m_pending[m_sampled + i];
+            const Vector3& position = m_sample.positions[i];
+            item.position[0] = position.x, item.position[1] = position.y, item.position[2] = position.z;
+            if (item.box.min[0] > item.box.max[0])
+            {
+                for (int axis = 0; axis < 3; axis++) item.box.min[axis] = item.box.max[axis] = item.position[axis];
+            }
+        }
+        m_sampled += count;
+        if (m_sampled < m_pending.size() && Clock::now() >= deadline) return false;
+    }
+
+    // The root covers everything; its split queues the children
+    const auto items = static_cast<uint32_t>(m_pending.size());
+    m_pendingNodes.clear();
+    m_pendingParents.clear();
+    m_pendingNodes.reserve(m_pending.size() * 2);
+    m_pendingParents.reserve(m_pending.size() * 2);
+    m_pendingLeafOf.assign(m_pending.size(), 0);
+    m_tasks.clear();
+    m_pendingDepth = 0;
+    if (items > 0)
+    {
+        m_pendingNodes.resize(1);
+        m_pendingParents.assign(1, kNoParent);
+        m_tasks.push_back({0, 0, items, 0});
+    }
+    m_treeMs = 0.0f;
+    m_phase = Phase::Tree;
+    return true;
+}
+
+bool SpatialIndex::buildTree(Clock::time_point deadline)
+{
+    // Small nodes are one work item each; large ones take several slices, so no step exceeds the budget by much
+    const auto start = Clock::now();
+    while (m_large.active || !m_tasks.empty())
+    {
+        if (!m_large.active)
+        {
+            const Task task = m_tasks.back();
+            m_tasks.pop_back();
+            if (task.count <= kSplitSlice)
+            {
+                split(task);
+            }
+            else
+            {
+                m_large = {};
+                m_large.task = task;
+                m_large.active = true;
+                m_large.cursor = task.first;
+            }
+        }
+        else
+        {
+            advanceLargeSplit();
+        }
+        if ((m_large.active || !m_tasks.empty()) && Clock::now() >= deadline) break;
+    }
+    m_treeMs += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    return !m_large.active && m_tasks.empty();
+}
+
+bool SpatialIndex::advanceLargeSplit()
+{
+    LargeSplit& large = m_large;
+    const Task& task = large.task;
+    const uint32_t end = task.first + task.count;
+
+    if (!large.partitioning)
+    {
+        const uint32_t stop = std::min(end, large.cursor + kSplitSlice);
+        for (; large.cursor < stop; large.cursor++)
+        {
+            const Aabb& box = m_pending[large.cursor].box;
+            large.box.grow(box);
+            Aabb center;
+            for (int axis = 0; axis < 3; axis++) center.min[axis] = center.max[axis] = box.center(axis);
+            large.centers.grow(center);
+        }
+        if (large.cursor < end) return false;
+
+        m_pendingNodes[task.node].box = large.box;
+        if (!chooseAxis(task, large.centers, large.axis))
+        {
+            large.active = false;
+            return true;
+        }
+        large.mid = large.centers.center(large.axis);
+        large.lo = task.first;
+        large.hi = end;
+        large.partitioning = true;
+        return false;
+    }
+
+    for (uint32_t steps = 0; large.lo < large.hi && steps < kSplitSlice; steps++)
+    {
+        if (m_pending[large.lo].box.center(large.axis) < large.mid) large.lo++;
+        else std::swap(m_pending[large.lo], m_pending[--large.hi]);
+    }
+    if (large.lo < large.hi) return false;
+
+    // Clustered objects with far outliers (or non-finite positions) can leave one side with a few items at every
+    // level, which would make the tree about as deep as there are outliers. Such a range is partitioned again,
+    // in slices as well, around the median of a sample of its centers, which keeps the depth logarithmic.
+    uint32_t half = large.lo - task.first;
+    if (std::min(half, task.count - half) < task.count / kMinSplitFraction)
+    {
+        if (!large.resampled)
+        {
+            large.resampled = true;
+            large.mid = sampleMedian(task, large.axis, large.mid);
+            large.lo = task.first;
+            large.hi = end;
+            return false;
+        }
+        // Mostly equal centers; any halving keeps the boxes correct and the depth bounded
+        half = task.count / 2;
+    }
+    addChildren(task, half);
+    large.active = false;
+    return true;
+}
+
+float SpatialIndex::sampleMedian(const Task& task, int axis, float fallback) const
+{
+    float samples[kMedianSamples];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < kMedianSamples; i++)
+    {
+        const auto item = task.first + static_cast<uint32_t>(static_cast<uint64_t>(task.count) * i / kMedianSamples);
+        const float center = m_pending[item].box.center(axis);
+        if (!std::isnan(center)) samples[count++] = center;
+    }
+    if (count == 0) return fallback;
+
+    std::nth_element(samples, samples + count / 2, samples + count);
+    return samples[count / 2];
+}
+
+bool SpatialIndex::chooseAxis(const Task& task, const Aabb& centers, int& axis)
+{
+    axis = 0;
+    float extent = -1.0f;
+    for (int a = 0; a < 3; a++)
+    {
+        if (centers.max[a] - centers.min[a] > extent)
+        {
+            extent = centers.max[a] - centers.min[a];
+            axis = a;
+        }
+    }
+
+    // Leaves hold a few items, or any number that share one center and cannot be split
+    if (task.count <= kLeafSize || extent <= 0.0f)
+    {
+        m_pendingNodes[task.node].first = task.first;
+        m_pendingNodes[task.node].count = task.count;
+        for (uint32_t i = task.first; i < task.first + task.count; i++) m_pendingLeafOf[i] = task.node;
+        return false;
+    }
+    return true;
+}
+
+void SpatialIndex::addChildren(const Task& task, uint32_t half)
+{
+    // Children are allocated next to each other so an inner node only stores the first. The right one is
+    // queued first so the left is split next, depth first as the recursion was.
+    const auto left = static_cast<uint32_t>(m_pendingNodes.size());
+    m_pendingNodes[task.node].first = left;
+    m_pendingNodes[task.node].count = 0;
+    m_pendingNodes.resize(left + 2);
+    m_pendingParents.resize(left + 2, task.node);
+    m_tasks.push_back({left + 1, task.first + half, task.count - half, task.depth + 1});
+    m_tasks.push_back({left, task.first, half, task.depth + 1});
+    m_pendingDepth = std::max(m_pendingDepth, task.depth + 1);
+}
+
+void SpatialIndex::finish()
+{
+    m_items = std::move(m_pending);
+    m_nodes = std::move(m_pendingNodes);
+    m_parents = std::move(m_pendingParents);
+    m_leafOf = std::move(m_pendingLeafOf);
+    m_bounded = m_pendingBounded;
+    m_depth = m_pendingDepth;
+    m_pending = {};
+    m_pendingNodes = {};
+    m_pendingParents = {};
+    m_pendingLeafOf = {};
+    m_refitCursor = 0;
+
+    m_buildMs = std::chrono::duration<float, std::milli>(Clock::now() - m_startTime).count();
+    m_building = false;
+    m_phase = Phase::Collect;
+    m_queue.clear();
+    m_cursor = 0;
+    m_sampled = 0;
+
+    LOG_INFO("[SpatialIndex] Indexed %zu objects (%zu with bounds), %zu nodes, depth %u, tree %.2f ms, "
+             "total %.1f ms", m_items.size(), m_bounded, m_nodes.size(), m_depth, m_treeMs, m_buildMs);
+}
+
+void SpatialIndex::split(const Task& task)
+{
+    const uint32_t first = task.first;
+    const uint32_t count = task.count;
+    Aabb box;
+    Aabb centers;
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        box.grow(m_pending[i].box);
+        Aabb center;
+        for (int axis = 0; axis < 3; axis++) center.min[axis] = center.max[axis] = m_pending[i].box.center(axis);
+        centers.grow(center);
+    }
+    m_pendingNodes[task.node].box = box;
+
+    int axis;
+    if (!chooseAxis(task, centers, axis)) return;
+
+    // Median split along the longest axis of the centers
+    const uint32_t half = count / 2;
+    std::nth_element(m_pending.begin() + first, m_pending.begin() + first + half, m_pending.begin() + first + count,
+                     [axis](const Item& a, const Item& b) { return a.box.center(axis) < b.box.center(axis); });
+    addChildren(task, half);
+}
+
+size_t SpatialIndex::refit(const SceneArena& arena, uint32_t maxObjects, uint32_t budgetUs)
+{
+    if (m_items.empty()) return 0;
+    const auto start = Clock::now();
+    const auto deadline = budgetUs > 0 ? start + std::chrono::microseconds(budgetUs) : Clock::time_point::max();
+
+    // A slice at a time, like the Sample phase of a build, so the call stops near the deadline
+    size_t moved = 0;
+    const size_t total = std::min<size_t>(maxObjects, m_items.size());
+    for (size_t visited = 0; visited < total;)
+    {
+        // Live items of the next slice; destroyed objects keep their last box until the next rebuild
+        m_refitTransforms.clear();
+        m_refitItems.clear();
+        const size_t stop = std::min(total, visited + kSampleSlice);
+        for (; visited < stop; visited++)
+        {
+            const auto item = static_cast<uint32_t>(m_refitCursor);
+            m_refitCursor = (m_refitCursor + 1) % m_items.size();
+
+            const uint32_t index = arena.resolve(m_items[item].node);
+            if (index == SceneArena::kInvalid || !arena.isLive(index)) continue;
+            m_refitTransforms.push_back(m_items[item].transform);
+            m_refitItems.push_back(item);
+        }
+        TransformSampler::getInstance().sample(m_refitTransforms.data(), m_refitTransforms.size(),
+                                               TransformSampler::Space::World, m_sample);
+        moved += refitSampled();
+
+        if (Clock::now() >= deadline) break;
+    }
+
+    m_refitUs = std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+    return moved;
+}
+
+size_t SpatialIndex::refitSampled()
+{
+    size_t moved = 0;
+    for (size_t i = 0; i < m_refitItems.size(); i++)
+    {
+        Item& item = m_items[m_refitItems[i]];
+        const Vector3& position = m_sample.positions[i];
+        const float delta[3] = {position.x - item.position[0], position.y - item.position[1],
+                                position.z - item.position[2]};
+        if (std::fabs(delta[0]) < kMoveEpsilon && std::fabs(delta[1]) < kMoveEpsilon &&
+            std::fabs(delta[2]) < kMoveEpsilon)
+            continue;
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            item.position[axis] += delta[axis];
+            item.box.min[axis] += delta[axis];
+            item.box.max[axis] += delta[axis];
+        }
+        moved++;
+
+        // Recompute boxes upwards until one comes out unchanged
+        for (uint32_t node = m_leafOf[m_refitItems[i]]; node != kNoParent; node = m_parents[node])
+        {
+            Node& current = m_nodes[node];
+            Aabb box;
+            if (current.count > 0)
+            {
+                for (uint32_t j = current.first; j < current.first + current.count; j++) box.grow(m_items[j].box);
+            }
+            else
+            {
+                box = m_nodes[current.first].box;
+                box.grow(m_nodes[current.first + 1].box);
+            }
+            if (sameBox(box, current.box)) break;
+            current.box = box;
+        }
+    }
+    return moved;
+}
+
+template <typename Test>
+void SpatialIndex::query(const float center[3], Test&& test, std::vector<Hit>& out) const
+{
+    out.clear();
+    if (m_nodes.empty()) return;
+
+    TraversalStack stack(m_depth);
+    stack.push(0);
+    while (!stack.empty())
+    {
+        const Node& node = m_nodes[stack.pop()];
+        if (!test(node.box)) continue;
+
+        if (node.count == 0)
+        {
+            stack.push(node.first);
+            stack.push(node.first + 1);
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            if (test(m_items[i].box)) out.push_back({m_items[i].node, std::sqrt(m_items[i].box.distanceSq(center))});
+        }
+    }
+    std::sort(out.begin(), out.end(), [](const Hit& a, const Hit& b) { return a.distance < b.distance; });
+}
+
+void SpatialIndex::queryRadius(const Vector3& center, float radius, std::vector<Hit>& out) const
+{
+    const float point[3] = {center.x, center.y, center.z};
+    const float radiusSq = radius * radius;
+    query(point, [&](const Aabb& box) { return box.distanceSq(point) <= radiusSq; }, out);
+}
+
+void SpatialIndex::queryBox(const Aabb& box, std::vector<Hit>& out) const
+{
+    const float point[3] = {box.center(0), box.center(1), box.center(2)};
+    query(point, [&](const Aabb& other) { return other.overlaps(box); }, out);
+}
+
+bool SpatialIndex::raycast(const Vector3& origin, const Vector3& direction, Hit& hit) const
+{
+    if (m_nodes.empty()) return false;
+
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+    if (length <= 0.0f) return false;
+    const float from[3] = {origin.x, origin.y, origin.z};
+    const float inverse[3] = {length / direction.x, length / direction.y, length / direction.z};
+
+    // Nearer child first, and subtrees entered beyond the best hit so far are skipped
+    float best = FLT_MAX;
+    uint32_t bestItem = UINT32_MAX;
+    TraversalStack stack(m_depth);
+    stack.push(0);
+    while (!stack.empty())
+    {
+        const Node& node = m_nodes[stack.pop()];
+        if (intersect(node.box, from, inverse, best) < 0.0f) continue;
+
+        if (node.count == 0)
+        {
+            const float tLeft = intersect(m_nodes[node.first].box, from, inverse, best);
+            const float tRight = intersect(m_nodes[node.first + 1].box, from, inverse, best);
+            const bool leftFirst = tRight < 0.0f || (tLeft >= 0.0f && tLeft <= tRight);
+            stack.push(leftFirst ? node.first + 1 : node.first);
+            stack.push(leftFirst ? node.first : node.first + 1);
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            const float t = intersect(m_items[i].box, from, inverse, best);
+            if (t >= 0.0f && t < best)
+            {
+                best = t;
+                bestItem = i;
+            }
+        }
+    }
+
+    if (bestItem == UINT32_MAX) return false;
+    hit = {m_items[bestItem].node, best};
+    return true;
+}
+
+bool SpatialIndex::findCenter(NodeRef node, Vector3& center) const
+{
+    for (const Item& item : m_items)
+    {
+        if (item.node.index == node.index && item.node.generation == node.generation)
+        {
+            center = Vector3(item.box.center(0), item.box.center(1), item.box.center(2));
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t SpatialIndex::memoryUsage() const
+{
+    return m_items.capacity() * sizeof(Item) + m_nodes.capacity() * sizeof(Node) +
+        (m_parents.capacity() + m_leafOf.capacity()) * sizeof(uint32_t);
+}
@@ -0,0 +1,179 @@
+﻿#pragma once
+
+#include "scene_arena.h"
+#include "transform_sampler.h"
+
+#include <cfloat>
+#include <chrono>
+#include <vector>
+
+struct Aabb
+{
+    float min[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float max[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+    void grow(const Aabb& other)
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (other.min[axis] < min[axis]) min[axis] = other.min[axis];
+            if (other.max[axis] > max[axis]) max[axis] = other.max[axis];
+        }
+    }
+
+    float center(int axis) const { return (min[axis] + max[axis]) * 0.5f; }
+    bool overlaps(const Aabb& other) const;
+    float distanceSq(const float point[3]) const; // 0 inside
+};
+
+// Bounding volume hierarchy over the objects in the arena, for region queries (radius, box) and picking by
+// ray. Each object contributes its Renderer bounds, else its Collider bounds, else its position as a point.
+// Building is resumable like the hierarchy scan, in three phases under the caller's budget: collecting bounds
+// (managed calls per object), sampling positions in bulk slices, and splitting the tree node by node from an
+// explicit work stack. Large nodes are split a slice at a time too, at the midpoint rather than the median,
+// unless that leaves one side nearly empty. The previous tree keeps answering queries until the new one
+// replaces it. Movement is tracked by refit(): transforms are sampled a slice at a time under a budget, moved
+// boxes are translated by the position change, and only their ancestors are widened or shrunk again. Rotation
+// and scale changes are picked up by the next rebuild.
+class SpatialIndex
+{
+public:
+    using Vector3 = UnityResolve::UnityType::Vector3;
+
+    struct Hit
+    {
+        NodeRef node;
+        float distance; // from the query center or ray origin
+    };
+
+    enum class Phase
+    {
+        Collect, // Renderer or Collider bounds of every node
+        Sample,  // world positions, a slice of transforms at a time
+        Tree,    // one node split per work item
+    };
+
+    // Index every linked, live node. Restarts a build already in progress.
+    void begin(const SceneArena& arena);
+    void cancel();
+    // Build for at most budgetUs (0 = until done). Returns true when the new tree replaced the old one.
+    bool step(const SceneArena& arena, uint32_t budgetUs);
+
+    // Sample up to maxObjects transforms for at most budgetUs (0 = no limit), continuing where the previous call
+    // stopped, and refit the boxes of the ones that moved. Returns the number of objects that moved.
+    size_t refit(const SceneArena& arena, uint32_t maxObjects, uint32_t budgetUs);
+
+    // Objects whose bounds come within `radius` of `center`, nearest first
+    void queryRadius(const Vector3& center, float radius, std::vector<Hit>& out) const;
+    // Objects whose bounds overlap `box`, nearest to its center first
+    void queryBox(const Aabb& box, std::vector<Hit>& out) const;
+    // Nearest object whose bounds the ray enters; `direction` need not be normalized
+    bool raycast(const Vector3& origin, const Vector3& direction, Hit& hit) const;
+    // Center of an indexed object's bounds as of the last refit
+    bool findCenter(NodeRef node, Vector3& center) const;
+
+    bool isBuilding() const { return m_building; }
+    Phase getPhase() const { return m_phase; }
+    float getProgress() const;
+    bool isBuilt() const { return !m_nodes.empty(); }
+    size_t size() const { return m_items.size(); }
+    size_t nodeCount() const { return m_nodes.size(); }
+    size_t boundedCount() const { return m_bounded; } // objects with Renderer or Collider bounds
+    float getBuildMs() const { return m_buildMs; } // wall time of the last collection, over all frames
+    float getTreeMs() const { return m_treeMs; } // building the tree from the collected boxes, over all frames
+    float getRefitUs() const { return m_refitUs; }
+    size_t memoryUsage() const;
+
+private:
+    struct Item
+    {
+        NodeRef node;
+        UnityResolve::UnityType::Transform* transform;
+        float position[3]; // when the box was last moved
+        Aabb box;
+    };
+
+    // Inner nodes have count 0 and their children at `first` and `first + 1`; leaves cover m_items[first, +count)
+    struct Node
+    {
+        Aabb box;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<Item> m_items;
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_parents; // per node
+    std::vector<uint32_t> m_leafOf; // per item
+    size_t m_bounded = 0;
+    uint32_t m_depth = 0; // of the deepest node, which sizes the traversal stack
+
+    // A node range still to be split
+    struct Task
+    {
+        uint32_t node;
+        uint32_t first;
+        uint32_t count;
+        uint32_t depth;
+    };
+
+    // Split of a large range in progress: bounds over [first, cursor), then a partition around `mid` that has
+    // sorted [first, lo) below it and [hi, end) above
+    struct LargeSplit
+    {
+        Task task;
+        bool active = false;
+        bool partitioning = false;
+        bool resampled = false; // partitioning again around a sampled median
+        uint32_t cursor;
+        Aabb box;
+        Aabb centers;
+        int axis;
+        float mid;
+        uint32_t lo;
+        uint32_t hi;
+    };
+
+    // Build in progress; the new tree goes to the m_pending* arrays until finish() swaps it in
+    bool m_building = false;
+    Phase m_phase = Phase::Collect;
+    std::vector<NodeRef> m_queue;
+    size_t m_cursor = 0;
+    std::vector<Item> m_pending;
+    size_t m_pendingBounded = 0;
+    size_t m_sampled = 0;
+    std::vector<Task> m_tasks;
+    LargeSplit m_large;
+    std::vector<Node> m_pendingNodes;
+    std::vector<uint32_t> m_pendingParents;
+    std::vector<uint32_t> m_pendingLeafOf;
+    uint32_t m_pendingDepth = 0;
+    Clock::time_point m_startTime;
+    float m_buildMs = 0.0f;
+    float m_treeMs = 0.0f;
+
+    // Refit
+    size_t m_refitCursor = 0;
+    float m_refitUs = 0.0f;
+    std::vector<UnityResolve::UnityType::Transform*> m_refitTransforms;
+    std::vector<uint32_t> m_refitItems;
+    TransformSoA m_sample; // also the Sample phase's scratch; refit() does not run during a build
+
+    bool collectBounds(const SceneArena& arena, Clock::time_point deadline);
+    bool samplePositions(Clock::time_point deadline);
+    bool buildTree(Clock::time_point deadline);
+    void split(const Task& task);
+    bool advanceLargeSplit();
+    // Median of a few evenly spaced centers of the range, or `fallback` if none is a number
+    float sampleMedian(const Task& task, int axis, float fallback) const;
+    // Longest axis of the centers; false if the node becomes a leaf instead
+    bool chooseAxis(const Task& task, const Aabb& centers, int& axis);
+    void addChildren(const Task& task, uint32_t half);
+    void finish();
+    // Move the boxes of the items in m_refitItems to their positions in m_sample
+    size_t refitSampled();
+    bool collect(const SceneArena& arena, uint32_t index, Item& item);
+    template <typename Test> void query(const float center[3], Test&& test, std::vector<Hit>& out) const;
+};
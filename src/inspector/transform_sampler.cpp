@@ -0,0 +1,205 @@
+﻿#include "pch.h"
+#include "transform_sampler.h"
+#include "native_object.h"
+
+#include <chrono>
+
+namespace
+{
+    using Vector3 = UnityResolve::UnityType::Vector3;
+    using Quaternion = UnityResolve::UnityType::Quaternion;
+
+    // Icall naming differs between Unity versions: *_Injected taking the managed object (2018.3+),
+    // *_Injected taking the native pointer (Unity 6) and INTERNAL_get_* (before 2018.3)
+    void* resolveGetter(const std::string& property, const char* valueType, bool* nativeSelf)
+    {
+        auto transformClass = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Transform");
+        if (!transformClass) return nullptr;
+
+        const std::string injected = "get_" + property + "_Injected";
+        const std::string legacy = "INTERNAL_get_" + property;
+
+        struct Candidate
+        {
+            std::string signature;
+            const std::string& methodName;
+            bool nativeSelf;
+        };
+        const Candidate candidates[] = {
+            {"UnityEngine.Transform::" + injected + "(" + valueType + "&)", injected, false},
+            {"UnityEngine.Transform::" + injected + "(System.IntPtr," + valueType + "&)", injected, true},
+            {"UnityEngine.Transform::" + legacy + "(" + valueType + "&)", legacy, false},
+        };
+
+        for (const Candidate& candidate : candidates)
+        {
+            auto method = transformClass->Get<UnityResolve::Method>(candidate.methodName);
+            if (!methods::Runtime::IsIl2Cpp() && !method) continue;
+
+            // Mono resolves through the MethodInfo, so the parameter list tells which variant it is
+            if (!methods::Runtime::IsIl2Cpp() && (method->args.size() == 2) != candidate.nativeSelf) continue;
+
+            if (void* function = methods::Runtime::ResolveICall(candidate.signature.c_str(), method))
+            {
+                *nativeSelf = candidate.nativeSelf;
+                return function;
+            }
+        }
+        return nullptr;
+    }
+
+    Vector3 invokeVector3(UnityResolve::UnityType::Transform* transform, TransformSampler::Space space, int field)
+    {
+        const bool world = space == TransformSampler::Space::World;
+        if (field == 0) return world ? transform->GetPosition() : transform->GetLocalPosition();
+        return world ? methods::Transform::GetLossyScale(transform) : transform->GetLocalScale();
+    }
+
+    Quaternion invokeRotation(UnityResolve::UnityType::Transform* transform, TransformSampler::Space space)
+    {
+        return space == TransformSampler::Space::World ? transform->GetRotation() : transform->GetLocalRotation();
+    }
+}
+
+TransformSampler& TransformSampler::getInstance()
+{
+    static TransformSampler instance;
+    return instance;
+}
+
+void TransformSampler::resolve()
+{
+    try
+    {
+        bool nativeSelf = false;
+        m_world.position = reinterpret_cast<GetVector3_t>(resolveGetter("position", "UnityEngine.Vector3",
+                                                                        &nativeSelf));
+        m_world.rotation = reinterpret_cast<GetQuaternion_t>(resolveGetter("rotation", "UnityEngine.Quaternion",
+                                                                           &nativeSelf));
+        m_world.scale = reinterpret_cast<GetVector3_t>(resolveGetter("lossyScale", "UnityEngine.Vector3",
+                                                                     &nativeSelf));
+        m_local.position = reinterpret_cast<GetVector3_t>(resolveGetter("localPosition", "UnityEngine.Vector3",
+                                                                        &nativeSelf));
+        m_local.rotation = reinterpret_cast<GetQuaternion_t>(resolveGetter("localRotation", "UnityEngine.Quaternion",
+                                                                           &nativeSelf));
+        m_local.scale = reinterpret_cast<GetVector3_t>(resolveGetter("localScale", "UnityEngine.Vector3",
+                                                                     &nativeSelf));
+        m_nativeSelf = nativeSelf;
+    }
+    catch (...)
+    {
+        m_world = {};
+        m_local = {};
+    }
+
+    const bool complete = m_world.position && m_world.rotation && m_world.scale && m_local.position &&
+        m_local.rotation && m_local.scale;
+    m_path = complete ? Path::ICall : Path::Invoke;
+    LOG_INFO("[TransformSampler] Using %s path%s", getPathName(m_path),
+             complete ? "" : " (some Transform icalls could not be resolved)");
+}
+
+void TransformSampler::sample(UnityResolve::UnityType::Transform* const* transforms, size_t count, Space space,
+                              TransformSoA& out)
+{
+    if (m_path == Path::None) resolve();
+
+    out.resize(count);
+    const Getters& getters = space == Space::World ? m_world : m_local;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto* transform = transforms[i];
+        Vector3& position = out.positions[i];
+        Quaternion& rotation = out.rotations[i];
+        Vector3& scale = out.scales[i];
+        position = Vector3();
+        rotation = Quaternion();
+        scale = Vector3(1.0f, 1.0f, 1.0f);
+
+        // The icalls do not check for destroyed objects the way the managed wrappers do
+        void* native = NativeObjectLayout::getCachedPtr(transform);
+        if (!transform || !native) continue;
+        void* self = m_nativeSelf ? native : transform;
+
+        try
+        {
+            if (getters.position) getters.position(self, &position);
+            else position = invokeVector3(transform, space, 0);
+
+            if (getters.rotation) getters.rotation(self, &rotation);
+            else rotation = invokeRotation(transform, space);
+
+            if (getters.scale) getters.scale(self, &scale);
+            else scale = invokeVector3(transform, space, 1);
+        }
+        catch (...)
+        {
+            // Leave identity values for this transform
+        }
+    }
+}
+
+void TransformSampler::sampleInvoke(UnityResolve::UnityType::Transform* const* transforms, size_t count,
+                                    Space space, TransformSoA& out)
+{
+    out.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto* transform = transforms[i];
+        if (!transform || !NativeObjectLayout::getCachedPtr(transform)) continue;
+
+        try
+        {
+            out.positions[i] = invokeVector3(transform, space, 0);
+            out.rotations[i] = invokeRotation(transform, space);
+            out.scales[i] = invokeVector3(transform, space, 1);
+        }
+        catch (...)
+        {
+        }
+    }
+}
+
+TransformSampler::Comparison TransformSampler::compare(UnityResolve::UnityType::Transform* const* transforms,
+                                                       size_t count)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Comparison result;
+    result.count = count;
+    if (count == 0) return result;
+
+    TransformSoA soa;
+    sample(transforms, count, Space::World, soa); // warm up: resolves icalls and the Invoke method cache
+    sampleInvoke(transforms, count, Space::World, soa);
+
+    auto start = Clock::now();
+    sample(transforms, count, Space::World, soa);
+    auto bulkTime = Clock::now() - start;
+
+    start = Clock::now();
+    sampleInvoke(transforms, count, Space::World, soa);
+    auto invokeTime = Clock::now() - start;
+
+    result.bulkNsPerObject = std::chrono::duration<double, std::nano>(bulkTime).count() / count;
+    result.invokeNsPerObject = std::chrono::duration<double, std::nano>(invokeTime).count() / count;
+    result.path = m_path;
+
+    LOG_INFO("[TransformSampler] %zu transforms: bulk (%s) %.0f ns/object, Invoke %.0f ns/object, %.1fx",
+             count, getPathName(result.path), result.bulkNsPerObject, result.invokeNsPerObject, result.speedup());
+    return result;
+}
+
+const char* TransformSampler::getPathName(Path path)
+{
+    switch (path)
+    {
+    case Path::ICall:
+        return "icall";
+    case Path::Invoke:
+        return "Invoke";
+    default:
+        return "none";
+    }
+}
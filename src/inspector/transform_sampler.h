@@ -0,0 +1,85 @@
+﻿#pragma once
+
+#include <vector>
+
+// Structure-of-arrays transform data, one entry per sampled Transform
+struct TransformSoA
+{
+    std::vector<UnityResolve::UnityType::Vector3> positions;
+    std::vector<UnityResolve::UnityType::Quaternion> rotations;
+    std::vector<UnityResolve::UnityType::Vector3> scales;
+
+    void resize(size_t count)
+    {
+        positions.resize(count);
+        rotations.resize(count);
+        scales.resize(count);
+    }
+
+    size_t size() const { return positions.size(); }
+};
+
+// Reads position, rotation and scale of many transforms in one pass. The Transform getters are called through
+// their native internal-call entry points, which skips the managed wrapper and the per-call method dispatch
+// of UnityResolve::Method::Invoke. If an icall cannot be resolved, that getter falls back to Invoke.
+class TransformSampler
+{
+public:
+    enum class Space
+    {
+        World, // position, rotation, lossyScale
+        Local, // localPosition, localRotation, localScale
+    };
+
+    enum class Path
+    {
+        None,
+        ICall,
+        Invoke,
+    };
+
+    struct Comparison
+    {
+        size_t count = 0;
+        double bulkNsPerObject = 0.0;
+        double invokeNsPerObject = 0.0;
+        Path path = Path::None;
+
+        double speedup() const { return bulkNsPerObject > 0.0 ? invokeNsPerObject / bulkNsPerObject : 0.0; }
+    };
+
+    static TransformSampler& getInstance();
+
+    // Fill `out` with one entry per transform. Null or destroyed transforms produce identity values.
+    void sample(UnityResolve::UnityType::Transform* const* transforms, size_t count, Space space, TransformSoA& out);
+
+    // Time the bulk path against one Invoke per getter per object over the same transforms
+    Comparison compare(UnityResolve::UnityType::Transform* const* transforms, size_t count);
+
+    Path getPath() const { return m_path; }
+    static const char* getPathName(Path path);
+
+private:
+    using Vector3 = UnityResolve::UnityType::Vector3;
+    using Quaternion = UnityResolve::UnityType::Quaternion;
+    using GetVector3_t = void (*)(void*, Vector3*);
+    using GetQuaternion_t = void (*)(void*, Quaternion*);
+
+    struct Getters
+    {
+        GetVector3_t position = nullptr;
+        GetQuaternion_t rotation = nullptr;
+        GetVector3_t scale = nullptr;
+    };
+
+    TransformSampler() = default;
+
+    Getters m_world;
+    Getters m_local;
+    Path m_path = Path::None;
+    bool m_nativeSelf = false; // Unity 6 icalls take the native object instead of the managed one
+
+    void resolve();
+    static void sampleInvoke(UnityResolve::UnityType::Transform* const* transforms, size_t count, Space space,
+                             TransformSoA& out);
+};
@@ -3,6 +3,80 @@
 #include "../ui/language.h"
 #include "methods/method_helpers.h"
 
+namespace
+{
+    // Inspector sections, as keys of the property sampler
+    constexpr const char* kGameObjectPanel = "GameObject";
+    constexpr const char* kTransformPanel = "Transform";
+    constexpr const char* kEnabledPanel = "Enabled";
+    constexpr const char* kCameraPanel = "Camera";
+    constexpr const char* kRendererPanel = "Renderer";
+    constexpr const char* kRigidbodyPanel = "Rigidbody";
+    constexpr const char* kColliderPanel = "Collider";
+
+    // Values of each section as of the last sample
+    struct GameObjectValues
+    {
+        std::string name;
+        std::string tag;
+        bool activeSelf;
+        bool activeInHierarchy;
+        bool isStatic;
+    };
+
+    struct TransformValues
+    {
+        UnityResolve::UnityType::Vector3 position;
+        UnityResolve::UnityType::Quaternion rotation;
+        UnityResolve::UnityType::Vector3 eulerAngles;
+        UnityResolve::UnityType::Vector3 scale;
+        UnityResolve::UnityType::Vector3 localPosition;
+        UnityResolve::UnityType::Quaternion localRotation;
+        UnityResolve::UnityType::Vector3 localEulerAngles;
+        UnityResolve::UnityType::Vector3 localScale;
+        int childCount;
+        bool hasParent;
+        std::string parentName; // empty if the parent has no GameObject
+    };
+
+    struct CameraValues
+    {
+        float fov;
+        float depth;
+    };
+
+    struct RigidbodyValues
+    {
+        UnityResolve::UnityType::Vector3 velocity;
+        bool detectCollisions;
+    };
+
+    // Element type a watch reads for a field, Unknown if it is not a number
+    methods::TypeCode watchCode(const FieldLayouts::Field& field)
+    {
+        using Kind = FieldLayouts::Kind;
+        using methods::TypeCode;
+        static constexpr TypeCode kSigned[] = {TypeCode::I1, TypeCode::I2, TypeCode::I4, TypeCode::I8};
+        static constexpr TypeCode kUnsigned[] = {TypeCode::U1, TypeCode::U2, TypeCode::U4, TypeCode::U8};
+        const int sizeIndex = field.size == 1 ? 0 : field.size == 2 ? 1 : field.size == 4 ? 2 : 3;
+
+        switch (field.kind)
+        {
+        case Kind::Bool: return TypeCode::Boolean;
+        case Kind::Char: return TypeCode::Char;
+        case Kind::Integer:
+        case Kind::Enum: return kSigned[sizeIndex];
+        case Kind::Unsigned: return kUnsigned[sizeIndex];
+        case Kind::Float:
+        case Kind::Vector2:
+        case Kind::Vector3:
+        case Kind::Vector4: return TypeCode::R4;
+        case Kind::Double: return TypeCode::R8;
+        default: return TypeCode::Unknown;
+        }
+    }
+}
+
 bool UnityExplorer::initialize()
 {
     if (m_initialized)
@@ -26,8 +100,20 @@ bool UnityExplorer::initialize()
         LOG_INFO("[UnityExplorer] Found UnityEngine.CoreModule.dll");
 
         // Initialize component expanded states
-        m_componentExpandedState["Transform"] = true;
-        m_componentExpandedState["GameObject"] = true;
+        m_expandedState.assign(2, 0);
+        m_expandedState[ComponentCache::kGameObjectState] = 1;
+        m_expandedState[ComponentCache::kTransformState] = 1;
+
+        // Scene loads/unloads invalidate the tree; without the hooks only polling picks them up
+        SceneEvents::getInstance().install();
+
+        // Watches are sampled and edits written on the game thread when possible, from update() otherwise
+        if (GameTick::getInstance().install())
+        {
+            GameTick::getInstance().add(&WatchList::onTick, &m_watches);
+            GameTick::getInstance().add(&EditQueue::onTick, &m_edits);
+            GameTick::getInstance().add(&ChangeTracker::onTick, &m_changes);
+        }
 
         m_initialized = true;
         refreshScene();
@@ -62,31 +148,146 @@ void UnityExplorer::update()
         m_lastRefreshTime = currentTime;
     }
 
-    if (m_needsRefresh)
+    if (SceneEvents::getInstance().isInstalled())
+    {
+        processSceneEvents();
+    }
+
+    if (m_liveTracking)
+    {
+        processObjectChanges();
+    }
+
+    pruneDeadNodes();
+
+    if (m_needsRefresh || (!m_dirtyScenes.empty() && !m_builder.isRunning()))
     {
         refreshScene();
-        m_needsRefresh = false;
+    }
+
+    // The time-sliced jobs share one budget per frame; each gets what the ones before it left
+    m_frameDeadline = std::chrono::steady_clock::now() + std::chrono::microseconds(m_refreshBudgetUs);
+    uint32_t budgetUs = 0;
+
+    // Advance the time-sliced scan; the previous snapshot stays visible until it commits
+    if (m_builder.isRunning() && remainingBudget(budgetUs) && m_builder.step(m_scene, budgetUs))
+    {
+        onRefreshCommitted();
+    }
+
+    // Value search results stream in a slice at a time, whether or not its window is open
+    if (m_valueSearch.isRunning() && remainingBudget(budgetUs))
+    {
+        m_valueSearch.step(m_scene, budgetUs);
+    }
+
+    // Filter queries read properties through managed calls, so they run in slices too
+    if (m_view.filter().isRunning() && remainingBudget(budgetUs))
+    {
+        m_view.stepFilter(m_scene, budgetUs);
     }
 
     if (m_showSceneExplorer)
     {
         renderSceneExplorer();
+        loadExpandedNodes();
+    }
+
+    if (m_showValueSearch)
+    {
+        renderValueSearch();
+    }
+
+    if (m_spatial.isBuilding())
+    {
+        if (remainingBudget(budgetUs)) m_spatial.step(m_scene, budgetUs);
+    }
+    else if (m_showSpatialQuery && m_spatialTracking && remainingBudget(budgetUs))
+    {
+        m_spatial.refit(m_scene, kRefitPerFrame, budgetUs);
+    }
+
+    if (m_showSpatialQuery)
+    {
+        renderSpatialQuery();
+        if (m_pickInGameView) pickInGameView();
+    }
+
+    if (!GameTick::getInstance().isInstalled())
+    {
+        m_watches.sample();
+    }
+    m_edits.collect();
+    m_watches.drain();
+
+    if (m_showWatchList)
+    {
+        renderWatchList();
+    }
+
+    if (!GameTick::getInstance().isInstalled() && m_changes.trackedCount() > 0)
+    {
+        m_changes.tick(currentFrame());
     }
+    ChangeTracker::Hit hit;
+    if (m_changes.drain(hit)) showBreak(hit);
 
-    if (m_showObjectInspector && m_selectedObject)
+    if (m_showFieldChanges)
     {
+        renderFieldChanges();
+    }
+
+    if (m_showEditJournal)
+    {
+        renderEditJournal();
+    }
+
+    if (m_showObjectInspector && hasSelection())
+    {
+        m_sampler.tick();
         renderObjectInspector();
     }
 }
 
+bool UnityExplorer::remainingBudget(uint32_t& budgetUs) const
+{
+    if (m_refreshBudgetUs <= 0)
+    {
+        budgetUs = 0; // unbounded: every job finishes this frame
+        return true;
+    }
+    const auto left = std::chrono::duration_cast<std::chrono::microseconds>(m_frameDeadline -
+                                                                            std::chrono::steady_clock::now()).count();
+    if (left <= 0) return false;
+    budgetUs = static_cast<uint32_t>(left);
+    return true;
+}
+
 void UnityExplorer::shutdown()
 {
     LOG_INFO("[UnityExplorer] Shutting down...");
 
-    m_rootObjects.clear();
-    m_objectCache.clear();
-    m_selectedObject = nullptr;
-    m_componentExpandedState.clear();
+    SceneEvents::getInstance().uninstall();
+    ObjectRegistry::getInstance().uninstall();
+    GameTick::getInstance().remove(&WatchList::onTick, &m_watches);
+    GameTick::getInstance().remove(&EditQueue::onTick, &m_edits);
+    GameTick::getInstance().remove(&ChangeTracker::onTick, &m_changes);
+    GameTick::getInstance().uninstall();
+    m_watches.clear();
+    m_edits.collect();
+    m_edits.clearJournal();
+    m_changes.resume();
+    m_changes.clear();
+    m_liveTracking = false;
+    m_builder.cancel();
+    m_valueSearch.cancel();
+    m_spatial.cancel();
+    m_scene.clear();
+    m_selection = {};
+    m_pendingExpand.clear();
+    m_dirtyScenes.clear();
+    m_lastRefreshStats = {};
+    m_expandedState.clear();
     m_initialized = false;
 }
 
@@ -107,6 +308,24 @@ void UnityExplorer::renderSceneExplorer()
         {
             ImGui::MenuItem("Show Inactive Objects", nullptr, &m_showInactiveObjects);
             ImGui::MenuItem("Auto Refresh", nullptr, &m_autoRefresh);
+            if (ImGui::MenuItem("Lazy Hierarchy", nullptr, m_lazyHierarchy))
+            {
+                setLazyHierarchy(!m_lazyHierarchy);
+            }
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("Scan scene roots only and load children on expand.\n"
+                                  "Objects in DontDestroyOnLoad are not listed in this mode.");
+            }
+            if (ImGui::MenuItem("Live Object Tracking", nullptr, m_liveTracking))
+            {
+                setLiveTracking(!m_liveTracking);
+            }
+            ImGui::MenuItem("Value Search", nullptr, &m_showValueSearch);
+            ImGui::MenuItem("Spatial Query", nullptr, &m_showSpatialQuery);
+            ImGui::MenuItem("Watch List", nullptr, &m_showWatchList);
+            ImGui::MenuItem("Field Changes", nullptr, &m_showFieldChanges);
+            ImGui::MenuItem("Edit Journal", nullptr, &m_showEditJournal);
             ImGui::Separator();
             if (ImGui::MenuItem("Refresh Scene", "F5"))
             {
@@ -118,9 +337,96 @@ void UnityExplorer::renderSceneExplorer()
         if (ImGui::BeginMenu("Options"))
         {
             ImGui::MenuItem("Expand All", nullptr, false, false); // TODO: Implement
-            ImGui::MenuItem("Collapse All", nullptr, false, false); // TODO: Implement
+            if (ImGui::MenuItem("Collapse All"))
+            {
+                m_view.collapseAll();
+            }
             ImGui::Separator();
             ImGui::MenuItem("Copy Object Path", nullptr, false, false); // TODO: Implement
+            ImGui::Separator();
+            ImGui::SetNextItemWidth(150.0f);
+            ImGui::SliderInt("Refresh Budget (us)", &m_refreshBudgetUs, 0, 16000);
+            ImGui::SameLine();
+            helpMarker("Maximum time spent per frame on scene scans, value searches and spatial index builds "
+                       "together. 0 finishes each in one frame.");
+            int sampleRate = m_sampler.getRate();
+            ImGui::SetNextItemWidth(150.0f);
+            if (ImGui::SliderInt("Inspector Rate (Hz)", &sampleRate, 0, 60))
+            {
+                m_sampler.setRate(sampleRate);
+            }
+            ImGui::SameLine();
+            helpMarker("How often the Object Inspector reads property values from the game. 0 reads them every frame.");
+            bool zeroAlloc = m_builder.isZeroAlloc();
+            if (ImGui::Checkbox("Zero-GC Scan", &zeroAlloc))
+            {
+                m_builder.setZeroAlloc(zeroAlloc);
+            }
+            ImGui::SameLine();
+            helpMarker("Rescan by walking known objects and reading names from native memory, so refreshes do not "
+                       "allocate managed memory. New root objects are only found on scene loads or with "
+                       "live tracking.");
+            ImGui::Separator();
+            if (ImGui::MenuItem("Benchmark Transform Sampler"))
+            {
+                benchmarkTransformSampler();
+            }
+            if (m_samplerComparison.count > 0)
+            {
+                ImGui::TextDisabled("%zu transforms: %s %.0f ns, Invoke %.0f ns (%.1fx)", m_samplerComparison.count,
+                                    TransformSampler::getPathName(m_samplerComparison.path),
+                                    m_samplerComparison.bulkNsPerObject, m_samplerComparison.invokeNsPerObject,
+                                    m_samplerComparison.speedup());
+            }
+            if (ImGui::MenuItem("Benchmark Search", nullptr, false, !m_searchFilter.empty()))
+            {
+                benchmarkSearch();
+            }
+            if (m_searchComparison.objects > 0)
+            {
+                ImGui::TextDisabled("\"%s\" in %zu objects (%zu): matchesFilter %.2f ms, index %.3f ms (%.0fx)",
+                                    m_searchComparison.query.c_str(), m_searchComparison.objects,
+                                    m_searchComparison.matches, m_searchComparison.linearMs,
+                                    m_searchComparison.indexedMs, m_searchComparison.speedup());
+            }
+            ImGui::EndMenu();
+        }
+
+        if (ImGui::BeginMenu("Snapshot"))
+        {
+            if (ImGui::MenuItem("Save Snapshot", nullptr, false, m_scene.liveCount() > 0 && !m_builder.isRunning()))
+            {
+                saveSnapshot();
+            }
+            if (ImGui::MenuItem("Set Baseline", nullptr, false, m_scene.liveCount() > 0 && !m_builder.isRunning()))
+            {
+                setBaseline();
+            }
+            if (ImGui::MenuItem("Compare with Baseline", nullptr, false,
+                                !m_baseline.nodes.empty() && !m_builder.isRunning()))
+            {
+                compareWithBaseline();
+            }
+            ImGui::MenuItem("Show Changes", nullptr, &m_showChanges, !m_baseline.nodes.empty());
+            ImGui::Separator();
+            ImGui::MenuItem("Compress (LZ4)", nullptr, &m_snapshotOptions.compress);
+            ImGui::MenuItem("Include Components", nullptr, &m_snapshotOptions.components);
+            ImGui::MenuItem("Include Transforms", nullptr, &m_snapshotOptions.transforms);
+            if (!m_lastSnapshot.path.empty())
+            {
+                ImGui::Separator();
+                if (m_lastSnapshot.success)
+                {
+                    ImGui::TextDisabled("%zu %s, %.1f KB, %.1f ms", m_lastSnapshot.nodes, LANG("Objects"),
+                                        m_lastSnapshot.bytes / 1024.0, m_lastSnapshot.elapsedMs);
+                    ImGui::TextDisabled("%s", m_lastSnapshot.path.c_str());
+                }
+                else
+                {
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s: %s", LANG("Error"),
+                                       m_lastSnapshot.error.c_str());
+                }
+            }
             ImGui::EndMenu();
         }
 
@@ -173,45 +479,86 @@ void UnityExplorer::renderSceneExplorer()
             ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), LANG("● Auto-refresh: OFF"));
         }
 
+    ImGui::SameLine();
+    ImGui::Separator();
+    ImGui::SameLine();
+    renderRefreshStatus();
+
     ImGui::EndChild();
 
     // Search filter with better styling
     ImGui::Spacing();
             ImGui::Text("%s:", LANG("Search Objects"));
     ImGui::SameLine();
-    helpMarker("Filter objects by name. Supports partial matches.");
+    helpMarker("Filter objects by name. Supports partial matches.\n\n"
+               "Queries combine terms that must all hold:\n"
+               "  component:Rigidbody   tag:Enemy   layer:8 or layer:Water\n"
+               "  active:true   name~/Boss\\d+/   id:12345   0x1A2B3C (address)\n"
+               "A leading '-' negates a term; other words match names.\n\n"
+               "Fuzzy: characters in order with gaps allowed (EnmySpwnr finds EnemySpawner), best matches first.");
+    ImGui::SameLine();
+    ImGui::Checkbox(LANG("Fuzzy"), &m_fuzzySearch);
 
     ImGui::SetNextItemWidth(-1);
     if (ImGui::InputTextWithHint("##search", "Enter object name to filter...", m_searchBuffer, sizeof(m_searchBuffer)))
     {
         m_searchFilter = std::string(m_searchBuffer);
     }
+    if (m_view.filter().isQuery() && !m_view.filter().getQueryError().empty())
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s: %s", LANG("Error"),
+                           m_view.filter().getQueryError().c_str());
+    }
 
     ImGui::Spacing();
 
     // Statistics bar
     ImGui::BeginChild("Stats", ImVec2(0, 30), true);
-            ImGui::Text("%s: %zu", LANG("Root Objects"), m_rootObjects.size());
+            ImGui::Text("%s: %zu", LANG("Root Objects"), m_scene.rootCount());
+    ImGui::SameLine();
+    ImGui::Separator();
+    ImGui::SameLine();
+            ImGui::Text("%s: %s", LANG("Selected"),
+                        hasSelection() ? m_scene.names().c_str(m_scene[selectedNode()].nameId) : LANG("None"));
     ImGui::SameLine();
     ImGui::Separator();
     ImGui::SameLine();
-            ImGui::Text("%s: %s", LANG("Selected"), m_selectedObject ? m_selectedObject->name.c_str() : LANG("None"));
+    if (m_view.filter().isRunning())
+        ImGui::Text("%s: %s", LANG("Filtered"), LANG("Searching..."));
+    else if (m_view.filter().isActive())
+        ImGui::Text("%s: %zu %s", LANG("Filtered"), m_view.filter().matchCount(), LANG("Matches"));
+    else
+        ImGui::Text("%s: %s", LANG("Filtered"), LANG("All"));
     ImGui::SameLine();
     ImGui::Separator();
     ImGui::SameLine();
-            ImGui::Text("%s: %s", LANG("Filtered"), m_searchFilter.empty() ? LANG("All") : LANG("Filtered"));
+    ImGui::Text("%s: %zu (+%zu -%zu ~%zu)", LANG("Changed"), m_lastRefreshStats.changed(), m_lastRefreshStats.added,
+                m_lastRefreshStats.removed, m_lastRefreshStats.reparented);
+    if (m_liveTracking)
+    {
+        const auto liveStats = ObjectRegistry::getInstance().getStats();
+        ImGui::SameLine();
+        ImGui::Separator();
+        ImGui::SameLine();
+        ImGui::Text("%s: +%zu -%zu", LANG("Live"), liveStats.created, liveStats.destroyed);
+    }
     ImGui::EndChild();
 
     ImGui::Spacing();
 
+    if (m_showChanges && !m_baseline.nodes.empty()) renderChangeView();
+
     // Hierarchy tree with better styling
             ImGui::Text("%s:", LANG("Scene Hierarchy"));
     ImGui::SameLine();
     helpMarker("Click objects to select them. Double-click to expand/collapse.");
 
-    ImGui::BeginChild("Hierarchy", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
+    // Fuzzy results are ranked in their own list, so the tree beside them stays unfiltered
+    const bool fuzzy = m_fuzzySearch && !m_searchFilter.empty() && !SceneQuery::isStructured(m_searchFilter);
+    const float treeWidth = fuzzy ? ImGui::GetContentRegionAvail().x * 0.5f : 0.0f;
+    ImGui::BeginChild("Hierarchy", ImVec2(treeWidth, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
 
-    if (m_rootObjects.empty())
+    if (m_scene.rootCount() == 0)
     {
         ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 50);
                     ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), LANG("No objects found in scene"));
@@ -219,56 +566,349 @@ void UnityExplorer::renderSceneExplorer()
     }
     else
     {
-        for (auto& rootObj : m_rootObjects)
+        m_view.setFilter(fuzzy ? std::string() : m_searchFilter, m_showInactiveObjects);
+        m_view.update(m_scene, m_pendingExpand);
+
+        // Only the rows inside the scrolled region are submitted
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_view.size()));
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                renderGameObjectNode(m_view.rows()[row]);
+            }
+        }
+    }
+
+    ImGui::EndChild();
+
+    if (fuzzy)
+    {
+        ImGui::SameLine();
+        renderFuzzyResults();
+    }
+    ImGui::End();
+}
+
+void UnityExplorer::renderFuzzyResults()
+{
+    m_fuzzy.update(m_scene, m_searchFilter);
+
+    ImGui::BeginChild("FuzzyResults", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
+    ImGui::TextDisabled("%zu %s, %.2f ms", m_fuzzy.matchCount(), LANG("Matches"), m_fuzzy.getLastMs());
+    if (m_fuzzy.matchCount() > m_fuzzy.results().size())
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(%s %zu)", LANG("showing"), m_fuzzy.results().size());
+    }
+    ImGui::Separator();
+
+    const auto& results = m_fuzzy.results();
+    const uint32_t selected = selectedNode();
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(results.size()));
+    while (clipper.Step())
+    {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
         {
-            if (!rootObj) continue;
+            const uint32_t index = results[row].index;
+            if (!m_scene[index].isLinked()) continue; // removed since the last ranking
 
-            // Apply search filter
-            if (!m_searchFilter.empty() && !matchesFilter(rootObj->name, m_searchFilter))
+            const SceneNode& node = m_scene[index];
+            ImGui::PushID(static_cast<int>(index));
+            if (!node.isActive()) ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
+            if (ImGui::Selectable(m_scene.names().c_str(node.nameId), index == selected))
             {
-                continue;
+                selectFromResults(m_scene.ref(index));
             }
+            if (!node.isActive()) ImGui::PopStyleColor();
+            ImGui::SameLine();
+            ImGui::TextDisabled("%d", results[row].score);
+            ImGui::PopID();
+        }
+    }
+    ImGui::EndChild();
+}
+
+void UnityExplorer::renderValueSearch()
+{
+    ImGui::SetNextWindowSize(ImVec2(460, 380), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Value Search", &m_showValueSearch))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("%s:", LANG("Expression"));
+    ImGui::SameLine();
+    helpMarker("Find objects by component data: Component.member[.member...] followed by\n"
+               "<, <=, >, >=, == or != and a number, true or false.\n\n"
+               "  Health.currentHealth < 10\n"
+               "  Rigidbody.velocity.magnitude > 50\n"
+               "  Light.enabled == false\n\n"
+               "The component may be named by a base class. Runs a slice per frame within the refresh budget.");
+
+    ImGui::SetNextItemWidth(-80.0f);
+    const bool submitted = ImGui::InputTextWithHint("##valueSearch", "Health.currentHealth < 10",
+                                                    m_valueSearchBuffer, sizeof(m_valueSearchBuffer),
+                                                    ImGuiInputTextFlags_EnterReturnsTrue);
+    ImGui::SameLine();
+    if (m_valueSearch.isRunning())
+    {
+        if (ImGui::Button(LANG("Cancel"), ImVec2(-1, 0))) m_valueSearch.cancel();
+    }
+    else if (ImGui::Button(LANG("Search"), ImVec2(-1, 0)) || submitted)
+    {
+        m_valueSearch.begin(m_scene, m_valueSearchBuffer);
+    }
 
-            // Skip inactive objects if not showing them
-            if (!m_showInactiveObjects && !rootObj->isActive)
+    if (m_valueSearch.isRunning())
+    {
+        char overlay[64];
+        sprintf_s(overlay, sizeof(overlay), "%zu / %zu", m_valueSearch.getScanned(), m_valueSearch.getQueued());
+        ImGui::ProgressBar(m_valueSearch.getProgress(), ImVec2(-1, 0), overlay);
+    }
+    else if (m_valueSearch.getQueued() > 0)
+    {
+        ImGui::TextDisabled("%zu %s / %zu %s, %.1f ms / %d %s", m_valueSearch.matches().size(), LANG("Matches"),
+                            m_valueSearch.getQueued(), LANG("objects"), m_valueSearch.getElapsedMs(),
+                            m_valueSearch.getFrames(), LANG("frames"));
+    }
+    if (!m_valueSearch.getError().empty())
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s: %s", LANG("Error"),
+                           m_valueSearch.getError().c_str());
+    }
+    ImGui::Separator();
+
+    // Matches so far; rows of objects removed since they matched are skipped
+    ImGui::BeginChild("ValueResults", ImVec2(0, 0), false);
+    const auto& matches = m_valueSearch.matches();
+    const uint32_t selected = selectedNode();
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(matches.size()));
+    while (clipper.Step())
+    {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+        {
+            const uint32_t index = m_scene.resolve(matches[row].node);
+            if (index == SceneArena::kInvalid) continue;
+
+            ImGui::PushID(row);
+            if (ImGui::Selectable(m_scene.names().c_str(m_scene[index].nameId), index == selected))
             {
-                continue;
+                selectFromResults(matches[row].node);
             }
+            ImGui::SameLine();
+            ImGui::TextDisabled("%g", matches[row].value);
+            ImGui::PopID();
+        }
+    }
+    ImGui::EndChild();
+    ImGui::End();
+}
+
+void UnityExplorer::renderSpatialQuery()
+{
+    ImGui::SetNextWindowSize(ImVec2(460, 460), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Spatial Query", &m_showSpatialQuery))
+    {
+        ImGui::End();
+        return;
+    }
+
+    if (m_spatial.isBuilding())
+    {
+        const bool collecting = m_spatial.getPhase() == SpatialIndex::Phase::Collect;
+        ImGui::ProgressBar(m_spatial.getProgress(), ImVec2(-1, 0),
+                           collecting ? LANG("Collecting bounds...") : LANG("Building tree..."));
+    }
+    else
+    {
+        if (ImGui::Button(m_spatial.isBuilt() ? LANG("Rebuild Index") : LANG("Build Index")))
+        {
+            m_spatial.begin(m_scene);
+        }
+        ImGui::SameLine();
+        helpMarker("Collects Renderer or Collider bounds (else the position) of every object in the tree.\n"
+                   "Runs a slice per frame within the refresh budget. Moving objects are refit within the same\n"
+                   "budget while this window is open; rotation and scale changes need a rebuild.");
+        if (m_spatial.isBuilt())
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled("%zu %s (%zu %s), %zu %s, %.1f ms", m_spatial.size(), LANG("objects"),
+                                m_spatial.boundedCount(), LANG("with bounds"), m_spatial.nodeCount(), LANG("nodes"),
+                                m_spatial.getBuildMs());
+        }
+    }
+    ImGui::Checkbox(LANG("Track Movement"), &m_spatialTracking);
+    if (m_spatialTracking && m_spatial.isBuilt())
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("%s %.0f us / %u", LANG("Refit"), m_spatial.getRefitUs(), kRefitPerFrame);
+    }
+    ImGui::Separator();
+
+    auto timed = [this](auto&& query)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        query();
+        m_spatialQueryUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    ImGui::SetNextItemWidth(160.0f);
+    ImGui::DragFloat(LANG("Radius"), &m_queryRadius, 0.5f, 0.0f, 100000.0f, "%.1f");
+    ImGui::SameLine();
+    SpatialIndex::Vector3 center;
+    if (ImGui::Button(LANG("Near Selection")) && hasSelection() && m_spatial.findCenter(m_selection, center))
+    {
+        timed([&] { m_spatial.queryRadius(center, m_queryRadius, m_spatialHits); });
+    }
 
-            renderGameObjectNode(rootObj);
+    ImGui::SetNextItemWidth(240.0f);
+    ImGui::InputFloat3(LANG("Min"), m_queryBoxMin, "%.1f");
+    ImGui::SetNextItemWidth(240.0f);
+    ImGui::InputFloat3(LANG("Max"), m_queryBoxMax, "%.1f");
+    ImGui::SameLine();
+    if (ImGui::Button(LANG("Inside Box")))
+    {
+        Aabb box;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            box.min[axis] = std::min(m_queryBoxMin[axis], m_queryBoxMax[axis]);
+            box.max[axis] = std::max(m_queryBoxMin[axis], m_queryBoxMax[axis]);
         }
+        timed([&] { m_spatial.queryBox(box, m_spatialHits); });
     }
 
+    ImGui::Checkbox(LANG("Pick in Game View"), &m_pickInGameView);
+    ImGui::SameLine();
+    helpMarker("Click anywhere outside the overlay to select the nearest object under the cursor,\n"
+               "tested against the indexed bounds from the main camera.");
+    ImGui::Separator();
+
+    ImGui::TextDisabled("%zu %s, %.1f us", m_spatialHits.size(), LANG("Matches"), m_spatialQueryUs);
+    ImGui::BeginChild("SpatialResults", ImVec2(0, 0), false);
+    const uint32_t selected = selectedNode();
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(m_spatialHits.size()));
+    while (clipper.Step())
+    {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+        {
+            const uint32_t index = m_scene.resolve(m_spatialHits[row].node);
+            if (index == SceneArena::kInvalid) continue;
+
+            ImGui::PushID(row);
+            if (ImGui::Selectable(m_scene.names().c_str(m_scene[index].nameId), index == selected))
+            {
+                selectFromResults(m_spatialHits[row].node);
+            }
+            ImGui::SameLine();
+            ImGui::TextDisabled("%.2f", m_spatialHits[row].distance);
+            ImGui::PopID();
+        }
+    }
     ImGui::EndChild();
     ImGui::End();
 }
 
-void UnityExplorer::renderGameObjectNode(std::shared_ptr<GameObjectNode> node)
+void UnityExplorer::pickInGameView()
+{
+    const ImGuiIO& io = ImGui::GetIO();
+    if (io.WantCaptureMouse || !ImGui::IsMouseClicked(ImGuiMouseButton_Left) || !m_spatial.isBuilt()) return;
+
+    try
+    {
+        auto camera = UnityResolve::UnityType::Camera::GetMain();
+        if (!camera)
+        {
+            LOG_WARNING("[UnityExplorer] Pick: no main camera");
+            return;
+        }
+
+        // Unity screen space starts at the bottom left and may differ in size from the overlay
+        const float width = static_cast<float>(methods::Screen::GetWidth());
+        const float height = static_cast<float>(methods::Screen::GetHeight());
+        const float x = io.DisplaySize.x > 0.0f ? io.MousePos.x * width / io.DisplaySize.x : io.MousePos.x;
+        const float y = io.DisplaySize.y > 0.0f ? height - io.MousePos.y * height / io.DisplaySize.y : io.MousePos.y;
+
+        const float nearClip = methods::Camera::GetNearClipPlane(camera);
+        const float farClip = methods::Camera::GetFarClipPlane(camera);
+        const auto from = camera->ScreenToWorldPoint(UnityResolve::UnityType::Vector3(x, y, nearClip));
+        const auto to = camera->ScreenToWorldPoint(UnityResolve::UnityType::Vector3(x, y, farClip));
+        const UnityResolve::UnityType::Vector3 direction(to.x - from.x, to.y - from.y, to.z - from.z);
+
+        SpatialIndex::Hit hit;
+        if (m_spatial.raycast(from, direction, hit))
+        {
+            selectFromResults(hit.node);
+            m_spatialHits.assign(1, hit);
+        }
+    }
+    catch (...)
+    {
+        LOG_ERROR("[UnityExplorer] Pick: failed to cast a ray from the main camera");
+    }
+}
+
+void UnityExplorer::selectFromResults(NodeRef node)
+{
+    const uint32_t index = m_scene.resolve(node);
+    if (index == SceneArena::kInvalid) return;
+
+    m_selection = node;
+    m_view.reveal(m_scene, index);
+}
+
+void UnityExplorer::renderRefreshStatus()
+{
+    if (m_builder.isRunning())
+    {
+        char overlay[64];
+        sprintf_s(overlay, sizeof(overlay), "%s %.0f%%", m_builder.getPhaseName(), m_builder.getProgress() * 100.0f);
+        ImGui::ProgressBar(m_builder.getProgress(), ImVec2(160, 0), overlay);
+    }
+    else
+    {
+        ImGui::TextDisabled("%s: %.1f ms / %d %s / %.1f KB GC", LANG("Last Scan"), m_lastRefreshStats.elapsedMs,
+                            m_lastRefreshStats.frames, LANG("frames"), m_lastRefreshStats.managedBytes / 1024.0f);
+    }
+}
+
+void UnityExplorer::renderGameObjectNode(const HierarchyView::Row& row)
 {
-    if (!node || !node->gameObject) return;
+    const uint32_t index = row.index;
+    const SceneNode& node = m_scene[index];
 
-    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick;
+    const char* name = m_scene.names().c_str(node.nameId);
+    const bool isSelected = selectedNode() == index;
+    const bool isExpanded = m_view.isExpanded(node, index);
 
-    if (node->children.empty())
+    // Rows are drawn flat, so the tree does not push; children get their indentation from the row depth
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick |
+        ImGuiTreeNodeFlags_NoTreePushOnOpen;
+
+    if (!node.mayHaveChildren())
     {
         flags |= ImGuiTreeNodeFlags_Leaf;
     }
 
-    if (m_selectedObject == node)
+    if (isSelected)
     {
         flags |= ImGuiTreeNodeFlags_Selected;
     }
 
     // Visual indicators for object state
-    std::string displayName = node->name;
-    std::string icon = "●"; // Default icon
+    const char* icon = "●"; // Default icon
 
     // Different icons based on object state
-    if (!node->isActive)
+    if (!node.isActive())
     {
         icon = "○"; // Inactive object
     }
-    else if (node->children.empty())
+    else if (!node.mayHaveChildren())
     {
         icon = "◆"; // Leaf object
     }
@@ -278,20 +918,26 @@ void UnityExplorer::renderGameObjectNode(std::shared_ptr<GameObjectNode> node)
     }
 
     // Color inactive objects differently
-    if (!node->isActive)
+    if (!node.isActive())
     {
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 0.6f, 0.6f, 1.0f));
     }
-    else if (m_selectedObject == node)
+    else if (isSelected)
     {
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8f, 0.8f, 1.0f, 1.0f));
     }
 
-    // Render the tree node with icon
-    bool nodeOpen = ImGui::TreeNodeEx(node.get(), flags, "%s %s", icon.c_str(), displayName.c_str());
+    const float indent = row.depth * (ImGui::GetStyle().IndentSpacing + 10.0f);
+    if (indent > 0.0f) ImGui::Indent(indent);
+
+    // Render the tree node with icon. The instance ID keeps the ImGui ID stable across slot reuse.
+    ImGui::SetNextItemOpen(isExpanded, ImGuiCond_Always);
+    bool nodeOpen = ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<intptr_t>(node.instanceId)), flags, "%s %s",
+                                      icon, name);
+    if (indent > 0.0f) ImGui::Unindent(indent);
 
     // Restore color
-    if (!node->isActive || m_selectedObject == node)
+    if (!node.isActive() || isSelected)
     {
         ImGui::PopStyleColor();
     }
@@ -299,14 +945,14 @@ void UnityExplorer::renderGameObjectNode(std::shared_ptr<GameObjectNode> node)
     // Handle selection
     if (ImGui::IsItemClicked())
     {
-        m_selectedObject = node;
-        LOG_INFO("[UnityExplorer] Selected object: %s", node->name.c_str());
+        m_selection = m_scene.ref(index);
+        LOG_INFO("[UnityExplorer] Selected object: %s", name);
     }
 
     // Context menu with better organization
     if (ImGui::BeginPopupContextItem())
     {
-        ImGui::Text("%s: %s", LANG("GameObject"), node->name.c_str());
+        ImGui::Text("%s: %s", LANG("GameObject"), name);
         ImGui::Separator();
 
         if (ImGui::MenuItem("Copy Name"))
@@ -329,33 +975,39 @@ void UnityExplorer::renderGameObjectNode(std::shared_ptr<GameObjectNode> node)
         ImGui::EndPopup();
     }
 
-    // Show children with better indentation
-    if (nodeOpen)
+    // The row list is rebuilt next frame; children of a lazily scanned node are fetched after the tree is
+    // drawn, so neither the rows nor the arena change mid-render
+    if (nodeOpen != isExpanded)
     {
-        ImGui::Indent(10.0f); // Add some indentation for children
-
-        for (auto& child : node->children)
+        m_view.setExpanded(node, index, nodeOpen);
+        if (nodeOpen && !(node.flags & SceneNode::ChildrenLoaded))
         {
-            if (!child) continue;
+            m_pendingExpand.push_back(index);
+        }
+    }
+}
 
-            // Apply search filter to children
-            if (!m_searchFilter.empty() && !matchesFilter(child->name, m_searchFilter))
-            {
-                continue;
-            }
+std::span<const ComponentRegistry::Entry> UnityExplorer::componentSections()
+{
+    using Entry = ComponentRegistry::Entry;
+
+    // Most derived first; anything not listed gets the generic field view
+    static constexpr Entry kSections[] = {
+        {"UnityEngine.CoreModule.dll", "Transform", nullptr}, // fixed section at the top
+        Entry::of<&UnityExplorer::renderCameraComponent>("UnityEngine.CoreModule.dll", "Camera"),
+        Entry::of<&UnityExplorer::renderRendererComponent>("UnityEngine.CoreModule.dll", "Renderer"),
+        Entry::of<&UnityExplorer::renderRigidbodyComponent>("UnityEngine.PhysicsModule.dll", "Rigidbody"),
+        Entry::of<&UnityExplorer::renderColliderComponent>("UnityEngine.PhysicsModule.dll", "Collider"),
+    };
+    return kSections;
+}
 
-            // Skip inactive children if not showing them
-            if (!m_showInactiveObjects && !child->isActive)
-            {
-                continue;
-            }
-
-            renderGameObjectNode(child);
-        }
-
-        ImGui::Unindent(10.0f);
-        ImGui::TreePop();
-    }
+bool UnityExplorer::sectionHeader(const char* label, uint32_t stateKey)
+{
+    if (stateKey >= m_expandedState.size()) m_expandedState.resize(stateKey + 1, 0);
+    const bool open = ImGui::CollapsingHeader(label, m_expandedState[stateKey] ? ImGuiTreeNodeFlags_DefaultOpen : 0);
+    m_expandedState[stateKey] = open;
+    return open;
 }
 
 void UnityExplorer::renderObjectInspector()
@@ -366,7 +1018,7 @@ void UnityExplorer::renderObjectInspector()
         return;
     }
 
-    if (!m_selectedObject || !m_selectedObject->gameObject)
+    if (!hasSelection() || !m_scene[selectedNode()].gameObject)
     {
         // Empty state with better styling
         ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 50);
@@ -376,14 +1028,29 @@ void UnityExplorer::renderObjectInspector()
         return;
     }
 
-    auto gameObject = m_selectedObject->gameObject;
-    auto transform = m_selectedObject->transform;
+    const SceneNode& selected = m_scene[selectedNode()];
+    auto gameObject = selected.gameObject;
+    auto transform = selected.transform;
 
     // Header section with object info
     ImGui::BeginChild("InspectorHeader", ImVec2(0, 60), true);
-            ImGui::TextColored(ImVec4(0.8f, 0.8f, 1.0f, 1.0f), "%s: %s", LANG("Inspecting"), m_selectedObject->name.c_str());
+            ImGui::TextColored(ImVec4(0.8f, 0.8f, 1.0f, 1.0f), "%s: %s", LANG("Inspecting"),
+                               m_scene.names().c_str(selected.nameId));
             ImGui::Text("%s: %s", LANG("Type"), LANG("GameObject"));
         ImGui::Text("%s: 0x%p", LANG("Address"), gameObject);
+        ImGui::SameLine();
+        ImGui::TextDisabled("  %s %.1f us", LANG("Sampling"), m_sampler.getBatchUs());
+        ImGui::SameLine();
+        if (GameTick::getInstance().isInstalled())
+        {
+            ImGui::Checkbox(LANG("Editable"), &m_editMode);
+        }
+        else
+        {
+            // Writes need a safe point in the player loop; Present is not one
+            m_editMode = false;
+            ImGui::TextDisabled("%s", LANG("Read-only (no game tick)"));
+        }
     ImGui::EndChild();
 
     ImGui::Spacing();
@@ -394,101 +1061,54 @@ void UnityExplorer::renderObjectInspector()
     ImGui::Spacing();
 
     // Transform component (always present) with better styling
-    if (transform)
+    if (transform && sectionHeader("Transform", ComponentCache::kTransformState))
     {
-        bool transformOpen = m_componentExpandedState["Transform"];
-        if (ImGui::CollapsingHeader("Transform", transformOpen ? ImGuiTreeNodeFlags_DefaultOpen : 0))
-        {
-            m_componentExpandedState["Transform"] = true;
-            ImGui::Indent(10.0f);
-            renderTransformComponent(transform);
-            ImGui::Unindent(10.0f);
-        }
-        else
-        {
-            m_componentExpandedState["Transform"] = false;
-        }
+        ImGui::Indent(10.0f);
+        renderTransformComponent(transform);
+        ImGui::Unindent(10.0f);
     }
 
-    // Get and render other components with better organization
-    try
+    // Every other component, from the per-selection cache: no Unity calls unless a section is open
+    m_components.update(m_scene, m_selection, static_cast<float>(ImGui::GetTime()));
+    const auto& components = m_components.entries();
+    for (size_t i = 0; i < components.size(); i++)
     {
-        // Try to get specific component types we know about
-        auto camera = gameObject->GetComponent<UnityResolve::UnityType::Camera*>(
-            GET_CLASS("UnityEngine.CoreModule.dll", "Camera"));
-        if (camera)
-        {
-            bool cameraOpen = m_componentExpandedState["Camera"];
-            if (ImGui::CollapsingHeader("Camera", cameraOpen ? ImGuiTreeNodeFlags_DefaultOpen : 0))
-            {
-                m_componentExpandedState["Camera"] = true;
-                ImGui::Indent(10.0f);
-                renderCameraComponent(camera);
-                ImGui::Unindent(10.0f);
-            }
-            else
-            {
-                m_componentExpandedState["Camera"] = false;
-            }
-        }
-
-        auto renderer = gameObject->GetComponent<UnityResolve::UnityType::Renderer*>(
-            GET_CLASS("UnityEngine.CoreModule.dll", "Renderer"));
-        if (renderer)
-        {
-            bool rendererOpen = m_componentExpandedState["Renderer"];
-            if (ImGui::CollapsingHeader("Renderer", rendererOpen ? ImGuiTreeNodeFlags_DefaultOpen : 0))
-            {
-                m_componentExpandedState["Renderer"] = true;
-                ImGui::Indent(10.0f);
-                renderRendererComponent(renderer);
-                ImGui::Unindent(10.0f);
-            }
-            else
-            {
-                m_componentExpandedState["Renderer"] = false;
-            }
-        }
+        const ComponentCache::Entry& entry = components[i];
+        const uint16_t section = entry.info->renderer;
+        if (section != ComponentRegistry::kNone && !m_sections[section].render) continue; // Transform, drawn above
 
-        auto rigidbody = gameObject->GetComponent<UnityResolve::UnityType::Rigidbody*>(
-            GET_CLASS("UnityEngine.PhysicsModule.dll", "Rigidbody"));
-        if (rigidbody)
+        ImGui::PushID(static_cast<int>(i));
+        if (sectionHeader(entry.info->name.c_str(), entry.info->stateKey))
         {
-            bool rigidbodyOpen = m_componentExpandedState["Rigidbody"];
-            if (ImGui::CollapsingHeader("Rigidbody", rigidbodyOpen ? ImGuiTreeNodeFlags_DefaultOpen : 0))
-            {
-                m_componentExpandedState["Rigidbody"] = true;
-                ImGui::Indent(10.0f);
-                renderRigidbodyComponent(rigidbody);
-                ImGui::Unindent(10.0f);
-            }
-            else
-            {
-                m_componentExpandedState["Rigidbody"] = false;
-            }
-        }
-
-        auto collider = gameObject->GetComponent<UnityResolve::UnityType::Collider*>(
-            GET_CLASS("UnityEngine.PhysicsModule.dll", "Collider"));
-        if (collider)
-        {
-            bool colliderOpen = m_componentExpandedState["Collider"];
-            if (ImGui::CollapsingHeader("Collider", colliderOpen ? ImGuiTreeNodeFlags_DefaultOpen : 0))
+            ImGui::Indent(10.0f);
+            try
             {
-                m_componentExpandedState["Collider"] = true;
-                ImGui::Indent(10.0f);
-                renderColliderComponent(collider);
-                ImGui::Unindent(10.0f);
+                if (entry.info->behaviour)
+                {
+                    auto behaviour = static_cast<UnityResolve::UnityType::Behaviour*>(entry.component);
+                    const bool enabled = m_sampler.sample<bool>(kEnabledPanel, behaviour, [behaviour](bool& value)
+                    {
+                        value = methods::Behaviour::GetEnabled(behaviour);
+                    });
+                    ImGui::Text("Enabled: %s", enabled ? "True" : "False");
+                }
+
+                if (section != ComponentRegistry::kNone)
+                {
+                    m_sections[section].render(this, entry.component);
+                }
+                else
+                {
+                    renderGenericComponent(entry.component, entry.info->fullName);
+                }
             }
-            else
+            catch (...)
             {
-                m_componentExpandedState["Collider"] = false;
+                ImGui::TextColored(ImVec4(1, 0.5f, 0.5f, 1), LANG("Error retrieving components"));
             }
+            ImGui::Unindent(10.0f);
         }
-    }
-    catch (...)
-    {
-        ImGui::TextColored(ImVec4(1, 0.5f, 0.5f, 1), LANG("Error retrieving components"));
+        ImGui::PopID();
     }
 
     ImGui::End();
@@ -498,25 +1118,31 @@ void UnityExplorer::renderGameObjectInfo(UnityResolve::UnityType::GameObject* ga
 {
     if (!gameObject) return;
 
-    bool gameObjectOpen = m_componentExpandedState["GameObject"];
-    if (ImGui::CollapsingHeader("GameObject", gameObjectOpen ? ImGuiTreeNodeFlags_DefaultOpen : 0))
+    if (sectionHeader("GameObject", ComponentCache::kGameObjectState))
     {
-        m_componentExpandedState["GameObject"] = true;
         ImGui::Indent(10.0f);
 
         try
         {
+            const auto& values = m_sampler.sample<GameObjectValues>(kGameObjectPanel, gameObject,
+                [this, gameObject](GameObjectValues& values)
+            {
+                values.name = getSafeString(gameObject->GetName());
+                values.tag = getSafeString(gameObject->GetTag());
+                values.activeSelf = gameObject->GetActiveSelf();
+                values.activeInHierarchy = gameObject->GetActiveInHierarchy();
+                values.isStatic = gameObject->GetIsStatic();
+            });
+
             // Basic properties section
             ImGui::Text("%s:", LANG("Basic Properties"));
             ImGui::Separator();
 
             // Name
-            std::string name = getSafeString(gameObject->GetName());
-            ImGui::Text("%s: %s", LANG("Name"), name.c_str());
+            ImGui::Text("%s: %s", LANG("Name"), values.name.c_str());
 
             // Tag
-            std::string tag = getSafeString(gameObject->GetTag());
-            ImGui::Text("%s: %s", LANG("Tag"), tag.c_str());
+            ImGui::Text("%s: %s", LANG("Tag"), values.tag.c_str());
 
             ImGui::Spacing();
 
@@ -525,8 +1151,8 @@ void UnityExplorer::renderGameObjectInfo(UnityResolve::UnityType::GameObject* ga
             ImGui::Separator();
 
             // Active state with colored indicators
-            bool activeSelf = gameObject->GetActiveSelf();
-            bool activeInHierarchy = gameObject->GetActiveInHierarchy();
+            bool activeSelf = values.activeSelf;
+            bool activeInHierarchy = values.activeInHierarchy;
 
             ImGui::Text("%s: ", LANG("Active Self"));
             ImGui::SameLine();
@@ -539,7 +1165,7 @@ void UnityExplorer::renderGameObjectInfo(UnityResolve::UnityType::GameObject* ga
                         "%s %s", activeInHierarchy ? "●" : "○", activeInHierarchy ? "True" : "False");
 
             // Static
-            bool isStatic = gameObject->GetIsStatic();
+            bool isStatic = values.isStatic;
             ImGui::Text("%s: ", LANG("Static"));
             ImGui::SameLine();
             textColored(isStatic ? ImVec4(0.8f, 0.8f, 0.2f, 1.0f) : ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
@@ -553,6 +1179,7 @@ void UnityExplorer::renderGameObjectInfo(UnityResolve::UnityType::GameObject* ga
 
             // Address info
             ImGui::Text("Address: 0x%p", gameObject);
+            renderSampleCost(kGameObjectPanel);
 
             // // Layer info
             // try
@@ -572,10 +1199,6 @@ void UnityExplorer::renderGameObjectInfo(UnityResolve::UnityType::GameObject* ga
 
         ImGui::Unindent(10.0f);
     }
-    else
-    {
-        m_componentExpandedState["GameObject"] = false;
-    }
 }
 
 void UnityExplorer::renderTransformComponent(UnityResolve::UnityType::Transform* transform)
@@ -584,20 +1207,47 @@ void UnityExplorer::renderTransformComponent(UnityResolve::UnityType::Transform*
 
     try
     {
+        auto& values = m_sampler.sample<TransformValues>(kTransformPanel, transform,
+            [this, transform](TransformValues& values)
+        {
+            // Both spaces through the bulk sampler: six direct icalls instead of six Invokes
+            auto transformPtr = transform;
+            auto& sampler = TransformSampler::getInstance();
+            sampler.sample(&transformPtr, 1, TransformSampler::Space::World, m_worldTransform);
+            sampler.sample(&transformPtr, 1, TransformSampler::Space::Local, m_localTransform);
+            values.position = m_worldTransform.positions[0];
+            values.rotation = m_worldTransform.rotations[0];
+            values.eulerAngles = values.rotation.ToEuler();
+            values.scale = m_worldTransform.scales[0];
+            values.localPosition = m_localTransform.positions[0];
+            values.localRotation = m_localTransform.rotations[0];
+            values.localEulerAngles = values.localRotation.ToEuler();
+            values.localScale = m_localTransform.scales[0];
+
+            values.childCount = transform->GetChildCount();
+            auto parent = transform->GetParent();
+            values.hasParent = parent != nullptr;
+            auto parentGO = parent ? parent->GetGameObject() : nullptr;
+            values.parentName = parentGO ? getSafeString(parentGO->GetName()) : std::string();
+        });
+
         // World Transform section
         ImGui::Text("World Transform:");
         ImGui::Separator();
 
-        auto position = transform->GetPosition();
-        renderVector3Field("Position", position);
+        // Edits go through the property setters and are written into the sampled values, so they show until
+        // the next batch reads them back
+        const bool readOnly = !m_editMode;
+        if (renderVector3Field("Position", values.position, readOnly))
+            queuePropertyEdit(transform, "position", &values.position, sizeof(values.position));
+        watchPropertyMenu(transform, "position", methods::TypeCode::R4, 3);
 
-        auto rotation = transform->GetRotation();
-        auto eulerAngles = rotation.ToEuler();
-        renderVector3Field("Rotation (Euler)", eulerAngles);
-        renderQuaternionField("Rotation (Quaternion)", rotation);
+        if (renderVector3Field("Rotation (Euler)", values.eulerAngles, readOnly))
+            queuePropertyEdit(transform, "eulerAngles", &values.eulerAngles, sizeof(values.eulerAngles));
+        if (renderQuaternionField("Rotation (Quaternion)", values.rotation, readOnly))
+            queuePropertyEdit(transform, "rotation", &values.rotation, sizeof(values.rotation));
 
-        auto scale = transform->GetLocalScale();
-        renderVector3Field("Scale", scale);
+        renderVector3Field("Scale (Lossy)", values.scale);
 
         ImGui::Spacing();
 
@@ -605,16 +1255,17 @@ void UnityExplorer::renderTransformComponent(UnityResolve::UnityType::Transform*
         ImGui::Text("Local Transform:");
         ImGui::Separator();
 
-        auto localPos = transform->GetLocalPosition();
-        renderVector3Field("Local Position", localPos);
+        if (renderVector3Field("Local Position", values.localPosition, readOnly))
+            queuePropertyEdit(transform, "localPosition", &values.localPosition, sizeof(values.localPosition));
+        watchPropertyMenu(transform, "localPosition", methods::TypeCode::R4, 3);
 
-        auto localRot = transform->GetLocalRotation();
-        auto localEuler = localRot.ToEuler();
-        renderVector3Field("Local Rotation (Euler)", localEuler);
-        renderQuaternionField("Local Rotation (Quaternion)", localRot);
+        if (renderVector3Field("Local Rotation (Euler)", values.localEulerAngles, readOnly))
+            queuePropertyEdit(transform, "localEulerAngles", &values.localEulerAngles, sizeof(values.localEulerAngles));
+        if (renderQuaternionField("Local Rotation (Quaternion)", values.localRotation, readOnly))
+            queuePropertyEdit(transform, "localRotation", &values.localRotation, sizeof(values.localRotation));
 
-        auto localScale = transform->GetLocalScale();
-        renderVector3Field("Local Scale", localScale);
+        if (renderVector3Field("Local Scale", values.localScale, readOnly))
+            queuePropertyEdit(transform, "localScale", &values.localScale, sizeof(values.localScale));
 
         ImGui::Spacing();
 
@@ -622,17 +1273,13 @@ void UnityExplorer::renderTransformComponent(UnityResolve::UnityType::Transform*
         ImGui::Text("Hierarchy Information:");
         ImGui::Separator();
 
-        int childCount = transform->GetChildCount();
-        ImGui::Text("Children: %d", childCount);
+        ImGui::Text("Children: %d", values.childCount);
 
-        auto parent = transform->GetParent();
-        if (parent)
+        if (values.hasParent)
         {
-            auto parentGO = parent->GetGameObject();
-            if (parentGO)
+            if (!values.parentName.empty())
             {
-                std::string parentName = getSafeString(parentGO->GetName());
-                ImGui::Text("Parent: %s", parentName.c_str());
+                ImGui::Text("Parent: %s", values.parentName.c_str());
             }
             else
             {
@@ -661,6 +1308,7 @@ void UnityExplorer::renderTransformComponent(UnityResolve::UnityType::Transform*
         ImGui::Text("Technical Information:");
         ImGui::Separator();
         ImGui::Text("Transform Address: 0x%p", transform);
+        renderSampleCost(kTransformPanel);
     }
     catch (...)
     {
@@ -668,20 +1316,301 @@ void UnityExplorer::renderTransformComponent(UnityResolve::UnityType::Transform*
     }
 }
 
+void UnityExplorer::renderGenericComponent(UnityResolve::UnityType::Component* component, const std::string& typeName)
+{
+    if (!component) return;
+
+    ImGui::TextDisabled("%s @ 0x%p", typeName.c_str(), component);
+
+    // Values are read at the offsets of the class layout, reflected on first use; no managed calls per frame
+    const auto& layout = m_fieldLayouts.get(methods::Runtime::GetObjectClass(component));
+    if (layout.fields.empty())
+    {
+        ImGui::TextDisabled("No managed fields");
+        return;
+    }
+
+    bool tracked = m_changes.isTracked(component);
+    if (ImGui::Checkbox(LANG("Track Changes"), &tracked))
+    {
+        if (!tracked)
+        {
+            m_changes.untrack(component);
+        }
+        else if (hasSelection())
+        {
+            const char* className = methods::Runtime::GetClassName(layout.klass);
+            m_changes.track(component, layout, std::string(m_scene.names().c_str(m_scene[selectedNode()].nameId)) +
+                            "." + (className ? className : "?"));
+        }
+    }
+    if (tracked)
+    {
+        // Data breakpoint: pause the game on the frame the field is written
+        const int breakField = m_changes.getBreak(component);
+        const char* preview = breakField == ChangeTracker::kNoBreak ? LANG("Never")
+            : breakField == ChangeTracker::kBreakOnAny ? LANG("Any field")
+            : layout.fields[breakField].name.c_str();
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(160.0f);
+        if (ImGui::BeginCombo(LANG("Pause on change"), preview))
+        {
+            if (ImGui::Selectable(LANG("Never"), breakField == ChangeTracker::kNoBreak))
+                m_changes.setBreak(component, ChangeTracker::kNoBreak);
+            if (ImGui::Selectable(LANG("Any field"), breakField == ChangeTracker::kBreakOnAny))
+                m_changes.setBreak(component, ChangeTracker::kBreakOnAny);
+            for (size_t i = 0; i < layout.fields.size(); i++)
+            {
+                ImGui::PushID(static_cast<int>(i));
+                if (ImGui::Selectable(layout.fields[i].name.c_str(), breakField == static_cast<int>(i)))
+                    m_changes.setBreak(component, static_cast<int>(i));
+                ImGui::PopID();
+            }
+            ImGui::EndCombo();
+        }
+    }
+
+    renderFields(layout, reinterpret_cast<const uint8_t*>(component), component, 0);
+}
+
+void UnityExplorer::renderFields(const FieldLayouts::Layout& layout, const uint8_t* object,
+                                 UnityResolve::UnityType::Component* owner, int depth)
+{
+    using Kind = FieldLayouts::Kind;
+    static constexpr int kMaxDepth = 4; // nested structs shown inline
+
+    const bool tracked = depth == 0 && m_changes.isTracked(owner);
+    const uint64_t frame = tracked ? currentFrame() : 0;
+    const bool readOnly = !m_editMode || !owner;
+    for (const FieldLayouts::Field& field : layout.fields)
+    {
+        const uint8_t* address = object + field.offset;
+        const char* name = field.name.c_str();
+        ImGui::PushID(field.offset);
+
+        // Recently written fields of a tracked component stand out
+        const uint64_t changed = tracked ? m_changes.lastChanged(owner, &field - layout.fields.data()) : 0;
+        const bool highlight = changed != 0 && frame - changed < kHighlightFrames;
+        if (highlight) ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.85f, 0.3f, 1.0f));
+
+        switch (field.kind)
+        {
+        case Kind::Bool:
+        {
+            bool value = *address != 0;
+            if (!readOnly)
+            {
+                if (itemEdited(ImGui::Checkbox(name, &value)))
+                    queueFieldEdit(owner, address, &value, 1, EditQueue::Format::Bool, name);
+                break;
+            }
+            ImGui::Text("%s: ", name);
+            ImGui::SameLine();
+            textColored(value ? ImVec4(0.2f, 0.8f, 0.2f, 1.0f) : ImVec4(0.8f, 0.2f, 0.2f, 1.0f), "%s %s",
+                        value ? "●" : "○", value ? "True" : "False");
+            break;
+        }
+        case Kind::Char:
+        {
+            const uint16_t value = *reinterpret_cast<const uint16_t*>(address);
+            if (value >= 0x20 && value < 0x7F) ImGui::Text("%s: '%c'", name, static_cast<char>(value));
+            else ImGui::Text("%s: U+%04X", name, value);
+            break;
+        }
+        case Kind::Integer:
+        case Kind::Enum:
+        {
+            int64_t value = 0;
+            switch (field.size)
+            {
+            case 1: value = *reinterpret_cast<const int8_t*>(address); break;
+            case 2: value = *reinterpret_cast<const int16_t*>(address); break;
+            case 4: value = *reinterpret_cast<const int32_t*>(address); break;
+            default: value = *reinterpret_cast<const int64_t*>(address); break;
+            }
+            if (!readOnly && field.kind == Kind::Integer && field.size == 4)
+            {
+                int edited = static_cast<int>(value);
+                ImGui::Text("%s:", name);
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(160.0f);
+                if (itemEdited(ImGui::DragInt("##value", &edited)))
+                    queueFieldEdit(owner, address, &edited, 4, EditQueue::Format::Int32, name);
+                break;
+            }
+            if (field.kind == Kind::Enum) ImGui::Text("%s: %lld (%s)", name, value, field.typeName.c_str());
+            else ImGui::Text("%s: %lld", name, value);
+            break;
+        }
+        case Kind::Unsigned:
+        {
+            uint64_t value = 0;
+            switch (field.size)
+            {
+            case 1: value = *address; break;
+            case 2: value = *reinterpret_cast<const uint16_t*>(address); break;
+            case 4: value = *reinterpret_cast<const uint32_t*>(address); break;
+            default: value = *reinterpret_cast<const uint64_t*>(address); break;
+            }
+            ImGui::Text("%s: %llu", name, value);
+            break;
+        }
+        case Kind::Float:
+        {
+            float value = *reinterpret_cast<const float*>(address);
+            if (readOnly)
+            {
+                ImGui::Text("%s: %.3f", name, value);
+                break;
+            }
+            ImGui::Text("%s:", name);
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(160.0f);
+            if (itemEdited(ImGui::DragFloat("##value", &value, 0.01f)))
+                queueFieldEdit(owner, address, &value, sizeof(value), EditQueue::Format::Floats, name);
+            break;
+        }
+        case Kind::Double: ImGui::Text("%s: %.6g", name, *reinterpret_cast<const double*>(address)); break;
+        case Kind::String:
+        {
+            auto text = *reinterpret_cast<UnityResolve::UnityType::String* const*>(address);
+            if (!text)
+            {
+                ImGui::Text("%s: ", name);
+                ImGui::SameLine();
+                ImGui::TextDisabled("null");
+                break;
+            }
+            std::string value = getSafeString(text);
+            if (value.size() > 128) value = value.substr(0, 128) + "...";
+            ImGui::Text("%s: \"%s\"", name, value.c_str());
+            break;
+        }
+        case Kind::Vector2:
+        {
+            const auto* v = reinterpret_cast<const float*>(address);
+            ImGui::Text("%s: (%.3f, %.3f)", name, v[0], v[1]);
+            break;
+        }
+        case Kind::Vector3:
+        {
+            auto value = *reinterpret_cast<const UnityResolve::UnityType::Vector3*>(address);
+            if (renderVector3Field(name, value, readOnly))
+                queueFieldEdit(owner, address, &value, sizeof(value), EditQueue::Format::Floats, name);
+            break;
+        }
+        case Kind::Vector4:
+        {
+            const auto* v = reinterpret_cast<const float*>(address);
+            ImGui::Text("%s: (%.3f, %.3f, %.3f, %.3f)", name, v[0], v[1], v[2], v[3]);
+            break;
+        }
+        case Kind::Quaternion:
+        {
+            auto value = *reinterpret_cast<const UnityResolve::UnityType::Quaternion*>(address);
+            if (renderQuaternionField(name, value, readOnly))
+                queueFieldEdit(owner, address, &value, sizeof(value), EditQueue::Format::Floats, name);
+            break;
+        }
+        case Kind::Color:
+        {
+            auto value = *reinterpret_cast<const UnityResolve::UnityType::Color*>(address);
+            if (renderColorField(name, value, readOnly))
+                queueFieldEdit(owner, address, &value, sizeof(value), EditQueue::Format::Floats, name);
+            break;
+        }
+        case Kind::Color32:
+        {
+            UnityResolve::UnityType::Color color = {address[0] / 255.0f, address[1] / 255.0f,
+                                                    address[2] / 255.0f, address[3] / 255.0f};
+            renderColorField(name, color);
+            break;
+        }
+        case Kind::Struct:
+            if (depth < kMaxDepth && ImGui::TreeNode(name, "%s (%s)", name, field.typeName.c_str()))
+            {
+                renderFields(m_fieldLayouts.get(field.klass), address - FieldLayouts::kObjectHeader, owner,
+                             depth + 1);
+                ImGui::TreePop();
+            }
+            break;
+        case Kind::Reference:
+        case Kind::Array:
+        {
+            const auto* target = *reinterpret_cast<const uint8_t* const*>(address);
+            ImGui::Text("%s: ", name);
+            ImGui::SameLine();
+            if (!target)
+            {
+                ImGui::TextDisabled("null (%s)", field.typeName.c_str());
+                break;
+            }
+
+            // The runtime class of the target, which may be more derived than the declared one
+            void* klass = methods::Runtime::GetObjectClass(const_cast<uint8_t*>(target));
+            const char* className = methods::Runtime::GetClassName(klass);
+            if (field.kind == Kind::Array)
+            {
+                const auto length = reinterpret_cast<const UnityResolve::UnityType::Array<void*>*>(target)->max_length;
+                ImGui::Text("%s (Length = %zu)", className ? className : field.typeName.c_str(),
+                            static_cast<size_t>(length));
+            }
+            else if (const int32_t size = m_fieldLayouts.findOffset(klass, "_size"); size >= 0)
+            {
+                // List<T> and friends keep their count in _size
+                ImGui::Text("%s (Count = %d)", className ? className : field.typeName.c_str(),
+                            *reinterpret_cast<const int32_t*>(target + size));
+            }
+            else
+            {
+                ImGui::Text("%s", className ? className : field.typeName.c_str());
+            }
+            ImGui::SameLine();
+            ImGui::TextDisabled("0x%p", target);
+            break;
+        }
+        }
+
+        if (highlight) ImGui::PopStyleColor();
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("%s %s (+0x%X)", field.typeName.c_str(), name, field.offset);
+
+        const methods::TypeCode code = watchCode(field);
+        if (code != methods::TypeCode::Unknown && ImGui::BeginPopupContextItem("watch"))
+        {
+            WatchList::Spec spec;
+            spec.label = watchLabel(owner, name);
+            spec.owner = owner;
+            spec.offset = static_cast<int32_t>(address - reinterpret_cast<const uint8_t*>(owner));
+            spec.code = code;
+            const uint8_t components = field.kind == Kind::Vector2 ? 2 : field.kind == Kind::Vector3 ? 3
+                : field.kind == Kind::Vector4 ? 4 : 0;
+            watchMenuItems(spec, components);
+            ImGui::EndPopup();
+        }
+        ImGui::PopID();
+    }
+}
+
 void UnityExplorer::renderCameraComponent(UnityResolve::UnityType::Camera* camera)
 {
     if (!camera) return;
 
     try
     {
-        float fov = camera->GetFoV();
-        ImGui::Text("Field of View: %.2f°", fov);
+        const auto& values = m_sampler.sample<CameraValues>(kCameraPanel, camera, [camera](CameraValues& values)
+        {
+            values.fov = camera->GetFoV();
+            values.depth = camera->GetDepth();
+        });
 
-        float depth = camera->GetDepth();
-        ImGui::Text("Depth: %.2f", depth);
+        ImGui::Text("Field of View: %.2f°", values.fov);
+        watchPropertyMenu(camera, "fieldOfView", methods::TypeCode::R4);
+        ImGui::Text("Depth: %.2f", values.depth);
+        watchPropertyMenu(camera, "depth", methods::TypeCode::R4);
 
         // Camera type and other properties would go here
         ImGui::Text("Address: 0x%p", camera);
+        renderSampleCost(kCameraPanel);
     }
     catch (...)
     {
@@ -695,11 +1624,13 @@ void UnityExplorer::renderRendererComponent(UnityResolve::UnityType::Renderer* r
 
     try
     {
-        auto bounds = renderer->GetBounds();
+        const auto& bounds = m_sampler.sample<UnityResolve::UnityType::Bounds>(kRendererPanel, renderer,
+            [renderer](UnityResolve::UnityType::Bounds& bounds) { bounds = renderer->GetBounds(); });
         ImGui::Text("Bounds Center: %s", formatVector3(bounds.m_vCenter).c_str());
         ImGui::Text("Bounds Extents: %s", formatVector3(bounds.m_vExtents).c_str());
 
         ImGui::Text("Address: 0x%p", renderer);
+        renderSampleCost(kRendererPanel);
     }
     catch (...)
     {
@@ -713,13 +1644,20 @@ void UnityExplorer::renderRigidbodyComponent(UnityResolve::UnityType::Rigidbody*
 
     try
     {
-        auto velocity = rigidbody->GetVelocity();
-        renderVector3Field("Velocity", velocity);
+        auto& values = m_sampler.sample<RigidbodyValues>(kRigidbodyPanel, rigidbody,
+            [rigidbody](RigidbodyValues& values)
+        {
+            values.velocity = rigidbody->GetVelocity();
+            values.detectCollisions = rigidbody->GetDetectCollisions();
+        });
 
-        bool detectCollisions = rigidbody->GetDetectCollisions();
-        ImGui::Text("Detect Collisions: %s", detectCollisions ? "True" : "False");
+        if (renderVector3Field("Velocity", values.velocity, !m_editMode))
+            queuePropertyEdit(rigidbody, "velocity", &values.velocity, sizeof(values.velocity));
+        watchPropertyMenu(rigidbody, "velocity", methods::TypeCode::R4, 3);
+        ImGui::Text("Detect Collisions: %s", values.detectCollisions ? "True" : "False");
 
         ImGui::Text("Address: 0x%p", rigidbody);
+        renderSampleCost(kRigidbodyPanel);
     }
     catch (...)
     {
@@ -733,11 +1671,13 @@ void UnityExplorer::renderColliderComponent(UnityResolve::UnityType::Collider* c
 
     try
     {
-        auto bounds = collider->GetBounds();
+        const auto& bounds = m_sampler.sample<UnityResolve::UnityType::Bounds>(kColliderPanel, collider,
+            [collider](UnityResolve::UnityType::Bounds& bounds) { bounds = collider->GetBounds(); });
         ImGui::Text("Bounds Center: %s", formatVector3(bounds.m_vCenter).c_str());
         ImGui::Text("Bounds Extents: %s", formatVector3(bounds.m_vExtents).c_str());
 
         ImGui::Text("Address: 0x%p", collider);
+        renderSampleCost(kColliderPanel);
     }
     catch (...)
     {
@@ -745,144 +1685,695 @@ void UnityExplorer::renderColliderComponent(UnityResolve::UnityType::Collider* c
     }
 }
 
-void UnityExplorer::refreshScene()
+void UnityExplorer::renderSampleCost(const char* panel)
 {
-    try
+    const PropertySampler::PanelCost& cost = m_sampler.getCost(panel);
+    if (m_sampler.getRate() > 0)
     {
-        LOG_INFO("[UnityExplorer] Refreshing scene...");
+        ImGui::TextDisabled("%s %.1f us @ %d Hz", LANG("Sampling"), cost.averageUs, m_sampler.getRate());
+    }
+    else
+    {
+        ImGui::TextDisabled("%s %.1f us %s", LANG("Sampling"), cost.averageUs, LANG("per frame"));
+    }
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::SetTooltip("Managed reads for this section, all open objects. Last %.1f us, %u batches",
+                          cost.lastUs, cost.fetches);
+    }
+}
 
-        m_rootObjects.clear();
-        m_objectCache.clear();
+std::string UnityExplorer::watchLabel(UnityResolve::UnityType::UnityObject* owner, const char* member)
+{
+    std::string label = hasSelection() ? std::string(m_scene.names().c_str(m_scene[selectedNode()].nameId)) : "?";
+    const char* className = methods::Runtime::GetClassName(methods::Runtime::GetObjectClass(owner));
+    label += ".";
+    label += className ? className : "?";
+    label += ".";
+    label += member;
+    return label;
+}
 
-        buildHierarchy();
+void UnityExplorer::watchMenuItems(const WatchList::Spec& spec, uint8_t components)
+{
+    WatchList::Spec pinned = spec;
+    bool add = false;
+    if (components == 0)
+    {
+        add = ImGui::MenuItem(LANG("Watch"));
+    }
+    else
+    {
+        // One float lane of the vector, or its length
+        static constexpr const char* kAxes[] = {"x", "y", "z", "w"};
+        for (uint8_t i = 0; i < components && !add; i++)
+        {
+            if (ImGui::MenuItem((std::string(LANG("Watch")) + " " + kAxes[i]).c_str()))
+            {
+                pinned.label += std::string(".") + kAxes[i];
+                pinned.offset += i * static_cast<int32_t>(sizeof(float));
+                add = true;
+            }
+        }
+        if (!add && ImGui::MenuItem((std::string(LANG("Watch")) + " magnitude").c_str()))
+        {
+            pinned.label += ".magnitude";
+            pinned.components = components;
+            add = true;
+        }
+    }
 
-        LOG_INFO("[UnityExplorer] Scene refreshed. Found %zu root objects.", m_rootObjects.size());
+    if (add)
+    {
+        if (m_watches.add(pinned) < 0)
+        {
+            LOG_WARNING("[UnityExplorer] Watch list is full (%zu)", WatchList::kMaxWatches);
+        }
+        m_showWatchList = true;
     }
-    catch (const std::exception& e)
+}
+
+void UnityExplorer::watchPropertyMenu(UnityResolve::UnityType::UnityObject* owner, const char* property,
+                                      methods::TypeCode code, uint8_t components)
+{
+    ImGui::PushID(property);
+    if (ImGui::BeginPopupContextItem("watch"))
     {
-        LOG_ERROR("[UnityExplorer] Exception during scene refresh: %s", e.what());
-    } catch (...)
+        // Resolved only while the menu is open; getters return value types boxed
+        WatchList::Spec spec;
+        spec.label = watchLabel(owner, property);
+        spec.owner = owner;
+        spec.getter = methods::Runtime::GetPropertyGetter(methods::Runtime::GetObjectClass(owner), property);
+        spec.offset = FieldLayouts::kObjectHeader;
+        spec.code = code;
+        if (spec.getter) watchMenuItems(spec, components);
+        else ImGui::TextDisabled("%s: %s", property, LANG("not readable"));
+        ImGui::EndPopup();
+    }
+    ImGui::PopID();
+}
+
+bool UnityExplorer::itemEdited(bool changed)
+{
+    // A new drag or text entry starts a new transaction; the frames it stays active extend it
+    if (ImGui::IsItemActivated()) m_editGesture++;
+    return changed;
+}
+
+void UnityExplorer::queuePropertyEdit(UnityResolve::UnityType::UnityObject* owner, const char* property,
+                                      const void* value, uint8_t size)
+{
+    // Resolved only on frames with an edit; the getter reads the value the write replaces, for the journal
+    void* klass = methods::Runtime::GetObjectClass(owner);
+    EditQueue::Target target;
+    target.owner = owner;
+    target.setter = methods::Runtime::GetPropertySetter(klass, property);
+    target.getter = methods::Runtime::GetPropertyGetter(klass, property);
+    target.size = size;
+    if (!target.setter || !target.getter)
     {
-        LOG_ERROR("[UnityExplorer] Unknown exception during scene refresh");
+        LOG_WARNING("[UnityExplorer] Property %s is not writable", property);
+        return;
     }
+    m_edits.write(target, value, watchLabel(owner, property), m_editGesture);
+}
+
+void UnityExplorer::queueFieldEdit(UnityResolve::UnityType::Component* owner, const uint8_t* address,
+                                   const void* value, uint8_t size, EditQueue::Format format, const char* name)
+{
+    EditQueue::Target target;
+    target.owner = owner;
+    target.offset = static_cast<int32_t>(address - reinterpret_cast<const uint8_t*>(owner));
+    target.size = size;
+    target.format = format;
+    m_edits.write(target, value, watchLabel(owner, name), m_editGesture);
 }
 
-void UnityExplorer::buildHierarchy()
+void UnityExplorer::renderEditJournal()
 {
-    auto gameObjectClass = GET_CLASS("UnityEngine.CoreModule.dll", "GameObject");
-    if (!gameObjectClass)
+    if (!ImGui::Begin("Edit Journal", &m_showEditJournal))
     {
-        LOG_ERROR("[UnityExplorer] Could not find GameObject class");
+        ImGui::End();
         return;
     }
 
-    auto allGameObjects = gameObjectClass->FindObjectsByType<UnityResolve::UnityType::GameObject*>();
-    LOG_INFO("[UnityExplorer] Found %zu GameObjects total", allGameObjects.size());
+    const auto& journal = m_edits.journal();
+    // Undo is a write like any other and needs the same safe point
+    const bool gameThread = GameTick::getInstance().isInstalled();
+    if (ImGui::Button(LANG("Undo Last")) && gameThread) m_edits.undoLast();
+    ImGui::SameLine();
+    if (ImGui::Button(LANG("Clear"))) m_edits.clearJournal();
+    ImGui::SameLine();
+    ImGui::TextDisabled("%zu / %zu, %zu %s, %u %s", journal.size(), EditQueue::kMaxJournal,
+                        m_edits.getPendingCount(), LANG("pending"), m_edits.getFailedCount(), LANG("failed"));
+    if (!gameThread)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.3f, 1.0f), "%s", LANG("Read-only (no game tick)"));
+    }
+    ImGui::Separator();
+
+    if (journal.empty())
+    {
+        ImGui::TextDisabled("%s", LANG("No edits"));
+        ImGui::End();
+        return;
+    }
+
+    uint64_t undo = 0;
+    ImGui::BeginChild("Journal");
+    for (const EditQueue::Transaction& transaction : journal)
+    {
+        ImGui::PushID(static_cast<int>(transaction.id));
+        if (transaction.undone) ImGui::TextDisabled("%s", LANG("Undone"));
+        else if (ImGui::SmallButton(LANG("Undo"))) undo = transaction.id;
+        ImGui::SameLine();
+
+        const ImVec4 color = transaction.undone ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+        textColored(color, "%s: %s -> %s", transaction.label.c_str(),
+                    EditQueue::formatValue(transaction.before, transaction.target).c_str(),
+                    EditQueue::formatValue(transaction.after, transaction.target).c_str());
+        if (transaction.writes > 1)
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(%u %s)", transaction.writes, LANG("writes"));
+        }
+        ImGui::PopID();
+    }
+    ImGui::EndChild();
+    if (undo != 0 && gameThread) m_edits.undo(undo);
 
-    // Build the hierarchy
-    std::unordered_map<UnityResolve::UnityType::Transform*, std::shared_ptr<GameObjectNode>> transformToNode;
+    ImGui::End();
+}
 
-    // First pass: create all nodes
-    for (auto* go : allGameObjects)
+void UnityExplorer::renderWatchList()
+{
+    if (!ImGui::Begin("Watch List", &m_showWatchList))
     {
-        if (!go) continue;
+        ImGui::End();
+        return;
+    }
 
-        auto node = createGameObjectNode(go);
-        if (node && node->transform)
+    const bool gameThread = GameTick::getInstance().isInstalled();
+    ImGui::TextDisabled("%zu / %zu, %s %.1f us %s", m_watches.ids().size(), WatchList::kMaxWatches,
+                        LANG("Sampling"), m_watches.getSampleUs(), gameThread ? "(game thread)" : "(UI thread)");
+    ImGui::SameLine();
+    helpMarker("Values are recorded every game frame, about a minute of history each. "
+               "Right-click a number in the Object Inspector to add it.");
+    ImGui::Separator();
+
+    int removeId = -1;
+    for (int id : m_watches.ids())
+    {
+        ImGui::PushID(id);
+        const WatchList::Stats stats = m_watches.stats(id);
+        if (ImGui::SmallButton("x")) removeId = id;
+        ImGui::SameLine();
+        ImGui::Text("%s", m_watches.spec(id).label.c_str());
+        ImGui::SameLine();
+        if (stats.dead)
+        {
+            ImGui::TextColored(ImVec4(1, 0.5f, 0.5f, 1), "%s", LANG("not readable"));
+        }
+        else
         {
-            transformToNode[node->transform] = node;
+            ImGui::TextColored(ImVec4(0.8f, 0.8f, 1.0f, 1.0f), "%.4g", stats.last);
         }
+        ImGui::TextDisabled("min %.4g  max %.4g  %zu %s", stats.min, stats.max, stats.count, LANG("samples"));
+        if (stats.dropped > 0)
+        {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1, 0.7f, 0.3f, 1), "(%u dropped)", stats.dropped);
+        }
+        renderWatchPlot(id, stats);
+        ImGui::Spacing();
+        ImGui::PopID();
     }
 
-    // Second pass: build parent-child relationships
-    for (auto& [transform, node] : transformToNode)
+    if (removeId >= 0) m_watches.remove(removeId);
+    ImGui::End();
+}
+
+void UnityExplorer::renderWatchPlot(int id, const WatchList::Stats& stats)
+{
+    static constexpr float kPlotHeight = 60.0f;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+    ImGui::InvisibleButton("plot", ImVec2(width, kPlotHeight));
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + kPlotHeight), IM_COL32(20, 20, 30, 255));
+
+    // One min/max span per pixel column, so drawing cost follows the plot width rather than the history length
+    const size_t columns = m_watches.decimate(id, static_cast<size_t>(width), m_plotMin, m_plotMax);
+    if (columns == 0) return;
+
+    const float range = stats.max > stats.min ? stats.max - stats.min : 1.0f;
+    const auto toY = [&](float value)
     {
-        try
+        return origin.y + kPlotHeight - 2.0f - (value - stats.min) / range * (kPlotHeight - 4.0f);
+    };
+    const float step = width / static_cast<float>(columns);
+    const ImU32 color = IM_COL32(120, 200, 255, 255);
+    for (size_t i = 0; i < columns; i++)
+    {
+        // Overlap the previous span so the trace stays connected across jumps
+        float low = m_plotMin[i];
+        float high = m_plotMax[i];
+        if (i > 0)
         {
-            auto parent = transform->GetParent();
-            if (parent && transformToNode.contains(parent))
+            low = std::min(low, m_plotMax[i - 1]);
+            high = std::max(high, m_plotMin[i - 1]);
+        }
+        const float x = origin.x + (static_cast<float>(i) + 0.5f) * step;
+        drawList->AddLine(ImVec2(x, toY(high)), ImVec2(x, toY(low) + 1.0f), color);
+    }
+
+    if (ImGui::IsItemHovered())
+    {
+        const size_t column = std::min(columns - 1, static_cast<size_t>(
+            (ImGui::GetIO().MousePos.x - origin.x) / step));
+        ImGui::SetTooltip("%.4g .. %.4g", m_plotMin[column], m_plotMax[column]);
+    }
+}
+
+uint64_t UnityExplorer::currentFrame() const
+{
+    // Game frames when ticking on the main thread, otherwise UI frames (one per Present)
+    if (GameTick::getInstance().isInstalled()) return GameTick::getInstance().getFrame();
+    return static_cast<uint64_t>(ImGui::GetFrameCount());
+}
+
+void UnityExplorer::showBreak(const ChangeTracker::Hit& hit)
+{
+    // The tracker already paused the game, on the frame of the hit
+    m_breakMessage = m_changes.getLabel(hit.tracked) + "." + hit.field->name + " changed on frame " +
+        std::to_string(hit.frame);
+    m_showFieldChanges = true;
+    LOG_INFO("[UnityExplorer] Paused: %s", m_breakMessage.c_str());
+}
+
+void UnityExplorer::renderFieldChanges()
+{
+    if (!ImGui::Begin("Field Changes", &m_showFieldChanges))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::TextDisabled("%zu %s, %zu bytes, %.1f us", m_changes.trackedCount(), LANG("tracked"),
+                        m_changes.getTrackedBytes(), m_changes.getScanUs());
+    ImGui::SameLine();
+    helpMarker("Tick \"Track Changes\" on a script component in the Object Inspector. Its fields are compared "
+               "with a copy every frame; changes are listed here, newest first, and highlighted in the inspector.");
+    if (m_changes.getDropped() > 0)
+    {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1, 0.7f, 0.3f, 1), "(%u dropped)", m_changes.getDropped());
+    }
+
+    if (m_changes.isPaused())
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.3f, 1.0f), "%s: %s", LANG("Paused"), m_breakMessage.c_str());
+        ImGui::SameLine();
+        if (ImGui::Button(LANG("Resume"))) m_changes.resume();
+    }
+
+    if (ImGui::Button(LANG("Clear Log"))) m_changes.clearLog();
+    ImGui::SameLine();
+    if (ImGui::Button(LANG("Untrack All"))) m_changes.clear();
+    ImGui::Separator();
+
+    ImGui::BeginChild("ChangeLog");
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(m_changes.logSize()));
+    while (clipper.Step())
+    {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+        {
+            const ChangeTracker::Change& change = m_changes.logEntry(row);
+            ImGui::TextDisabled("%llu", static_cast<unsigned long long>(change.frame));
+            ImGui::SameLine(90.0f);
+            ImGui::Text("%s.%s", m_changes.getLabel(change.tracked).c_str(), change.field->name.c_str());
+        }
+    }
+    ImGui::EndChild();
+    ImGui::End();
+}
+
+void UnityExplorer::refreshScene()
+{
+    // A scan already in flight picks up all changes up to its enumeration; queue another one after it
+    if (m_builder.isRunning())
+    {
+        m_needsRefresh = true;
+        return;
+    }
+
+    const auto mode = m_lazyHierarchy ? HierarchyBuilder::Mode::Lazy : HierarchyBuilder::Mode::Full;
+    if (m_needsRefresh || !m_lazyHierarchy)
+    {
+        LOG_INFO("[UnityExplorer] Refreshing scene...");
+        m_builder.begin(mode);
+        m_needsRefresh = false;
+    }
+    else
+    {
+        LOG_INFO("[UnityExplorer] Refreshing %zu changed scene(s)...", m_dirtyScenes.size());
+        m_builder.begin(mode, m_dirtyScenes);
+    }
+    m_dirtyScenes.clear();
+}
+
+void UnityExplorer::processSceneEvents()
+{
+    SceneEvents::getInstance().poll(m_sceneEvents);
+
+    for (const SceneEvents::Event& event : m_sceneEvents)
+    {
+        if (event.type != SceneEvents::Type::Unloaded)
+        {
+            markSceneDirty(event.scene);
+            continue;
+        }
+
+        // Nodes of a lazy scan know their scene, so an unloaded scene is dropped without touching Unity.
+        // Full scans carry no scene information and have to rescan.
+        if (!m_lazyHierarchy)
+        {
+            m_needsRefresh = true;
+            continue;
+        }
+
+        // A scan in flight may still hold objects of the unloaded scene; redo its work after pruning
+        if (m_builder.isRunning())
+        {
+            if (m_builder.isPartial())
             {
-                // This is a child
-                transformToNode[parent]->children.push_back(node);
-                node->depth = transformToNode[parent]->depth + 1;
+                for (int scene : m_builder.getScenes()) markSceneDirty(scene);
             }
             else
             {
-                // This is a root object
-                m_rootObjects.push_back(node);
+                m_needsRefresh = true;
             }
+            m_builder.cancel();
         }
-        catch (...)
+
+        const size_t removed = m_scene.destroyScene(event.scene);
+        std::erase(m_dirtyScenes, event.scene);
+        LOG_INFO("[UnityExplorer] Scene unloaded, removed %zu objects", removed);
+    }
+}
+
+void UnityExplorer::processObjectChanges()
+{
+    ObjectRegistry::getInstance().poll(m_objectChanges);
+    if (m_objectChanges.empty()) return;
+
+    m_builder.applyChanges(m_scene, m_objectChanges);
+
+    // Destroying a component is journaled under its GameObject, so this also catches removed components. A
+    // delayed Destroy(component, t) is not; the component cache drops it once Unity has destroyed it.
+    if (hasSelection())
+    {
+        const int32_t selectedId = m_scene[selectedNode()].instanceId;
+        for (const ObjectRegistry::Change& change : m_objectChanges)
         {
-            // If we can't get parent info, treat as root
-            m_rootObjects.push_back(node);
+            if (change.instanceId == selectedId) m_components.invalidate();
         }
     }
-
-    // Sort root objects by name for consistency
-    std::sort(m_rootObjects.begin(), m_rootObjects.end(),
-              [](const std::shared_ptr<GameObjectNode>& a, const std::shared_ptr<GameObjectNode>& b)
-              {
-                  return a->name < b->name;
-              });
 }
 
-std::shared_ptr<UnityExplorer::GameObjectNode> UnityExplorer::createGameObjectNode(
-    UnityResolve::UnityType::GameObject* go, int depth)
+void UnityExplorer::pruneDeadNodes()
 {
-    if (!go) return nullptr;
+    // The selection is checked every frame since the inspector calls into it; the rest of the tree in slices
+    const uint32_t selected = selectedNode();
+    if (selected != SceneArena::kInvalid && !m_scene.isLive(selected))
+    {
+        m_builder.prune(m_scene, selected);
+    }
 
-    auto node = std::make_shared<GameObjectNode>();
-    node->gameObject = go;
-    node->depth = depth;
+    const size_t pruned = m_builder.pruneDead(m_scene, kLivenessChecksPerFrame);
+    if (pruned > 0)
+    {
+        LOG_INFO("[UnityExplorer] Pruned %zu destroyed objects", pruned);
+    }
+}
 
-    try
+void UnityExplorer::benchmarkTransformSampler()
+{
+    std::vector<UnityResolve::UnityType::Transform*> transforms;
+    transforms.reserve(m_scene.liveCount());
+    for (uint32_t index = 0; index < m_scene.capacity(); index++)
     {
-        node->transform = go->GetTransform();
-        node->isActive = go->GetActiveSelf();
+        if (m_scene.isLive(index) && m_scene[index].transform) transforms.push_back(m_scene[index].transform);
+    }
 
-        // Get name safely
-        if (auto nameStr = go->GetName())
-        {
-            node->name = getSafeString(nameStr);
-        }
-        else
-        {
-            node->name = "Unknown GameObject";
-        }
+    m_samplerComparison = TransformSampler::getInstance().compare(transforms.data(), transforms.size());
+}
 
-        // Cache the node
-        m_objectCache[go] = node;
+void UnityExplorer::benchmarkSearch()
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kRuns = 20;
+
+    SearchComparison result;
+    result.query = m_searchFilter;
+
+    auto start = Clock::now();
+    for (uint32_t index = 0; index < m_scene.capacity(); index++)
+    {
+        if (!m_scene[index].isLinked()) continue;
+        result.objects++;
+        if (matchesFilter(m_scene.nameOf(index), m_searchFilter)) result.matches++;
     }
-    catch (...)
+    result.linearMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // A separate filter so the view's results stay untouched. Building the index is not part of the timing;
+    // the empty query in between keeps every timed query from narrowing the previous one.
+    SceneFilter filter;
+    filter.prepare(m_scene);
+    double total = 0.0;
+    for (int run = 0; run < kRuns; run++)
     {
-        node->name = "Error reading GameObject";
-        node->isActive = false;
+        filter.update(m_scene, "");
+        start = Clock::now();
+        filter.update(m_scene, m_searchFilter);
+        while (filter.isRunning()) filter.step(m_scene, 0);
+        total += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
     }
+    result.indexedMs = total / kRuns;
 
-    return node;
+    if (filter.matchCount() != result.matches)
+    {
+        LOG_WARNING("[UnityExplorer] Search index found %zu matches, matchesFilter %zu", filter.matchCount(),
+                    result.matches);
+    }
+    LOG_INFO("[UnityExplorer] Search \"%s\" over %zu objects (%zu names, %zu trigrams): matchesFilter %.2f ms, "
+             "index %.3f ms", result.query.c_str(), result.objects, m_scene.names().size(),
+             filter.index().trigramCount(), result.linearMs, result.indexedMs);
+    m_searchComparison = std::move(result);
 }
 
+void UnityExplorer::saveSnapshot()
+{
+    // In lazy mode only expanded subtrees are in the arena; the file records which nodes have missing children
+    m_lastSnapshot = SnapshotExporter::save(m_scene, "snapshots", m_snapshotOptions, m_lazyHierarchy);
+}
 
-std::string UnityExplorer::getComponentTypeName(UnityResolve::UnityType::Component* component)
+void UnityExplorer::setBaseline()
 {
-    if (!component) return "Unknown";
+    // Structure and names only; components and transforms are not part of the diff
+    const SnapshotExporter::Options options = {false, false, false};
+    SnapshotExporter::capture(m_scene, options, m_lazyHierarchy, m_baseline);
+    m_baselineTree.build(m_baseline);
+    m_comparison = snapshot::Capture();
+    m_comparisonTree = snapshot::HashedTree();
+    m_diff = snapshot::DiffResult();
+    LOG_INFO("[UnityExplorer] Baseline set with %zu objects", m_baseline.nodes.size());
+}
 
-    try
+void UnityExplorer::compareWithBaseline()
+{
+    using Clock = std::chrono::steady_clock;
+
+    const SnapshotExporter::Options options = {false, false, false};
+    SnapshotExporter::capture(m_scene, options, m_lazyHierarchy, m_comparison);
+
+    const auto start = Clock::now();
+    m_comparisonTree.build(m_comparison);
+    m_diff = snapshot::diff(m_baselineTree, m_comparisonTree);
+    m_diffMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    m_showChanges = true;
+
+    LOG_INFO("[UnityExplorer] %zu changes since baseline (%zu pairs compared, %zu unchanged subtrees skipped) "
+             "in %.2f ms", m_diff.changes.size(), m_diff.compared, m_diff.skippedSubtrees, m_diffMs);
+}
+
+void UnityExplorer::renderChangeView()
+{
+    ImGui::Text("%s:", LANG("Changes Since Baseline"));
+    ImGui::SameLine();
+    helpMarker("Set a baseline from the Snapshot menu, then compare to list the objects that were added, removed, "
+               "reparented, renamed or toggled since. Click an entry to select the object.");
+    if (!m_comparison.nodes.empty())
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("%zu %s, %.2f ms", m_diff.changes.size(), LANG("Changed"), m_diffMs);
+    }
+
+    ImGui::BeginChild("ChangeView", ImVec2(0, 180), true);
+    if (m_comparison.nodes.empty())
     {
-        if (auto type = component->GetType())
+        ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), LANG("Not compared yet"));
+    }
+    else if (m_diff.changes.empty())
+    {
+        ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), LANG("No changes"));
+    }
+
+    static const ImVec4 kindColors[] = {
+        ImVec4(0.4f, 0.9f, 0.4f, 1.0f), // Added
+        ImVec4(0.9f, 0.4f, 0.4f, 1.0f), // Removed
+        ImVec4(0.4f, 0.7f, 1.0f, 1.0f), // Reparented
+        ImVec4(0.9f, 0.8f, 0.4f, 1.0f), // Renamed
+        ImVec4(0.7f, 0.7f, 0.7f, 1.0f), // ActivityChanged
+    };
+
+    // Changes are grouped by kind, so each kind is one contiguous range
+    size_t first = 0;
+    for (size_t kind = 0; kind < static_cast<size_t>(snapshot::ChangeKind::Count); kind++)
+    {
+        const size_t count = m_diff.counts[kind];
+        const size_t begin = first;
+        first += count;
+        if (count == 0) continue;
+
+        ImGui::PushStyleColor(ImGuiCol_Text, kindColors[kind]);
+        const bool open = ImGui::TreeNodeEx(snapshot::getChangeKindName(static_cast<snapshot::ChangeKind>(kind)),
+                                            ImGuiTreeNodeFlags_DefaultOpen, "%s (%zu)",
+                                            snapshot::getChangeKindName(static_cast<snapshot::ChangeKind>(kind)),
+                                            count);
+        ImGui::PopStyleColor();
+        if (!open) continue;
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(count));
+        while (clipper.Step())
         {
-            if (auto nameStr = type->GetFullName())
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
             {
-                return getSafeString(nameStr);
+                const snapshot::Change& change = m_diff.changes[begin + row];
+                const bool after = change.after != snapshot::kNone;
+                const snapshot::Capture& capture = after ? m_comparison : m_baseline;
+                const std::string_view name = capture.nameOf(after ? change.after : change.before);
+
+                std::string label(name);
+                switch (change.kind)
+                {
+                case snapshot::ChangeKind::Renamed:
+                    label += "  (" + std::string(m_baseline.nameOf(change.before)) + ")";
+                    break;
+                case snapshot::ChangeKind::Reparented:
+                {
+                    const uint32_t parent = m_comparison.nodes[change.after].parent;
+                    label += "  -> " + (parent != snapshot::kNone ? std::string(m_comparison.nameOf(parent)) : "/");
+                    break;
+                }
+                case snapshot::ChangeKind::ActivityChanged:
+                    label += m_comparison.nodes[change.after].flags & snapshot::NodeActive ? "  (on)" : "  (off)";
+                    break;
+                default:
+                    if (change.count > 1) label += "  (" + std::to_string(change.count) + ")";
+                    break;
+                }
+
+                const uint32_t index = m_scene.findByInstanceId(change.instanceId);
+                const bool selected = index != SceneArena::kInvalid && index == selectedNode();
+                ImGui::PushID(static_cast<int>(begin + row));
+                if (ImGui::Selectable(label.c_str(), selected) && index != SceneArena::kInvalid)
+                {
+                    m_selection = m_scene.ref(index);
+                }
+                ImGui::PopID();
             }
         }
+        ImGui::TreePop();
     }
-    catch (...)
+    ImGui::EndChild();
+    ImGui::Spacing();
+}
+
+void UnityExplorer::setLiveTracking(bool enabled)
+{
+    if (enabled && !ObjectRegistry::getInstance().install())
+    {
+        LOG_ERROR("[UnityExplorer] Live object tracking is not available in this game");
+        return;
+    }
+    if (!enabled)
+    {
+        ObjectRegistry::getInstance().uninstall();
+    }
+
+    m_liveTracking = enabled;
+
+    // Seed the tree with one scan; from then on the journal keeps it current
+    if (enabled) m_needsRefresh = true;
+}
+
+void UnityExplorer::markSceneDirty(int scene)
+{
+    if (!m_lazyHierarchy)
+    {
+        m_needsRefresh = true;
+        return;
+    }
+
+    if (std::find(m_dirtyScenes.begin(), m_dirtyScenes.end(), scene) == m_dirtyScenes.end())
     {
+        m_dirtyScenes.push_back(scene);
     }
+}
 
-    return "Component";
+void UnityExplorer::onRefreshCommitted()
+{
+    m_lastRefreshStats = m_builder.getStats();
+    m_view.invalidate(); // active flags may have changed without a structural change
+    m_fuzzy.invalidate();
+    m_components.invalidate();
+    m_sampler.invalidate(); // destroyed objects' addresses may be reused
+
+    LOG_INFO("[UnityExplorer] Scene refreshed in %.2f ms over %d frame(s). %zu objects, %zu roots (+%zu -%zu ~%zu), "
+             "%lld bytes GC", m_lastRefreshStats.elapsedMs, m_lastRefreshStats.frames, m_lastRefreshStats.total,
+             m_scene.rootCount(), m_lastRefreshStats.added, m_lastRefreshStats.removed, m_lastRefreshStats.reparented,
+             static_cast<long long>(m_lastRefreshStats.managedBytes));
+}
+
+void UnityExplorer::setLazyHierarchy(bool enabled)
+{
+    m_lazyHierarchy = enabled;
+
+    // Nodes from one mode carry no meaning for the other (children loaded or not), so start over
+    m_builder.cancel();
+    m_valueSearch.cancel();
+    m_spatial.cancel();
+    m_scene.clear();
+    m_selection = {};
+    m_pendingExpand.clear();
+    m_dirtyScenes.clear();
+    m_needsRefresh = true;
+}
+
+void UnityExplorer::loadExpandedNodes()
+{
+    for (uint32_t index : m_pendingExpand)
+    {
+        if (index < m_scene.capacity() && m_scene[index].isAlive())
+        {
+            m_builder.loadChildren(m_scene, index);
+        }
+    }
+    m_pendingExpand.clear();
 }
 
 std::string UnityExplorer::getSafeString(UnityResolve::UnityType::String* unityStr)
@@ -920,11 +2411,11 @@ std::string UnityExplorer::formatColor(const UnityResolve::UnityType::Color& col
     return std::string(buffer);
 }
 
-bool UnityExplorer::matchesFilter(const std::string& name, const std::string& filter)
+bool UnityExplorer::matchesFilter(std::string_view name, const std::string& filter)
 {
     if (filter.empty()) return true;
 
-    std::string lowerName = name;
+    std::string lowerName(name);
     std::string lowerFilter = filter;
 
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), tolower);
@@ -933,12 +2424,21 @@ bool UnityExplorer::matchesFilter(const std::string& name, const std::string& fi
     return lowerName.find(lowerFilter) != std::string::npos;
 }
 
-void UnityExplorer::renderVector3Field(const char* label, const UnityResolve::UnityType::Vector3& vec, bool readOnly)
+bool UnityExplorer::renderVector3Field(const char* label, UnityResolve::UnityType::Vector3& vec, bool readOnly)
 {
     ImGui::Text("%s:", label);
     ImGui::SameLine();
     ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 20);
 
+    if (!readOnly)
+    {
+        ImGui::PushID(label);
+        ImGui::SetNextItemWidth(300.0f);
+        const bool edited = itemEdited(ImGui::DragFloat3("##value", &vec.x, 0.01f));
+        ImGui::PopID();
+        return edited;
+    }
+
     // Color code the values for better readability
     ImGui::Text("X: ");
     ImGui::SameLine();
@@ -953,15 +2453,24 @@ void UnityExplorer::renderVector3Field(const char* label, const UnityResolve::Un
     ImGui::Text("Z: ");
     ImGui::SameLine();
     ImGui::TextColored(ImVec4(0.5f, 0.5f, 1.0f, 1.0f), "%.3f", vec.z);
+    return false;
 }
 
-void UnityExplorer::renderQuaternionField(const char* label, const UnityResolve::UnityType::Quaternion& quat,
-                                          bool readOnly)
+bool UnityExplorer::renderQuaternionField(const char* label, UnityResolve::UnityType::Quaternion& quat, bool readOnly)
 {
     ImGui::Text("%s:", label);
     ImGui::SameLine();
     ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 20);
 
+    if (!readOnly)
+    {
+        ImGui::PushID(label);
+        ImGui::SetNextItemWidth(400.0f);
+        const bool edited = itemEdited(ImGui::DragFloat4("##value", &quat.x, 0.001f, -1.0f, 1.0f));
+        ImGui::PopID();
+        return edited;
+    }
+
     // Color code the values for better readability
     ImGui::Text("X: ");
     ImGui::SameLine();
@@ -981,14 +2490,24 @@ void UnityExplorer::renderQuaternionField(const char* label, const UnityResolve:
     ImGui::Text("W: ");
     ImGui::SameLine();
     ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.5f, 1.0f), "%.3f", quat.w);
+    return false;
 }
 
-void UnityExplorer::renderColorField(const char* label, const UnityResolve::UnityType::Color& color, bool readOnly)
+bool UnityExplorer::renderColorField(const char* label, UnityResolve::UnityType::Color& color, bool readOnly)
 {
     ImGui::Text("%s:", label);
     ImGui::SameLine();
     ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 20);
 
+    if (!readOnly)
+    {
+        ImGui::PushID(label);
+        ImGui::SetNextItemWidth(300.0f);
+        const bool edited = itemEdited(ImGui::ColorEdit4("##value", &color.r, ImGuiColorEditFlags_Float));
+        ImGui::PopID();
+        return edited;
+    }
+
     ImVec4 colorVec(color.r, color.g, color.b, color.a);
     ImGui::ColorButton("##color", colorVec, ImGuiColorEditFlags_NoTooltip | ImGuiColorEditFlags_NoInputs);
     ImGui::SameLine();
@@ -1012,6 +2531,7 @@ void UnityExplorer::renderColorField(const char* label, const UnityResolve::Unit
     ImGui::Text("A: ");
     ImGui::SameLine();
     ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "%.3f", color.a);
+    return false;
 }
 
 void UnityExplorer::helpMarker(const char* desc)
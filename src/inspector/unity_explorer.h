@@ -1,43 +1,127 @@
 ﻿#pragma once
 
+#include "change_tracker.h"
+#include "component_cache.h"
+#include "edit_queue.h"
+#include "field_layout.h"
+#include "fuzzy_search.h"
+#include "game_tick.h"
+#include "hierarchy_builder.h"
+#include "hierarchy_view.h"
+#include "property_sampler.h"
+#include "scene_arena.h"
+#include "scene_events.h"
+#include "snapshot_exporter.h"
+#include "spatial_index.h"
+#include "snapshot/snapshot_diff.h"
+#include "transform_sampler.h"
+#include "value_search.h"
+#include "watch_list.h"
+
 class UnityExplorer
 {
-public:
-    struct GameObjectNode
-    {
-        UnityResolve::UnityType::GameObject* gameObject = nullptr;
-        UnityResolve::UnityType::Transform* transform = nullptr;
-        std::string name;
-        std::vector<std::shared_ptr<GameObjectNode>> children;
-        bool expanded = false;
-        int depth = 0;
-        bool isActive = true;
-    };
-
 private:
     // UI State
     bool m_showSceneExplorer = true;
     bool m_showObjectInspector = true;
     bool m_showInactiveObjects = false;
+    bool m_showValueSearch = false;
+    bool m_showSpatialQuery = false;
+    bool m_showWatchList = false;
+    bool m_showFieldChanges = false;
+    bool m_showEditJournal = false;
     bool m_autoRefresh = false;
+    // Only scene roots are scanned and children load when a node is expanded. Opt-in: the roots come from
+    // SceneManager, which does not list DontDestroyOnLoad, so those objects are missing in this mode.
+    bool m_lazyHierarchy = false;
+    bool m_liveTracking = false; // patch the tree from Instantiate/Destroy hooks instead of rescanning
     bool m_initialized = false;
 
     // Search and filtering
     char m_searchBuffer[256] = "";
     std::string m_searchFilter;
 
+    struct SearchComparison
+    {
+        std::string query;
+        size_t objects = 0;
+        size_t matches = 0;
+        double linearMs = 0.0;  // matchesFilter() on every object
+        double indexedMs = 0.0; // trigram index query, averaged
+
+        double speedup() const { return indexedMs > 0.0 ? linearMs / indexedMs : 0.0; }
+    };
+    SearchComparison m_searchComparison;
+    bool m_fuzzySearch = false;
+    FuzzySearch m_fuzzy; // ranked results beside the tree while fuzzy search is on
+    char m_valueSearchBuffer[256] = "";
+    ValueSearch m_valueSearch; // stepped every frame while running, like the scene scan
+
+    // Spatial queries
+    SpatialIndex m_spatial;
+    bool m_spatialTracking = true; // refit moved objects while the Spatial Query window is open
+    bool m_pickInGameView = false; // the next click outside the overlay selects the object under the cursor
+    float m_queryRadius = 10.0f;
+    float m_queryBoxMin[3] = {-10.0f, -10.0f, -10.0f};
+    float m_queryBoxMax[3] = {10.0f, 10.0f, 10.0f};
+    std::vector<SpatialIndex::Hit> m_spatialHits;
+    float m_spatialQueryUs = 0.0f;
+    static constexpr uint32_t kRefitPerFrame = 16384; // transforms sampled per frame for movement
+
     // Scene data
-    std::vector<std::shared_ptr<GameObjectNode>> m_rootObjects;
-    std::shared_ptr<GameObjectNode> m_selectedObject = nullptr;
+    SceneArena m_scene;
+    NodeRef m_selection; // generation-checked, so a destroyed selection simply stops resolving
+    std::vector<uint32_t> m_pendingExpand; // nodes opened this frame whose children are not loaded yet
+    HierarchyView m_view; // visible rows of the tree, rebuilt only when structure, expansion or filter change
 
     // Caching and performance
     bool m_needsRefresh = true;
-    std::unordered_map<void*, std::shared_ptr<GameObjectNode>> m_objectCache;
+    std::vector<int> m_dirtyScenes; // scenes to rescan after a load event (lazy mode)
+    std::vector<SceneEvents::Event> m_sceneEvents;
+    std::vector<ObjectRegistry::Change> m_objectChanges;
+    HierarchyBuilder m_builder;
+    HierarchyBuilder::Stats m_lastRefreshStats;
+    int m_refreshBudgetUs = 2000; // per-frame budget of all time-sliced jobs together, 0 = finish in one frame
+    std::chrono::steady_clock::time_point m_frameDeadline; // of this frame's budget
+    static constexpr uint32_t kLivenessChecksPerFrame = 8192; // nodes checked by the liveness sweep per frame
     float m_lastRefreshTime = 0.0f;
-    float m_refreshInterval = 1.0f;
+    float m_refreshInterval = 5.0f; // destroyed objects are pruned by the liveness sweep in between
 
     // Inspector state
-    std::unordered_map<std::string, bool> m_componentExpandedState;
+    std::vector<uint8_t> m_expandedState; // by ComponentCache state key
+    ComponentRegistry m_sections{componentSections()}; // classes with a section of their own
+    ComponentCache m_components{m_sections};           // of the selected object
+    FieldLayouts m_fieldLayouts; // per component class, for renderGenericComponent
+    PropertySampler m_sampler;   // managed getters of the open sections, fetched in batches
+    TransformSoA m_worldTransform; // scratch for the Transform section's fetch
+    TransformSoA m_localTransform;
+    TransformSampler::Comparison m_samplerComparison;
+
+    // Watch list
+    WatchList m_watches;
+    std::vector<float> m_plotMin; // decimated history of the watch being drawn
+    std::vector<float> m_plotMax;
+
+    // Field change tracking
+    ChangeTracker m_changes; // scanned on the game tick, or from update() without one
+    std::string m_breakMessage;
+    static constexpr uint64_t kHighlightFrames = 30; // changed fields stay highlighted this long
+
+    // Editing
+    EditQueue m_edits;
+    bool m_editMode = false;      // inspector fields are widgets rather than text
+    uint64_t m_editGesture = 0;   // bumped when a widget is activated; its writes form one transaction
+
+    // Snapshots
+    SnapshotExporter::Options m_snapshotOptions;
+    SnapshotExporter::Result m_lastSnapshot;
+    snapshot::Capture m_baseline; // hierarchy at "Set Baseline", compared against later captures
+    snapshot::Capture m_comparison;
+    snapshot::HashedTree m_baselineTree;
+    snapshot::HashedTree m_comparisonTree;
+    snapshot::DiffResult m_diff;
+    double m_diffMs = 0.0;
+    bool m_showChanges = false;
 
 public:
     bool initialize();
@@ -61,32 +145,71 @@ private:
     // Scene Explorer
     void renderSceneExplorer();
     void refreshScene();
-    void buildHierarchy();
-    void renderGameObjectNode(std::shared_ptr<GameObjectNode> node);
-    std::shared_ptr<GameObjectNode> createGameObjectNode(UnityResolve::UnityType::GameObject* go, int depth = 0);
+    void processSceneEvents();
+    void processObjectChanges();
+    void setLiveTracking(bool enabled);
+    void markSceneDirty(int scene);
+    bool remainingBudget(uint32_t& budgetUs) const;
+    void onRefreshCommitted();
+    void renderRefreshStatus();
+    void renderGameObjectNode(const HierarchyView::Row& row);
+    void renderFuzzyResults();
+    void setLazyHierarchy(bool enabled);
+    void loadExpandedNodes();
+    uint32_t selectedNode() const { return m_scene.resolve(m_selection); }
+    bool hasSelection() const { return selectedNode() != SceneArena::kInvalid; }
+    void pruneDeadNodes();
+    void benchmarkTransformSampler();
+    void benchmarkSearch();
+    void saveSnapshot();
+    void setBaseline();
+    void compareWithBaseline();
+    void renderChangeView();
+    void renderValueSearch();
+    void renderSpatialQuery();
+    void pickInGameView();
+    void selectFromResults(NodeRef node);
+    void renderWatchList();
+    void renderWatchPlot(int id, const WatchList::Stats& stats);
+    void renderFieldChanges();
+    void showBreak(const ChangeTracker::Hit& hit);
+    uint64_t currentFrame() const;
+    void renderEditJournal();
 
     // Object Inspector
+    static std::span<const ComponentRegistry::Entry> componentSections();
+    bool sectionHeader(const char* label, uint32_t stateKey);
     void renderObjectInspector();
     void renderGameObjectInfo(UnityResolve::UnityType::GameObject* gameObject);
     void renderTransformComponent(UnityResolve::UnityType::Transform* transform);
     void renderGenericComponent(UnityResolve::UnityType::Component* component, const std::string& typeName);
+    void renderFields(const FieldLayouts::Layout& layout, const uint8_t* object,
+                      UnityResolve::UnityType::Component* owner, int depth);
     void renderCameraComponent(UnityResolve::UnityType::Camera* camera);
     void renderRendererComponent(UnityResolve::UnityType::Renderer* renderer);
     void renderRigidbodyComponent(UnityResolve::UnityType::Rigidbody* rigidbody);
     void renderColliderComponent(UnityResolve::UnityType::Collider* collider);
-
-    std::string getComponentTypeName(UnityResolve::UnityType::Component* component);
+    void renderSampleCost(const char* panel);
+    void watchMenuItems(const WatchList::Spec& spec, uint8_t components);
+    void watchPropertyMenu(UnityResolve::UnityType::UnityObject* owner, const char* property, methods::TypeCode code,
+                           uint8_t components = 0);
+    std::string watchLabel(UnityResolve::UnityType::UnityObject* owner, const char* member);
+    bool itemEdited(bool changed);
+    void queuePropertyEdit(UnityResolve::UnityType::UnityObject* owner, const char* property, const void* value,
+                           uint8_t size);
+    void queueFieldEdit(UnityResolve::UnityType::Component* owner, const uint8_t* address, const void* value,
+                        uint8_t size, EditQueue::Format format, const char* name);
 
     // Utility functions
     std::string getSafeString(UnityResolve::UnityType::String* unityStr);
     std::string formatVector3(const UnityResolve::UnityType::Vector3& vec);
     std::string formatQuaternion(const UnityResolve::UnityType::Quaternion& quat);
     std::string formatColor(const UnityResolve::UnityType::Color& color);
-    bool matchesFilter(const std::string& name, const std::string& filter);
-    void renderVector3Field(const char* label, const UnityResolve::UnityType::Vector3& vec, bool readOnly = true);
-    void renderQuaternionField(const char* label, const UnityResolve::UnityType::Quaternion& quat,
-                               bool readOnly = true);
-    void renderColorField(const char* label, const UnityResolve::UnityType::Color& color, bool readOnly = true);
+    bool matchesFilter(std::string_view name, const std::string& filter);
+    // Text when readOnly, otherwise a widget; returns true if the value was edited this frame
+    bool renderVector3Field(const char* label, UnityResolve::UnityType::Vector3& vec, bool readOnly = true);
+    bool renderQuaternionField(const char* label, UnityResolve::UnityType::Quaternion& quat, bool readOnly = true);
+    bool renderColorField(const char* label, UnityResolve::UnityType::Color& color, bool readOnly = true);
 
     // ImGui helpers
     void helpMarker(const char* desc);
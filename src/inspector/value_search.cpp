@@ -0,0 +1,386 @@
+﻿#include "pch.h"
+#include "value_search.h"
+#include "name_index.h"
+#include "methods/method_helpers.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    // Number of objects tested between deadline checks; each costs a GetComponents call
+    constexpr size_t kCheckInterval = 8;
+
+    // Object header in front of the fields; field offsets count it even for value types
+    constexpr int32_t kObjectHeader = 2 * sizeof(void*);
+
+    constexpr uint32_t kFieldStatic = 0x10;
+
+    using methods::TypeCode;
+
+    bool isNumber(TypeCode kind)
+    {
+        return (kind >= TypeCode::Boolean && kind <= TypeCode::R8) || kind == TypeCode::I || kind == TypeCode::U;
+    }
+
+    bool isReference(TypeCode kind)
+    {
+        return kind == TypeCode::Class || kind == TypeCode::Object || kind == TypeCode::String ||
+            kind == TypeCode::SzArray || kind == TypeCode::GenericInst;
+    }
+
+    double readNumber(const uint8_t* address, TypeCode kind)
+    {
+        switch (kind)
+        {
+        case TypeCode::Boolean: return *address != 0 ? 1.0 : 0.0;
+        case TypeCode::Char: return *reinterpret_cast<const uint16_t*>(address);
+        case TypeCode::I1: return *reinterpret_cast<const int8_t*>(address);
+        case TypeCode::U1: return *address;
+        case TypeCode::I2: return *reinterpret_cast<const int16_t*>(address);
+        case TypeCode::U2: return *reinterpret_cast<const uint16_t*>(address);
+        case TypeCode::I4: return *reinterpret_cast<const int32_t*>(address);
+        case TypeCode::U4: return *reinterpret_cast<const uint32_t*>(address);
+        case TypeCode::I8: return static_cast<double>(*reinterpret_cast<const int64_t*>(address));
+        case TypeCode::U8: return static_cast<double>(*reinterpret_cast<const uint64_t*>(address));
+        case TypeCode::R4: return *reinterpret_cast<const float*>(address);
+        case TypeCode::R8: return *reinterpret_cast<const double*>(address);
+        case TypeCode::I: return static_cast<double>(*reinterpret_cast<const intptr_t*>(address));
+        case TypeCode::U: return static_cast<double>(*reinterpret_cast<const uintptr_t*>(address));
+        default: return 0.0;
+        }
+    }
+
+    std::string_view trim(std::string_view text)
+    {
+        while (!text.empty() && text.front() == ' ') text.remove_prefix(1);
+        while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
+        return text;
+    }
+
+    std::string toLower(std::string_view text)
+    {
+        std::string lower(text);
+        for (char& c : lower) c = toLowerAscii(c);
+        return lower;
+    }
+
+    std::string className(void* klass)
+    {
+        const char* name = methods::Runtime::GetClassName(klass);
+        return name ? name : "?";
+    }
+
+    // Float count of Vector2/3/4, 0 for anything else
+    uint8_t vectorComponents(void* klass)
+    {
+        const std::string name = className(klass);
+        if (name == "Vector2") return 2;
+        if (name == "Vector3") return 3;
+        if (name == "Vector4") return 4;
+        return 0;
+    }
+}
+
+bool ValueSearch::begin(const SceneArena& arena, std::string_view expression)
+{
+    cancel();
+    m_matches.clear();
+    m_error.clear();
+    m_componentsTested = 0;
+    m_frames = 0;
+    m_elapsedMs = 0.0f;
+    m_expression = expression;
+    m_accessorIds.clear();
+    m_accessors.clear();
+    if (!parse(expression)) return false;
+
+    for (uint32_t index = 0; index < arena.capacity(); index++)
+    {
+        if (arena[index].isLinked()) m_queue.push_back(arena.ref(index));
+    }
+    m_startTime = Clock::now();
+    m_running = true;
+    return true;
+}
+
+void ValueSearch::cancel()
+{
+    m_running = false;
+    m_queue.clear();
+    m_cursor = 0;
+}
+
+bool ValueSearch::parse(std::string_view expression)
+{
+    static constexpr std::pair<std::string_view, Compare> operators[] = {
+        {"<=", Compare::LessEqual}, {">=", Compare::GreaterEqual}, {"==", Compare::Equal},
+        {"!=", Compare::NotEqual},  {"<", Compare::Less},          {">", Compare::Greater},
+        {"=", Compare::Equal},
+    };
+
+    const size_t at = expression.find_first_of("<>=!");
+    if (at == std::string_view::npos)
+    {
+        m_error = "expected Component.member < value (or <=, >, >=, ==, !=)";
+        return false;
+    }
+    size_t length = 0;
+    for (const auto& [text, compare] : operators)
+    {
+        if (expression.substr(at, text.size()) == text)
+        {
+            m_compare = compare;
+            length = text.size();
+            break;
+        }
+    }
+    if (length == 0)
+    {
+        m_error = "unknown operator";
+        return false;
+    }
+
+    // Left side: Component.member[.member...]
+    m_members.clear();
+    std::string_view path = trim(expression.substr(0, at));
+    while (!path.empty())
+    {
+        const size_t dot = path.find('.');
+        const std::string_view part = trim(path.substr(0, dot));
+        if (part.empty()) break;
+        m_members.emplace_back(part);
+        if (dot == std::string_view::npos)
+        {
+            path = {};
+            break;
+        }
+        path.remove_prefix(dot + 1);
+    }
+    if (!path.empty() || m_members.size() < 2)
+    {
+        m_error = "expected Component.member on the left, e.g. Rigidbody.velocity.magnitude";
+        return false;
+    }
+    m_component = toLower(m_members.front());
+    m_members.erase(m_members.begin());
+
+    // Right side: a number, true or false
+    const std::string operand(trim(expression.substr(at + length)));
+    const std::string lower = toLower(operand);
+    if (lower == "true" || lower == "false")
+    {
+        m_operand = lower == "true" ? 1.0 : 0.0;
+        return true;
+    }
+    char* end = nullptr;
+    m_operand = std::strtod(operand.c_str(), &end);
+    if (operand.empty() || end != operand.c_str() + operand.size())
+    {
+        m_error = "expected a number, true or false after the operator";
+        return false;
+    }
+    return true;
+}
+
+const ValueSearch::Accessor& ValueSearch::accessorFor(void* klass)
+{
+    auto [it, inserted] = m_accessorIds.try_emplace(klass, static_cast<uint32_t>(m_accessors.size()));
+    if (inserted) m_accessors.push_back(resolve(klass));
+    return m_accessors[it->second];
+}
+
+ValueSearch::Accessor ValueSearch::resolve(void* klass)
+{
+    Accessor accessor;
+
+    // The component may be named by its own class or by any base class
+    bool named = false;
+    for (void* current = klass; current && !named; current = methods::Runtime::GetClassParent(current))
+    {
+        const char* name = methods::Runtime::GetClassName(current);
+        named = name && toLower(name) == m_component;
+    }
+    if (!named) return accessor;
+
+    auto fail = [&](const std::string& message)
+    {
+        if (m_error.empty()) m_error = className(klass) + ": " + message;
+        accessor.steps.clear();
+        return accessor;
+    };
+
+    void* current = klass;
+    bool currentInline = false; // the component itself is a reference
+    for (size_t i = 0; i < m_members.size(); i++)
+    {
+        const std::string& member = m_members[i];
+        const bool last = i + 1 == m_members.size();
+        Step step = {};
+        void* type = nullptr;
+
+        const uint8_t floats = currentInline ? vectorComponents(current) : 0;
+        if (floats > 0 && (member == "magnitude" || member == "sqrMagnitude"))
+        {
+            if (!last) return fail(member + " is a number");
+            step.kind = member == "magnitude" ? Step::Magnitude : Step::SqrMagnitude;
+            step.components = floats;
+            step.code = TypeCode::R4;
+            accessor.steps.push_back(step);
+            break;
+        }
+
+        if (void* field = methods::Runtime::GetFieldFromName(current, member.c_str()))
+        {
+            if (methods::Runtime::GetFieldFlags(field) & kFieldStatic) return fail(member + " is static");
+            step.kind = Step::Field;
+            step.offset = methods::Runtime::GetFieldOffset(field);
+            type = methods::Runtime::GetFieldType(field);
+        }
+        else if (void* getter = currentInline ? nullptr : methods::Runtime::GetPropertyGetter(current, member.c_str()))
+        {
+            step.kind = Step::Property;
+            step.getter = getter;
+            type = methods::Runtime::GetMethodReturnType(getter);
+        }
+        else
+        {
+            return fail("no field or property '" + member + "' on " + className(current));
+        }
+
+        void* next = methods::Runtime::GetTypeClass(type);
+        step.code = methods::Runtime::GetTypeCode(type);
+        if (step.code == TypeCode::ValueType && methods::Runtime::IsEnum(next))
+        {
+            // Enums compare by their underlying integer
+            step.code = methods::Runtime::GetTypeCode(methods::Runtime::GetEnumBaseType(next));
+        }
+        step.inlineResult = step.code == TypeCode::ValueType ||
+            (step.code == TypeCode::GenericInst && methods::Runtime::IsValueType(next));
+
+        if (last && !isNumber(step.code)) return fail(member + " is not a number or bool");
+        if (!last && !step.inlineResult && !isReference(step.code)) return fail(member + " has no members");
+        if (step.offset < 0) return fail("could not read the offset of " + member);
+
+        accessor.steps.push_back(step);
+        current = next;
+        currentInline = step.inlineResult;
+    }
+
+    accessor.valid = true;
+    return accessor;
+}
+
+bool ValueSearch::evaluate(const Accessor& accessor, void* component, double& value) const
+{
+    // `base` is where field offsets count from: an object, a boxed value, or an inline struct minus the header
+    auto base = static_cast<const uint8_t*>(component);
+    for (size_t i = 0; i < accessor.steps.size(); i++)
+    {
+        const Step& step = accessor.steps[i];
+        const bool last = i + 1 == accessor.steps.size();
+
+        if (step.kind == Step::Magnitude || step.kind == Step::SqrMagnitude)
+        {
+            const auto* floats = reinterpret_cast<const float*>(base + kObjectHeader);
+            double sum = 0.0;
+            for (uint8_t c = 0; c < step.components; c++) sum += static_cast<double>(floats[c]) * floats[c];
+            value = step.kind == Step::Magnitude ? std::sqrt(sum) : sum;
+            return true;
+        }
+
+        const uint8_t* result;
+        if (step.kind == Step::Field)
+        {
+            result = base + step.offset;
+        }
+        else
+        {
+            // The getter returns references as is and boxes value types
+            auto object = static_cast<const uint8_t*>(
+                methods::Runtime::InvokeGetter(step.getter, const_cast<uint8_t*>(base)));
+            if (!object) return false;
+            if (!isReference(step.code) || step.inlineResult) object += kObjectHeader;
+            result = object;
+        }
+
+        if (last)
+        {
+            value = readNumber(result, step.code);
+            return true;
+        }
+        if (step.inlineResult)
+        {
+            base = result - kObjectHeader;
+        }
+        else
+        {
+            base = step.kind == Step::Field ? *reinterpret_cast<const uint8_t* const*>(result) : result;
+            if (!base) return false;
+        }
+    }
+    return false;
+}
+
+bool ValueSearch::test(double value) const
+{
+    switch (m_compare)
+    {
+    case Compare::Less: return value < m_operand;
+    case Compare::LessEqual: return value <= m_operand;
+    case Compare::Greater: return value > m_operand;
+    case Compare::GreaterEqual: return value >= m_operand;
+    case Compare::Equal: return value == m_operand;
+    case Compare::NotEqual: return value != m_operand;
+    }
+    return false;
+}
+
+bool ValueSearch::step(const SceneArena& arena, uint32_t budgetUs)
+{
+    if (!m_running) return false;
+
+    const auto deadline = budgetUs > 0 ? Clock::now() + std::chrono::microseconds(budgetUs) : Clock::time_point::max();
+    m_frames++;
+
+    while (m_cursor < m_queue.size())
+    {
+        // Nodes removed or reused since the search started are skipped
+        const uint32_t index = arena.resolve(m_queue[m_cursor++]);
+        if (index != SceneArena::kInvalid && arena.isLive(index))
+        {
+            static auto componentClass = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Component");
+            try
+            {
+                for (auto component : arena[index].gameObject->GetComponents<UnityResolve::UnityType::Component*>(
+                         componentClass))
+                {
+                    if (!component) continue;
+                    const Accessor& accessor = accessorFor(methods::Runtime::GetObjectClass(component));
+                    if (!accessor.valid) continue;
+
+                    m_componentsTested++;
+                    double value = 0.0;
+                    if (evaluate(accessor, component, value) && test(value))
+                    {
+                        m_matches.push_back({m_queue[m_cursor - 1], value});
+                        break; // one row per object
+                    }
+                }
+            }
+            catch (...)
+            {
+            }
+        }
+
+        if (m_cursor % kCheckInterval == 0 && Clock::now() >= deadline) break;
+    }
+
+    m_elapsedMs = std::chrono::duration<float, std::milli>(Clock::now() - m_startTime).count();
+    if (m_cursor < m_queue.size()) return false;
+
+    LOG_INFO("[ValueSearch] '%s': %zu matches in %zu objects (%zu components tested), %.1f ms over %d frame(s)",
+             m_expression.c_str(), m_matches.size(), m_queue.size(), m_componentsTested, m_elapsedMs, m_frames);
+    m_running = false;
+    return true;
+}
@@ -0,0 +1,107 @@
+﻿#pragma once
+
+#include "scene_arena.h"
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Search by component data instead of names, e.g. "Health.currentHealth < 10" or
+// "Rigidbody.velocity.magnitude > 50". The left side names a component class (or a base class) followed by a
+// chain of fields and properties; value type members such as Vector3.x are read in place, and Vector2/3/4
+// also offer magnitude and sqrMagnitude. Member paths are resolved once per runtime class through the
+// scripting backend's reflection API, so testing an object is a component lookup plus a few memory reads
+// (property getters are invoked). Like the hierarchy scan, the search is resumable: each step() tests objects
+// for a time budget and appends its matches, so results stream in over several frames and can be cancelled.
+class ValueSearch
+{
+public:
+    struct Match
+    {
+        NodeRef node;
+        double value;
+    };
+
+    // Parse the expression and queue every linked node. Returns false, with getError() set, if it does not parse.
+    bool begin(const SceneArena& arena, std::string_view expression);
+    void cancel();
+
+    // Test objects for at most budgetUs (0 = until done). Returns true when the search finished in this call.
+    bool step(const SceneArena& arena, uint32_t budgetUs);
+
+    bool isRunning() const { return m_running; }
+    float getProgress() const { return m_queue.empty() ? 1.0f : static_cast<float>(m_cursor) / m_queue.size(); }
+    const std::vector<Match>& matches() const { return m_matches; } // in scan order, grows while running
+    const std::string& getError() const { return m_error; } // parse error, or the first path that did not resolve
+    const std::string& getExpression() const { return m_expression; }
+    size_t getScanned() const { return m_cursor; }
+    size_t getQueued() const { return m_queue.size(); }
+    size_t getComponentsTested() const { return m_componentsTested; }
+    float getElapsedMs() const { return m_elapsedMs; }
+    int getFrames() const { return m_frames; }
+
+private:
+    enum class Compare : uint8_t
+    {
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual,
+    };
+
+    struct Step
+    {
+        enum Kind : uint8_t
+        {
+            Field,        // read at offset from the current object or inline struct
+            Property,     // invoke the getter on the current object
+            Magnitude,    // of an inline Vector2/3/4
+            SqrMagnitude,
+        };
+
+        Kind kind;
+        uint8_t components = 0; // Magnitude: float count
+        int32_t offset = 0;
+        void* getter = nullptr;
+        methods::TypeCode code = methods::TypeCode::Unknown; // element type of the result
+        bool inlineResult = false; // result is a struct read in place (or a boxed value) rather than a reference
+    };
+
+    // Member path resolved against one runtime class; empty when that class is not the searched component
+    struct Accessor
+    {
+        std::vector<Step> steps;
+        bool valid = false;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    std::string m_expression;
+    std::string m_component; // lowercase class name
+    std::vector<std::string> m_members;
+    Compare m_compare = Compare::Equal;
+    double m_operand = 0.0;
+
+    std::unordered_map<void*, uint32_t> m_accessorIds; // runtime class -> m_accessors
+    std::vector<Accessor> m_accessors;
+
+    std::vector<NodeRef> m_queue;
+    size_t m_cursor = 0;
+    std::vector<Match> m_matches;
+    std::string m_error;
+    bool m_running = false;
+    size_t m_componentsTested = 0;
+    Clock::time_point m_startTime;
+    float m_elapsedMs = 0.0f;
+    int m_frames = 0;
+
+    bool parse(std::string_view expression);
+    const Accessor& accessorFor(void* klass);
+    Accessor resolve(void* klass);
+    bool evaluate(const Accessor& accessor, void* component, double& value) const;
+    bool test(double value) const;
+};
@@ -0,0 +1,207 @@
+﻿#include "pch.h"
+#include "watch_list.h"
+#include "native_object.h"
+#include "methods/method_helpers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    using methods::TypeCode;
+
+    float readNumber(const uint8_t* address, TypeCode code)
+    {
+        switch (code)
+        {
+        case TypeCode::Boolean: return *address != 0 ? 1.0f : 0.0f;
+        case TypeCode::Char:
+        case TypeCode::U2: return *reinterpret_cast<const uint16_t*>(address);
+        case TypeCode::I1: return *reinterpret_cast<const int8_t*>(address);
+        case TypeCode::U1: return *address;
+        case TypeCode::I2: return *reinterpret_cast<const int16_t*>(address);
+        case TypeCode::I4: return static_cast<float>(*reinterpret_cast<const int32_t*>(address));
+        case TypeCode::U4: return static_cast<float>(*reinterpret_cast<const uint32_t*>(address));
+        case TypeCode::I8: return static_cast<float>(*reinterpret_cast<const int64_t*>(address));
+        case TypeCode::U8: return static_cast<float>(*reinterpret_cast<const uint64_t*>(address));
+        case TypeCode::R4: return *reinterpret_cast<const float*>(address);
+        case TypeCode::R8: return static_cast<float>(*reinterpret_cast<const double*>(address));
+        case TypeCode::I: return static_cast<float>(*reinterpret_cast<const intptr_t*>(address));
+        case TypeCode::U: return static_cast<float>(*reinterpret_cast<const uintptr_t*>(address));
+        default: return 0.0f;
+        }
+    }
+}
+
+WatchList::WatchList()
+{
+    for (size_t i = 0; i < kMaxWatches; i++) m_slots.push_back(std::make_unique<Slot>());
+}
+
+int WatchList::add(const Spec& spec)
+{
+    for (size_t i = 0; i < m_slots.size(); i++)
+    {
+        Slot& slot = *m_slots[i];
+        if (slot.state.load(std::memory_order_acquire) != Free) continue;
+
+        slot.spec = spec;
+        slot.ring.reset();
+        slot.dropped.store(0, std::memory_order_relaxed);
+        slot.dead.store(false, std::memory_order_relaxed);
+        slot.history.assign(kHistory, 0.0f);
+        slot.head = 0;
+        slot.count = 0;
+        slot.state.store(Active, std::memory_order_release); // publishes the spec to the producer
+        m_ids.push_back(static_cast<int>(i));
+        return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void WatchList::remove(int id)
+{
+    auto it = std::find(m_ids.begin(), m_ids.end(), id);
+    if (it == m_ids.end()) return;
+    m_ids.erase(it);
+
+    Slot& slot = *m_slots[id];
+    slot.history.clear();
+    slot.history.shrink_to_fit();
+    slot.state.store(Removing, std::memory_order_release);
+}
+
+void WatchList::clear()
+{
+    while (!m_ids.empty()) remove(m_ids.back());
+}
+
+bool WatchList::read(const Spec& spec, float& value)
+{
+    if (!NativeObjectLayout::getCachedPtr(spec.owner)) return false;
+
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(spec.owner);
+    if (spec.getter)
+    {
+        base = static_cast<const uint8_t*>(methods::Runtime::InvokeGetter(spec.getter, spec.owner));
+        if (!base) return false;
+    }
+
+    const uint8_t* address = base + spec.offset;
+    if (spec.components == 0)
+    {
+        value = readNumber(address, spec.code);
+        return true;
+    }
+
+    const auto* v = reinterpret_cast<const float*>(address);
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < spec.components; i++) sum += v[i] * v[i];
+    value = std::sqrt(sum);
+    return true;
+}
+
+void WatchList::sample()
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& slotPtr : m_slots)
+    {
+        Slot& slot = *slotPtr;
+        const uint8_t state = slot.state.load(std::memory_order_acquire);
+        if (state == Removing)
+        {
+            slot.state.store(Free, std::memory_order_release);
+            continue;
+        }
+        if (state != Active || slot.dead.load(std::memory_order_relaxed)) continue;
+
+        float value = 0.0f;
+        bool ok = false;
+        try
+        {
+            ok = read(slot.spec, value);
+        }
+        catch (...)
+        {
+        }
+        if (!ok)
+        {
+            slot.dead.store(true, std::memory_order_relaxed);
+            continue;
+        }
+        if (!slot.ring.push(value)) slot.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_sampleUs.store(std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count(),
+                     std::memory_order_relaxed);
+}
+
+void WatchList::drain()
+{
+    m_scratch.resize(decltype(Slot::ring)::capacity());
+    for (int id : m_ids)
+    {
+        Slot& slot = *m_slots[id];
+        const size_t count = slot.ring.pop(m_scratch.data(), m_scratch.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            slot.history[slot.head] = m_scratch[i];
+            slot.head = (slot.head + 1) % kHistory;
+        }
+        slot.count = std::min(slot.count + count, kHistory);
+    }
+}
+
+WatchList::Stats WatchList::stats(int id) const
+{
+    const Slot& slot = *m_slots[id];
+    Stats stats;
+    stats.count = slot.count;
+    stats.dropped = slot.dropped.load(std::memory_order_relaxed);
+    stats.dead = slot.dead.load(std::memory_order_relaxed);
+    if (slot.count == 0) return stats;
+
+    stats.last = slot.history[(slot.head + kHistory - 1) % kHistory];
+    const size_t first = (slot.head + kHistory - slot.count) % kHistory;
+    stats.min = stats.max = slot.history[first];
+    for (size_t i = 0; i < slot.count; i++)
+    {
+        const float value = slot.history[(first + i) % kHistory];
+        stats.min = std::min(stats.min, value);
+        stats.max = std::max(stats.max, value);
+    }
+    return stats;
+}
+
+size_t WatchList::decimate(int id, size_t buckets, std::vector<float>& mins, std::vector<float>& maxs) const
+{
+    const Slot& slot = *m_slots[id];
+    buckets = std::min(buckets, slot.count);
+    mins.resize(buckets);
+    maxs.resize(buckets);
+    if (buckets == 0) return 0;
+
+    const size_t first = (slot.head + kHistory - slot.count) % kHistory;
+    for (size_t bucket = 0; bucket < buckets; bucket++)
+    {
+        // Spans cover the history exactly; lengths differ by at most one sample
+        const size_t begin = bucket * slot.count / buckets;
+        const size_t end = (bucket + 1) * slot.count / buckets;
+        float low = slot.history[(first + begin) % kHistory];
+        float high = low;
+        for (size_t i = begin + 1; i < end; i++)
+        {
+            const float value = slot.history[(first + i) % kHistory];
+            low = std::min(low, value);
+            high = std::max(high, value);
+        }
+        mins[bucket] = low;
+        maxs[bucket] = high;
+    }
+    return buckets;
+}
+
+void WatchList::onTick(void* context)
+{
+    static_cast<WatchList*>(context)->sample();
+}
@@ -0,0 +1,96 @@
+﻿#pragma once
+
+#include "utils/spsc_ring.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Numeric values pinned from the inspector and recorded every game frame for plotting. sample() runs on the
+// game's main thread (see GameTick) and reads each watch, from object memory at a field offset or through a
+// property getter, into a per-watch single-producer single-consumer ring; drain() on the UI side moves what
+// arrived into a history of about a minute. Neither side waits for the other: a full ring drops samples and
+// counts them. Watches live in fixed slots whose state hands them between the two threads, so adding and
+// removing one never touches a slot the sampler is reading.
+class WatchList
+{
+public:
+    static constexpr size_t kMaxWatches = 32;
+    static constexpr size_t kHistory = 60 * 144; // samples kept per watch: 60 s at 144 FPS
+
+    struct Spec
+    {
+        std::string label;
+        UnityResolve::UnityType::UnityObject* owner = nullptr; // read stops once it is destroyed
+        void* getter = nullptr; // property getter invoked on owner; null to read memory at owner + offset
+        int32_t offset = 0;     // of the value, in the owner or in the getter's boxed result
+        methods::TypeCode code = methods::TypeCode::R4;
+        uint8_t components = 0; // Vector2/3/4 at offset: read as magnitude; 0 for a scalar
+    };
+
+    struct Stats
+    {
+        float last = 0.0f;
+        float min = 0.0f;
+        float max = 0.0f;
+        size_t count = 0;     // samples in the history
+        uint32_t dropped = 0; // lost to a full ring
+        bool dead = false;    // owner destroyed or getter failed
+    };
+
+    WatchList();
+
+    // Returns the watch id, or -1 if all slots are taken
+    int add(const Spec& spec);
+    void remove(int id);
+    void clear();
+
+    // Producer: read every watch once. Game thread, or the UI thread when there is no game tick.
+    void sample();
+    // Consumer: move new samples into the histories. UI thread, once per frame.
+    void drain();
+
+    // Ids of the active watches, in slot order
+    const std::vector<int>& ids() const { return m_ids; }
+    const Spec& spec(int id) const { return m_slots[id]->spec; }
+    Stats stats(int id) const;
+
+    // Min and max of `buckets` equal spans of the history, oldest first, so a plot draws one vertical span per
+    // pixel column however long the history is. Returns the bucket count actually filled.
+    size_t decimate(int id, size_t buckets, std::vector<float>& mins, std::vector<float>& maxs) const;
+
+    float getSampleUs() const { return m_sampleUs.load(std::memory_order_relaxed); }
+
+    // GameTick callback; context is the WatchList
+    static void onTick(void* context);
+
+private:
+    enum State : uint8_t
+    {
+        Free,     // owned by the UI
+        Active,   // sampled by the producer; spec is read-only
+        Removing, // UI asked for release; the producer hands it back as Free
+    };
+
+    struct Slot
+    {
+        std::atomic<uint8_t> state{Free};
+        Spec spec;
+        SpscRing<float, 1024> ring;
+        std::atomic<uint32_t> dropped{0};
+        std::atomic<bool> dead{false};
+
+        // UI side only
+        std::vector<float> history; // circular, kHistory
+        size_t head = 0;
+        size_t count = 0;
+    };
+
+    std::vector<std::unique_ptr<Slot>> m_slots;
+    std::vector<int> m_ids;
+    std::vector<float> m_scratch;
+    std::atomic<float> m_sampleUs{0.0f};
+
+    static bool read(const Spec& spec, float& value);
+};
@@ -77,6 +77,21 @@ bool HookManager::disableHook(void* target)
     return false;
 }
 
+bool HookManager::removeHook(void* target)
+{
+    if (!m_initialized) return false;
+
+    auto it = std::find_if(m_hooks.begin(), m_hooks.end(),
+                           [target](const std::unique_ptr<HookInfo>& hook) { return hook->target == target; });
+    if (it == m_hooks.end()) return false;
+
+    if (MH_RemoveHook(target) != MH_OK) return false;
+
+    m_detourToOriginal.erase((*it)->detour);
+    m_hooks.erase(it);
+    return true;
+}
+
 bool HookManager::enableAllHooks()
 {
     if (!m_initialized) return false;
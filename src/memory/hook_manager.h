@@ -53,6 +53,8 @@ public:
     // Enable or disable a hook
     bool enableHook(void* target);
     bool disableHook(void* target);
+    // Restore the target and forget the hook, so it can be created again
+    bool removeHook(void* target);
 
     // Enable or disable all hooks
     bool enableAllHooks();
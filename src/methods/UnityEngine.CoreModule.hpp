@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include <UnityResolve.hpp>
 
+#include "runtime.hpp"
+
 namespace methods
 {
     struct Application
@@ -223,6 +225,28 @@ namespace methods
         }
     };
 
+    struct Time
+    {
+        static float GetTimeScale()
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Time")->Get<
+                    UnityResolve::Method>("get_timeScale");
+            if (method) return method->Invoke<float>();
+            return 1.0f;
+        }
+
+        static void SetTimeScale(float value)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Time")->Get<
+                    UnityResolve::Method>("set_timeScale");
+            if (method) method->Invoke<void>(value);
+        }
+    };
+
     struct Screen
     {
         static int GetWidth()
@@ -682,6 +706,16 @@ namespace methods
             if (method) method->Invoke<void>(gameObject, tag);
         }
 
+        static UnityResolve::UnityType::String* GetTag(UnityResolve::UnityType::GameObject* gameObject)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("GameObject")->Get<
+                    UnityResolve::Method>("get_tag");
+            if (method) return method->Invoke<UnityResolve::UnityType::String*>(gameObject);
+            return nullptr;
+        }
+
         static bool CompareTag(UnityResolve::UnityType::GameObject* gameObject, UnityResolve::UnityType::String* tag)
         {
             static UnityResolve::Method* method;
@@ -825,6 +859,36 @@ namespace methods
             if (method) method->Invoke<void>(transform, parent);
         }
 
+        static UnityResolve::UnityType::Vector3 GetLossyScale(UnityResolve::UnityType::Transform* transform)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Transform")->Get<
+                    UnityResolve::Method>("get_lossyScale");
+            if (method) return method->Invoke<UnityResolve::UnityType::Vector3>(transform);
+            return {};
+        }
+
+        static int GetChildCount(UnityResolve::UnityType::Transform* transform)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Transform")->Get<
+                    UnityResolve::Method>("get_childCount");
+            if (method) return method->Invoke<int>(transform);
+            return 0;
+        }
+
+        static UnityResolve::UnityType::Transform* GetChild(UnityResolve::UnityType::Transform* transform, int index)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Transform")->Get<
+                    UnityResolve::Method>("GetChild");
+            if (method) return method->Invoke<UnityResolve::UnityType::Transform*>(transform, index);
+            return nullptr;
+        }
+
         static void DetachChildren(UnityResolve::UnityType::Transform* transform)
         {
             static UnityResolve::Method* method;
@@ -1207,4 +1271,102 @@ namespace methods
             return nullptr;
         }
     };
+
+    struct LayerMask
+    {
+        static UnityResolve::UnityType::String* LayerToName(int layer)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("LayerMask")->Get<
+                    UnityResolve::Method>("LayerToName");
+            if (method) return method->Invoke<UnityResolve::UnityType::String*>(layer);
+            return nullptr;
+        }
+    };
+
+    // Scenes are passed around as their handle; UnityEngine.SceneManagement.Scene is a struct holding a single int
+    struct SceneManager
+    {
+        static int GetSceneCount()
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("SceneManager")->Get<
+                    UnityResolve::Method>("get_sceneCount");
+            if (method) return method->Invoke<int>();
+            return 0;
+        }
+
+        static int GetSceneAt(int index)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("SceneManager")->Get<
+                    UnityResolve::Method>("GetSceneAt");
+            if (method) return method->Invoke<int>(index);
+            return 0;
+        }
+
+        static int GetActiveScene()
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("SceneManager")->Get<
+                    UnityResolve::Method>("GetActiveScene");
+            if (method) return method->Invoke<int>();
+            return 0;
+        }
+    };
+
+    struct Scene
+    {
+        static std::vector<UnityResolve::UnityType::GameObject*> GetRootGameObjects(int handle)
+        {
+            static UnityResolve::Class* klass;
+            static UnityResolve::Method* method;
+            if (!method)
+            {
+                klass = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Scene");
+                if (klass) method = klass->Get<UnityResolve::Method>("GetRootGameObjects", {});
+            }
+            if (!method) return {};
+
+            void* self = Runtime::BoxValue(klass, &handle);
+            if (!self) return {};
+
+            auto array = method->Invoke<UnityResolve::UnityType::Array<UnityResolve::UnityType::GameObject*>*>(self);
+            return array ? array->ToVector() : std::vector<UnityResolve::UnityType::GameObject*>();
+        }
+
+        static int GetRootCount(int handle)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Scene")->Get<
+                    UnityResolve::Method>("GetRootCountInternal");
+            if (method) return method->Invoke<int>(handle);
+            return 0;
+        }
+
+        static UnityResolve::UnityType::String* GetName(int handle)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Scene")->Get<
+                    UnityResolve::Method>("GetNameInternal");
+            if (method) return method->Invoke<UnityResolve::UnityType::String*>(handle);
+            return nullptr;
+        }
+
+        static bool IsLoaded(int handle)
+        {
+            static UnityResolve::Method* method;
+            if (!method)
+                method = UnityResolve::Get("UnityEngine.CoreModule.dll")->Get("Scene")->Get<
+                    UnityResolve::Method>("GetIsLoadedInternal");
+            if (method) return method->Invoke<bool>(handle);
+            return false;
+        }
+    };
 }
@@ -0,0 +1,308 @@
+﻿#pragma once
+#include <UnityResolve.hpp>
+
+namespace methods
+{
+    // Element type codes of a runtime type; IL2CPP_TYPE_* and MONO_TYPE_* share these values
+    enum class TypeCode : uint8_t
+    {
+        Unknown = 0x00,
+        Boolean = 0x02,
+        Char = 0x03,
+        I1 = 0x04,
+        U1 = 0x05,
+        I2 = 0x06,
+        U2 = 0x07,
+        I4 = 0x08,
+        U4 = 0x09,
+        I8 = 0x0a,
+        U8 = 0x0b,
+        R4 = 0x0c,
+        R8 = 0x0d,
+        String = 0x0e,
+        ValueType = 0x11,
+        Class = 0x12,
+        Array = 0x14,
+        GenericInst = 0x15,
+        I = 0x18,
+        U = 0x19,
+        Object = 0x1c,
+        SzArray = 0x1d,
+    };
+
+    // Direct access to the scripting backend's exported C API (il2cpp_* / mono_*)
+    struct Runtime
+    {
+        static HMODULE GetModule()
+        {
+            static HMODULE module;
+            if (!module)
+            {
+                module = GetModuleHandleA("GameAssembly.dll");
+                if (!module) module = GetModuleHandleA("mono-2.0-bdwgc.dll");
+                if (!module) module = GetModuleHandleA("mono.dll");
+            }
+            return module;
+        }
+
+        static bool IsIl2Cpp()
+        {
+            static const bool il2cpp = GetModuleHandleA("GameAssembly.dll") != nullptr;
+            return il2cpp;
+        }
+
+        template <typename T>
+        static T GetExport(const char* il2cppName, const char* monoName)
+        {
+            HMODULE module = GetModule();
+            if (!module) return nullptr;
+            return reinterpret_cast<T>(GetProcAddress(module, IsIl2Cpp() ? il2cppName : monoName));
+        }
+
+        // Bytes currently in use on the managed heap; -1 if the export is missing
+        static int64_t GetGcUsedSize()
+        {
+            using GcGetUsedSize = int64_t (*)();
+            static auto getUsedSize = GetExport<GcGetUsedSize>("il2cpp_gc_get_used_size", "mono_gc_get_used_size");
+            return getUsedSize ? getUsedSize() : -1;
+        }
+
+        // Runtime class of a managed object (Il2CppClass* / MonoClass*), comparable with UnityResolve::Class::address
+        static void* GetObjectClass(void* object)
+        {
+            using ObjectGetClass = void* (*)(void*);
+            static auto getClass = GetExport<ObjectGetClass>("il2cpp_object_get_class", "mono_object_get_class");
+            return getClass && object ? getClass(object) : nullptr;
+        }
+
+        // Short name of a runtime class (no namespace); owned by the runtime
+        static const char* GetClassName(void* klass)
+        {
+            using ClassGetName = const char* (*)(void*);
+            static auto getName = GetExport<ClassGetName>("il2cpp_class_get_name", "mono_class_get_name");
+            return getName && klass ? getName(klass) : nullptr;
+        }
+
+        static void* GetClassParent(void* klass)
+        {
+            using ClassGetParent = void* (*)(void*);
+            static auto getParent = GetExport<ClassGetParent>("il2cpp_class_get_parent", "mono_class_get_parent");
+            return getParent && klass ? getParent(klass) : nullptr;
+        }
+
+        static bool IsSubclassOf(void* klass, void* parent)
+        {
+            using ClassIsSubclassOf = bool (*)(void*, void*, bool);
+            static auto isSubclassOf = GetExport<ClassIsSubclassOf>("il2cpp_class_is_subclass_of",
+                                                                    "mono_class_is_subclass_of");
+            if (!klass || !parent) return false;
+            if (klass == parent) return true;
+            return isSubclassOf && isSubclassOf(klass, parent, false);
+        }
+
+        static const char* GetClassNamespace(void* klass)
+        {
+            using ClassGetNamespace = const char* (*)(void*);
+            static auto getNamespace = GetExport<ClassGetNamespace>("il2cpp_class_get_namespace",
+                                                                    "mono_class_get_namespace");
+            return getNamespace && klass ? getNamespace(klass) : nullptr;
+        }
+
+        // Fields declared by the class itself (not its bases), one per call; `iterator` starts out null
+        static void* GetNextField(void* klass, void** iterator)
+        {
+            using ClassGetFields = void* (*)(void*, void**);
+            static auto getFields = GetExport<ClassGetFields>("il2cpp_class_get_fields", "mono_class_get_fields");
+            return getFields && klass ? getFields(klass, iterator) : nullptr;
+        }
+
+        static const char* GetFieldName(void* field)
+        {
+            using FieldGetName = const char* (*)(void*);
+            static auto getName = GetExport<FieldGetName>("il2cpp_field_get_name", "mono_field_get_name");
+            return getName && field ? getName(field) : nullptr;
+        }
+
+        // Instance or static field of a class or one of its bases (FieldInfo* / MonoClassField*)
+        static void* GetFieldFromName(void* klass, const char* name)
+        {
+            using ClassGetFieldFromName = void* (*)(void*, const char*);
+            static auto getField = GetExport<ClassGetFieldFromName>("il2cpp_class_get_field_from_name",
+                                                                    "mono_class_get_field_from_name");
+            return getField && klass ? getField(klass, name) : nullptr;
+        }
+
+        // Byte offset of an instance field from the start of the object, header included (also for value types)
+        static int32_t GetFieldOffset(void* field)
+        {
+            using FieldGetOffset = uint32_t (*)(void*);
+            static auto getOffset = GetExport<FieldGetOffset>("il2cpp_field_get_offset", "mono_field_get_offset");
+            return getOffset && field ? static_cast<int32_t>(getOffset(field)) : -1;
+        }
+
+        static uint32_t GetFieldFlags(void* field)
+        {
+            using FieldGetFlags = uint32_t (*)(void*);
+            static auto getFlags = GetExport<FieldGetFlags>("il2cpp_field_get_flags", "mono_field_get_flags");
+            return getFlags && field ? getFlags(field) : 0;
+        }
+
+        // Il2CppType* / MonoType* of a field
+        static void* GetFieldType(void* field)
+        {
+            using FieldGetType = void* (*)(void*);
+            static auto getType = GetExport<FieldGetType>("il2cpp_field_get_type", "mono_field_get_type");
+            return getType && field ? getType(field) : nullptr;
+        }
+
+        static TypeCode GetTypeCode(void* type)
+        {
+            using TypeGetType = int (*)(void*);
+            static auto getCode = GetExport<TypeGetType>("il2cpp_type_get_type", "mono_type_get_type");
+            return getCode && type ? static_cast<TypeCode>(getCode(type)) : TypeCode::Unknown;
+        }
+
+        static void* GetTypeClass(void* type)
+        {
+            using ClassFromType = void* (*)(void*);
+            static auto fromType = GetExport<ClassFromType>("il2cpp_class_from_type", "mono_class_from_mono_type");
+            return fromType && type ? fromType(type) : nullptr;
+        }
+
+        static bool IsValueType(void* klass)
+        {
+            using ClassIsValueType = bool (*)(void*);
+            static auto isValueType = GetExport<ClassIsValueType>("il2cpp_class_is_valuetype",
+                                                                  "mono_class_is_valuetype");
+            return isValueType && klass && isValueType(klass);
+        }
+
+        static bool IsEnum(void* klass)
+        {
+            using ClassIsEnum = bool (*)(void*);
+            static auto isEnum = GetExport<ClassIsEnum>("il2cpp_class_is_enum", "mono_class_is_enum");
+            return isEnum && klass && isEnum(klass);
+        }
+
+        // Bytes of an instance, object header included
+        static int32_t GetInstanceSize(void* klass)
+        {
+            using ClassInstanceSize = int32_t (*)(void*);
+            static auto instanceSize = GetExport<ClassInstanceSize>("il2cpp_class_instance_size",
+                                                                    "mono_class_instance_size");
+            return instanceSize && klass ? instanceSize(klass) : 0;
+        }
+
+        // Underlying integer type of an enum class
+        static void* GetEnumBaseType(void* klass)
+        {
+            using ClassEnumBaseType = void* (*)(void*);
+            static auto baseType = GetExport<ClassEnumBaseType>("il2cpp_class_enum_basetype",
+                                                                "mono_class_enum_basetype");
+            return baseType && klass ? baseType(klass) : nullptr;
+        }
+
+        // Getter of a property declared by a class or one of its bases; nullptr if missing or write-only
+        static void* GetPropertyGetter(void* klass, const char* name)
+        {
+            using ClassGetPropertyFromName = void* (*)(void*, const char*);
+            using PropertyGetGetMethod = void* (*)(void*);
+            static auto getProperty = GetExport<ClassGetPropertyFromName>("il2cpp_class_get_property_from_name",
+                                                                          "mono_class_get_property_from_name");
+            static auto getGetter = GetExport<PropertyGetGetMethod>("il2cpp_property_get_get_method",
+                                                                    "mono_property_get_get_method");
+            if (!getProperty || !getGetter || !klass) return nullptr;
+            void* property = getProperty(klass, name);
+            return property ? getGetter(property) : nullptr;
+        }
+
+        // Setter of a property declared by a class or one of its bases; nullptr if missing or read-only
+        static void* GetPropertySetter(void* klass, const char* name)
+        {
+            using ClassGetPropertyFromName = void* (*)(void*, const char*);
+            using PropertyGetSetMethod = void* (*)(void*);
+            static auto getProperty = GetExport<ClassGetPropertyFromName>("il2cpp_class_get_property_from_name",
+                                                                          "mono_class_get_property_from_name");
+            static auto getSetter = GetExport<PropertyGetSetMethod>("il2cpp_property_get_set_method",
+                                                                    "mono_property_get_set_method");
+            if (!getProperty || !getSetter || !klass) return nullptr;
+            void* property = getProperty(klass, name);
+            return property ? getSetter(property) : nullptr;
+        }
+
+        static void* GetMethodReturnType(void* method)
+        {
+            if (!method) return nullptr;
+            if (IsIl2Cpp())
+            {
+                using MethodGetReturnType = void* (*)(void*);
+                static auto getReturnType = GetExport<MethodGetReturnType>("il2cpp_method_get_return_type", "");
+                return getReturnType ? getReturnType(method) : nullptr;
+            }
+
+            using MethodSignature = void* (*)(void*);
+            using SignatureGetReturnType = void* (*)(void*);
+            static auto signature = GetExport<MethodSignature>("", "mono_method_signature");
+            static auto getReturnType = GetExport<SignatureGetReturnType>("", "mono_signature_get_return_type");
+            void* sig = signature ? signature(method) : nullptr;
+            return sig && getReturnType ? getReturnType(sig) : nullptr;
+        }
+
+        // Call a parameterless instance method through the runtime. Value type results come back boxed
+        // (a managed allocation per call); returns nullptr if the method threw.
+        static void* InvokeGetter(void* method, void* object)
+        {
+            using RuntimeInvoke = void* (*)(void*, void*, void**, void**);
+            static auto invoke = GetExport<RuntimeInvoke>("il2cpp_runtime_invoke", "mono_runtime_invoke");
+            if (!invoke || !method || !object) return nullptr;
+
+            void* exception = nullptr;
+            void* result = invoke(method, object, nullptr, &exception);
+            return exception ? nullptr : result;
+        }
+
+        // Call a one-argument instance method such as a property setter. Value type arguments are passed by
+        // pointer to their data (unboxed), references as the object pointer itself. Returns false if it threw.
+        static bool InvokeSetter(void* method, void* object, void* argument)
+        {
+            using RuntimeInvoke = void* (*)(void*, void*, void**, void**);
+            static auto invoke = GetExport<RuntimeInvoke>("il2cpp_runtime_invoke", "mono_runtime_invoke");
+            if (!invoke || !method || !object) return false;
+
+            void* exception = nullptr;
+            void* params[] = {argument};
+            invoke(method, object, params, &exception);
+            return exception == nullptr;
+        }
+
+        // Native implementation of an internal call, bypassing the managed wrapper. IL2CPP resolves by the full
+        // icall signature (e.g. "UnityEngine.Transform::get_position_Injected(UnityEngine.Vector3&)"), Mono by
+        // the MonoMethod of the extern method.
+        static void* ResolveICall(const char* signature, UnityResolve::Method* method)
+        {
+            if (IsIl2Cpp())
+            {
+                using ResolveIcall = void* (*)(const char*);
+                static auto resolve = GetExport<ResolveIcall>("il2cpp_resolve_icall", "");
+                return resolve ? resolve(signature) : nullptr;
+            }
+
+            using LookupInternalCall = void* (*)(void*);
+            static auto lookup = GetExport<LookupInternalCall>("", "mono_lookup_internal_call");
+            return lookup && method ? lookup(method->address) : nullptr;
+        }
+
+        // Box a value type so it can be passed as `this` to an instance method. IL2CPP method pointers of
+        // value types are adjustor thunks that expect a boxed object; Mono expects a pointer to the raw value,
+        // so there the value pointer is returned as is.
+        static void* BoxValue(UnityResolve::Class* klass, void* value)
+        {
+            if (!IsIl2Cpp()) return value;
+
+            using ValueBox = void* (*)(void*, void*);
+            static auto valueBox = GetExport<ValueBox>("il2cpp_value_box", "mono_value_box");
+            if (!valueBox || !klass) return nullptr;
+            return valueBox(klass->address, value);
+        }
+    };
+}
@@ -0,0 +1,194 @@
+﻿#include "lz4_block.h"
+
+#include <cstring>
+#include <vector>
+
+namespace snapshot::lz4
+{
+    namespace
+    {
+        constexpr size_t kMinMatch = 4;
+        constexpr size_t kLastLiterals = 5; // the block must end with at least 5 literals
+        constexpr size_t kMatchStartLimit = 12; // and the last match must start 12 bytes before the end
+        constexpr size_t kMaxOffset = 65535;
+        constexpr int kHashLog = 16;
+        constexpr size_t kSkipTrigger = 6; // search step grows by one every 64 bytes without a match
+
+        uint32_t read32(const uint8_t* p)
+        {
+            uint32_t value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        uint32_t hash(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - kHashLog);
+        }
+
+        // 15 in the token nibble, then 255-byte continuation bytes
+        bool writeLength(uint8_t*& op, const uint8_t* oend, size_t length)
+        {
+            while (length >= 255)
+            {
+                if (op >= oend) return false;
+                *op++ = 255;
+                length -= 255;
+            }
+            if (op >= oend) return false;
+            *op++ = static_cast<uint8_t>(length);
+            return true;
+        }
+
+        bool readLength(const uint8_t*& ip, const uint8_t* iend, size_t& length)
+        {
+            uint8_t byte;
+            do
+            {
+                if (ip >= iend) return false;
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+        bool writeSequence(uint8_t*& op, const uint8_t* oend, const uint8_t* literals, size_t literalLength,
+                           size_t offset, size_t matchLength)
+        {
+            if (op >= oend) return false;
+            uint8_t* token = op++;
+            *token = 0;
+
+            if (literalLength >= 15)
+            {
+                *token = 15 << 4;
+                if (!writeLength(op, oend, literalLength - 15)) return false;
+            }
+            else
+            {
+                *token = static_cast<uint8_t>(literalLength << 4);
+            }
+
+            if (static_cast<size_t>(oend - op) < literalLength) return false;
+            if (literalLength > 0) memcpy(op, literals, literalLength);
+            op += literalLength;
+
+            if (matchLength == 0) return true; // last sequence: literals only
+
+            if (oend - op < 2) return false;
+            *op++ = static_cast<uint8_t>(offset);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+
+            const size_t code = matchLength - kMinMatch;
+            if (code >= 15)
+            {
+                *token |= 15;
+                return writeLength(op, oend, code - 15);
+            }
+            *token |= static_cast<uint8_t>(code);
+            return true;
+        }
+    }
+
+    size_t compressBound(size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    size_t compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+    {
+        if (srcSize > UINT32_MAX) return 0;
+
+        uint8_t* op = dst;
+        const uint8_t* oend = dst + dstCapacity;
+        size_t anchor = 0;
+
+        if (srcSize > kMatchStartLimit)
+        {
+            std::vector<uint32_t> table(size_t(1) << kHashLog, 0);
+            const size_t matchStartLimit = srcSize - kMatchStartLimit;
+            const size_t matchEndLimit = srcSize - kLastLiterals;
+
+            size_t pos = 1;
+            table[hash(read32(src))] = 0;
+            while (pos <= matchStartLimit)
+            {
+                const uint32_t sequence = read32(src + pos);
+                const uint32_t h = hash(sequence);
+                size_t candidate = table[h];
+                table[h] = static_cast<uint32_t>(pos);
+
+                if (candidate >= pos || pos - candidate > kMaxOffset || read32(src + candidate) != sequence)
+                {
+                    pos += 1 + ((pos - anchor) >> kSkipTrigger);
+                    continue;
+                }
+
+                // Extend backwards into the pending literals, then forwards
+                while (pos > anchor && candidate > 0 && src[pos - 1] == src[candidate - 1])
+                {
+                    pos--;
+                    candidate--;
+                }
+                size_t length = kMinMatch;
+                while (pos + length < matchEndLimit && src[pos + length] == src[candidate + length]) length++;
+
+                if (!writeSequence(op, oend, src + anchor, pos - anchor, pos - candidate, length)) return 0;
+
+                pos += length;
+                anchor = pos;
+                if (pos - 2 <= matchStartLimit) table[hash(read32(src + pos - 2))] = static_cast<uint32_t>(pos - 2);
+            }
+        }
+
+        if (!writeSequence(op, oend, src + anchor, srcSize - anchor, 0, 0)) return 0;
+        return static_cast<size_t>(op - dst);
+    }
+
+    bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+    {
+        const uint8_t* ip = src;
+        const uint8_t* iend = src + srcSize;
+        uint8_t* op = dst;
+        uint8_t* oend = dst + dstSize;
+
+        while (ip < iend)
+        {
+            const uint8_t token = *ip++;
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !readLength(ip, iend, literalLength)) return false;
+            if (literalLength > static_cast<size_t>(iend - ip) || literalLength > static_cast<size_t>(oend - op))
+                return false;
+            memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            if (ip == iend) break; // the last sequence has no match
+
+            if (iend - ip < 2) return false;
+            const size_t offset = ip[0] | (ip[1] << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !readLength(ip, iend, matchLength)) return false;
+            matchLength += kMinMatch;
+            if (matchLength > static_cast<size_t>(oend - op)) return false;
+
+            const uint8_t* match = op - offset;
+            if (offset >= matchLength)
+            {
+                memcpy(op, match, matchLength);
+                op += matchLength;
+            }
+            else
+            {
+                // Overlapping copy repeats the last `offset` bytes
+                for (size_t i = 0; i < matchLength; i++) *op++ = *match++;
+            }
+        }
+
+        return op == oend;
+    }
+}
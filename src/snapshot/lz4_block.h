@@ -0,0 +1,20 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Minimal LZ4 block codec (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md). Output is a plain
+// LZ4 block without a frame header and can be decoded by LZ4_decompress_safe, and vice versa.
+namespace snapshot::lz4
+{
+    // Worst-case compressed size for `size` input bytes
+    size_t compressBound(size_t size);
+
+    // Greedy single-pass compression. Returns the compressed size, or 0 if it does not fit in `dstCapacity`
+    // or the input is larger than 4 GiB.
+    size_t compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+    // Bounds-checked decompression. Returns false on malformed input or if the output is not exactly
+    // `dstSize` bytes.
+    bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+}
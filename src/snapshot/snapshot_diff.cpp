@@ -0,0 +1,299 @@
+﻿#include "snapshot_diff.h"
+#include "snapshot_reader.h"
+#include "snapshot_writer.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace snapshot
+{
+    namespace
+    {
+        uint64_t mix(uint64_t x)
+        {
+            // splitmix64 finalizer
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+        uint64_t localHash(const NodeRecord& node, uint64_t nameHash)
+        {
+            const uint64_t id = static_cast<uint32_t>(node.instanceId);
+            return mix(id ^ (nameHash * 0x9e3779b97f4a7c15ULL) ^ (node.flags & NodeActive ? 0x5bd1e995ULL << 32 : 0));
+        }
+
+        uint32_t parentId(const HashedTree& tree, uint32_t index)
+        {
+            const uint32_t parent = tree[index].parent;
+            return parent == kNone ? kNone : static_cast<uint32_t>(tree[parent].instanceId);
+        }
+
+        bool childrenComparable(const NodeRecord& a, const NodeRecord& b)
+        {
+            return (a.flags & NodeChildrenLoaded) && (b.flags & NodeChildrenLoaded);
+        }
+
+        class Differ
+        {
+        public:
+            Differ(const HashedTree& before, const HashedTree& after, DiffResult& result)
+                : m_before(before), m_after(after), m_result(result)
+            {
+            }
+
+            void run()
+            {
+                matchSiblings(m_before.firstRoot(), m_after.firstRoot());
+                walk();
+                resolveUnmatched();
+
+                // Group by kind; within a kind the node order is preorder of the tree the change refers to
+                std::sort(m_result.changes.begin(), m_result.changes.end(), [](const Change& a, const Change& b)
+                {
+                    if (a.kind != b.kind) return a.kind < b.kind;
+                    const uint32_t indexA = a.after != kNone ? a.after : a.before;
+                    const uint32_t indexB = b.after != kNone ? b.after : b.before;
+                    return indexA < indexB;
+                });
+                for (const Change& change : m_result.changes) m_result.counts[static_cast<size_t>(change.kind)]++;
+            }
+
+        private:
+            struct Pair
+            {
+                uint32_t before;
+                uint32_t after;
+            };
+
+            struct Child
+            {
+                int32_t instanceId;
+                uint32_t index;
+            };
+
+            const HashedTree& m_before;
+            const HashedTree& m_after;
+            DiffResult& m_result;
+            std::vector<Pair> m_stack;
+            std::vector<Child> m_children;
+            std::vector<uint32_t> m_pendingBefore; // unmatched subtree tops
+            std::vector<uint32_t> m_pendingAfter;
+
+            void add(ChangeKind kind, int32_t instanceId, uint32_t before, uint32_t after, uint32_t count = 1)
+            {
+                m_result.changes.push_back({kind, instanceId, before, after, count});
+            }
+
+            // Pair up two sibling lists by instance ID. Pairs are queued for the walk, leftovers go to pending.
+            void matchSiblings(uint32_t firstBefore, uint32_t firstAfter)
+            {
+                m_children.clear();
+                for (uint32_t child = firstAfter; child != kNone; child = m_after[child].nextSibling)
+                    m_children.push_back({m_after[child].instanceId, child});
+                std::sort(m_children.begin(), m_children.end(),
+                          [](const Child& a, const Child& b) { return a.instanceId < b.instanceId; });
+
+                for (uint32_t child = firstBefore; child != kNone; child = m_before[child].nextSibling)
+                {
+                    const int32_t instanceId = m_before[child].instanceId;
+                    auto it = std::lower_bound(m_children.begin(), m_children.end(), instanceId,
+                                               [](const Child& c, int32_t id) { return c.instanceId < id; });
+                    if (it != m_children.end() && it->instanceId == instanceId && it->index != kNone)
+                    {
+                        m_stack.push_back({child, it->index});
+                        it->index = kNone;
+                    }
+                    else
+                    {
+                        m_pendingBefore.push_back(child);
+                    }
+                }
+
+                for (const Child& child : m_children)
+                {
+                    if (child.index != kNone) m_pendingAfter.push_back(child.index);
+                }
+            }
+
+            void compareNodes(uint32_t before, uint32_t after)
+            {
+                const NodeRecord& a = m_before[before];
+                const NodeRecord& b = m_after[after];
+                if (m_before.nameHash(before) != m_after.nameHash(after))
+                    add(ChangeKind::Renamed, b.instanceId, before, after);
+                if ((a.flags & NodeActive) != (b.flags & NodeActive))
+                    add(ChangeKind::ActivityChanged, b.instanceId, before, after);
+            }
+
+            void walk()
+            {
+                while (!m_stack.empty())
+                {
+                    const Pair pair = m_stack.back();
+                    m_stack.pop_back();
+                    m_result.compared++;
+
+                    if (m_before.subtreeHash(pair.before) == m_after.subtreeHash(pair.after))
+                    {
+                        m_result.skippedSubtrees++;
+                        m_result.skippedNodes += m_before.subtreeSize(pair.before);
+                        continue;
+                    }
+
+                    compareNodes(pair.before, pair.after);
+                    if (childrenComparable(m_before[pair.before], m_after[pair.after]))
+                        matchSiblings(m_before[pair.before].firstChild, m_after[pair.after].firstChild);
+                }
+            }
+
+            // Everything below an unmatched top is a candidate: it may have moved to (or come from) another
+            // branch. Subtrees are contiguous in preorder, so collecting them is a range copy.
+            static void collect(const HashedTree& tree, const std::vector<uint32_t>& tops,
+                                std::vector<uint32_t>& nodes, std::unordered_map<int32_t, uint32_t>& byId)
+            {
+                for (uint32_t top : tops)
+                {
+                    for (uint32_t index = top; index < top + tree.subtreeSize(top); index++)
+                    {
+                        nodes.push_back(index);
+                        byId.emplace(tree[index].instanceId, index);
+                    }
+                }
+                std::sort(nodes.begin(), nodes.end());
+            }
+
+            // Report unmatched nodes at the top of each unmatched run, counting the run's nodes into that entry.
+            // Parents precede children in preorder, so a node's parent has been classified before the node.
+            void reportUnmatched(const HashedTree& tree, const std::vector<uint32_t>& nodes,
+                                 const std::unordered_map<int32_t, uint32_t>& unmatched, ChangeKind kind)
+            {
+                std::unordered_map<uint32_t, size_t> entryOf; // node index -> change holding its subtree
+                for (uint32_t index : nodes)
+                {
+                    if (!unmatched.count(tree[index].instanceId)) continue;
+
+                    auto parent = tree[index].parent != kNone ? entryOf.find(tree[index].parent) : entryOf.end();
+                    if (parent != entryOf.end())
+                    {
+                        m_result.changes[parent->second].count++;
+                        entryOf.emplace(index, parent->second);
+                        continue;
+                    }
+
+                    entryOf.emplace(index, m_result.changes.size());
+                    if (kind == ChangeKind::Added) add(kind, tree[index].instanceId, kNone, index);
+                    else add(kind, tree[index].instanceId, index, kNone);
+                }
+            }
+
+            void resolveUnmatched()
+            {
+                if (m_pendingBefore.empty() && m_pendingAfter.empty()) return;
+
+                std::vector<uint32_t> beforeNodes, afterNodes;
+                std::unordered_map<int32_t, uint32_t> beforeById, afterById;
+                collect(m_before, m_pendingBefore, beforeNodes, beforeById);
+                collect(m_after, m_pendingAfter, afterNodes, afterById);
+
+                // Objects present on both sides moved; only the top of a moved branch changed parent
+                for (uint32_t after : afterNodes)
+                {
+                    const int32_t instanceId = m_after[after].instanceId;
+                    auto it = beforeById.find(instanceId);
+                    if (it == beforeById.end()) continue;
+
+                    const uint32_t before = it->second;
+                    if (parentId(m_before, before) != parentId(m_after, after))
+                        add(ChangeKind::Reparented, instanceId, before, after);
+                    compareNodes(before, after);
+                    beforeById.erase(it);
+                    afterById.erase(instanceId);
+                }
+
+                reportUnmatched(m_after, afterNodes, afterById, ChangeKind::Added);
+                reportUnmatched(m_before, beforeNodes, beforeById, ChangeKind::Removed);
+            }
+        };
+    }
+
+    uint64_t hashString(std::string_view str)
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a
+        for (char c : str)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    void HashedTree::build(const Reader& reader)
+    {
+        std::vector<uint64_t> nameHashes(reader.stringCount());
+        for (uint32_t i = 0; i < reader.stringCount(); i++) nameHashes[i] = hashString(reader.string(i));
+        build(reader.nodes(), reader.nodeCount(), nameHashes.data());
+    }
+
+    void HashedTree::build(const Capture& capture)
+    {
+        std::vector<uint64_t> nameHashes(capture.strings.size());
+        for (uint32_t i = 0; i < capture.strings.size(); i++) nameHashes[i] = hashString(capture.strings.get(i));
+        build(capture.nodes.data(), capture.nodes.size(), nameHashes.data());
+    }
+
+    void HashedTree::build(const NodeRecord* nodes, size_t count, const uint64_t* nameHashes)
+    {
+        m_nodes = nodes;
+        m_count = count;
+        m_nameHashes.resize(count);
+        m_subtreeHashes.resize(count);
+        m_subtreeSizes.resize(count);
+
+        // Children come after their parent in preorder, so walking backwards finishes every child first
+        for (size_t i = count; i-- > 0;)
+        {
+            const NodeRecord& node = nodes[i];
+            m_nameHashes[i] = nameHashes[node.name];
+
+            uint64_t hash = localHash(node, m_nameHashes[i]);
+            uint32_t size = 1;
+            for (uint32_t child = node.firstChild; child != kNone; child = nodes[child].nextSibling)
+            {
+                hash = mix(hash + m_subtreeHashes[child]);
+                size += m_subtreeSizes[child];
+            }
+            m_subtreeHashes[i] = hash;
+            m_subtreeSizes[i] = size;
+        }
+    }
+
+    DiffResult diff(const HashedTree& before, const HashedTree& after)
+    {
+        DiffResult result;
+        Differ(before, after, result).run();
+        return result;
+    }
+
+    const char* getChangeKindName(ChangeKind kind)
+    {
+        switch (kind)
+        {
+        case ChangeKind::Added:
+            return "Added";
+        case ChangeKind::Removed:
+            return "Removed";
+        case ChangeKind::Reparented:
+            return "Reparented";
+        case ChangeKind::Renamed:
+            return "Renamed";
+        case ChangeKind::ActivityChanged:
+            return "Activity Changed";
+        default:
+            return "Unknown";
+        }
+    }
+}
@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include "snapshot_format.h"
+
+#include <string_view>
+#include <vector>
+
+namespace snapshot
+{
+    class Reader;
+    struct Capture;
+
+    uint64_t hashString(std::string_view str);
+
+    // Merkle hashes over a node table. A node's subtree hash covers the instance ID, name and active flag of
+    // every node below it and the order of its children, so two subtrees with the same hash are identical and
+    // a diff can step over them without looking inside. Building is one backwards pass over the preorder table.
+    class HashedTree
+    {
+    public:
+        void build(const Reader& reader);
+        void build(const Capture& capture);
+
+        // `nameHashes` holds hashString() of every entry in the snapshot's string table. The node table is
+        // referenced, not copied, and must outlive the tree.
+        void build(const NodeRecord* nodes, size_t count, const uint64_t* nameHashes);
+
+        const NodeRecord* nodes() const { return m_nodes; }
+        size_t size() const { return m_count; }
+        const NodeRecord& operator[](uint32_t index) const { return m_nodes[index]; }
+
+        uint64_t subtreeHash(uint32_t index) const { return m_subtreeHashes[index]; }
+        uint64_t nameHash(uint32_t index) const { return m_nameHashes[index]; }
+        uint32_t subtreeSize(uint32_t index) const { return m_subtreeSizes[index]; } // including the node
+        uint32_t firstRoot() const { return m_count > 0 ? 0 : kNone; }
+
+    private:
+        const NodeRecord* m_nodes = nullptr;
+        size_t m_count = 0;
+        std::vector<uint64_t> m_nameHashes;
+        std::vector<uint64_t> m_subtreeHashes;
+        std::vector<uint32_t> m_subtreeSizes;
+    };
+
+    enum class ChangeKind : uint8_t
+    {
+        Added,
+        Removed,
+        Reparented,
+        Renamed,
+        ActivityChanged,
+        Count,
+    };
+
+    struct Change
+    {
+        ChangeKind kind;
+        int32_t instanceId;
+        uint32_t before; // node index in the older tree, kNone for Added
+        uint32_t after;  // node index in the newer tree, kNone for Removed
+        uint32_t count;  // nodes in an added or removed subtree, 1 otherwise
+    };
+
+    struct DiffResult
+    {
+        std::vector<Change> changes; // grouped by kind, in preorder within a kind
+        size_t counts[static_cast<size_t>(ChangeKind::Count)] = {};
+        size_t compared = 0;       // node pairs visited by the top-down walk
+        size_t skippedSubtrees = 0; // pairs whose subtree hashes matched
+        size_t skippedNodes = 0;   // nodes inside those subtrees
+
+        size_t count(ChangeKind kind) const { return counts[static_cast<size_t>(kind)]; }
+    };
+
+    // Objects are matched by instance ID, so both trees must come from the same game session. Both trees are
+    // walked together from the roots; matching subtree hashes end the walk for that branch. Objects that
+    // cannot be matched under the same parent are collected and paired up by instance ID afterwards, which
+    // separates reparenting from adding and removing. Added and removed subtrees are reported once, at their
+    // top node. Children of a node that is not expanded in either capture (lazy hierarchy) are not compared.
+    DiffResult diff(const HashedTree& before, const HashedTree& after);
+
+    const char* getChangeKindName(ChangeKind kind);
+}
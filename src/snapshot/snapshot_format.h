@@ -0,0 +1,102 @@
+﻿#pragma once
+
+#include <cstdint>
+
+// On-disk layout of a scene snapshot (.urisnap). Everything is little endian and every block starts on an
+// 8-byte boundary, so uncompressed blocks can be used in place from a memory mapping.
+//
+//   FileHeader
+//   block data          one block per BlockType, stored raw or LZ4 compressed
+//   BlockEntry[count]   block table
+//   FileFooter          locates the block table
+//
+// The table and footer come last so the writer never has to seek back. This header is shared with the
+// offline viewer (tools/snapshot_viewer) and must not depend on Windows or Unity headers.
+namespace snapshot
+{
+    constexpr char kMagic[8] = {'U', 'R', 'I', 'S', 'N', 'A', 'P', '\0'};
+    constexpr uint32_t kVersion = 1;
+    constexpr uint32_t kNone = UINT32_MAX;
+    constexpr uint64_t kBlockAlignment = 8;
+
+    enum class BlockType : uint32_t
+    {
+        Nodes = 1,          // NodeRecord[nodeCount], depth-first preorder
+        Strings = 2,        // StringsHeader, uint32 offsets[count], null-terminated characters
+        ComponentTypes = 3, // uint32 string index per component type
+        Components = 4,     // uint32 component type index; node components are [firstComponent, +componentCount)
+        Transforms = 5,     // world space SoA: float position[3 * n], rotation[4 * n], scale[3 * n]
+    };
+
+    enum class Codec : uint32_t
+    {
+        None = 0,
+        LZ4 = 1, // a single LZ4 block (no frame header); rawSize gives the decompressed size
+    };
+
+    enum FileFlags : uint32_t
+    {
+        PartialHierarchy = 1 << 0, // captured from a lazy hierarchy; unexpanded subtrees are missing
+    };
+
+    struct FileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t createdUnixMs;
+        uint64_t reserved;
+    };
+
+    struct BlockEntry
+    {
+        BlockType type;
+        Codec codec;
+        uint64_t offset;     // from the start of the file
+        uint64_t storedSize; // bytes in the file
+        uint64_t rawSize;    // bytes after decompression
+        uint64_t count;      // number of elements, meaning depends on the block type
+    };
+
+    struct FileFooter
+    {
+        uint64_t tableOffset;
+        uint32_t blockCount;
+        uint32_t reserved;
+        char magic[8];
+    };
+
+    enum NodeFlags : uint16_t
+    {
+        NodeActive = 1 << 0,         // activeSelf
+        NodeChildrenLoaded = 1 << 1, // children are in the snapshot (always set for full captures)
+    };
+
+    // Node links are indices into the node table, kNone when absent
+    struct NodeRecord
+    {
+        int32_t instanceId;
+        uint32_t parent;
+        uint32_t firstChild;
+        uint32_t nextSibling;
+        uint32_t name; // string index
+        uint32_t firstComponent;
+        uint32_t childCount; // Transform.childCount at capture, also for nodes whose children are missing
+        uint16_t componentCount;
+        uint16_t depth;
+        uint16_t flags;
+        uint16_t reserved;
+    };
+
+    struct StringsHeader
+    {
+        uint32_t count;
+        uint32_t charBytes;
+    };
+
+    static_assert(sizeof(FileHeader) == 32, "snapshot layout");
+    static_assert(sizeof(BlockEntry) == 40, "snapshot layout");
+    static_assert(sizeof(FileFooter) == 24, "snapshot layout");
+    static_assert(sizeof(NodeRecord) == 36, "snapshot layout");
+    static_assert(sizeof(StringsHeader) == 8, "snapshot layout");
+}
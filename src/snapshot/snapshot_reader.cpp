@@ -0,0 +1,269 @@
+﻿#include "snapshot_reader.h"
+#include "lz4_block.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace snapshot
+{
+    Reader::~Reader()
+    {
+        close();
+    }
+
+    bool Reader::open(const char* path)
+    {
+        close();
+        m_error.clear();
+        if (!map(path)) return false;
+
+        if (m_size < sizeof(FileHeader) + sizeof(FileFooter)) return fail("file is too small");
+        memcpy(&m_header, m_base, sizeof(m_header));
+        if (memcmp(m_header.magic, kMagic, sizeof(kMagic)) != 0) return fail("not a snapshot file");
+        if (m_header.version != kVersion) return fail("unsupported snapshot version");
+
+        FileFooter footer;
+        memcpy(&footer, m_base + m_size - sizeof(footer), sizeof(footer));
+        if (memcmp(footer.magic, kMagic, sizeof(kMagic)) != 0) return fail("truncated file (footer missing)");
+
+        const uint64_t tableBytes = uint64_t(footer.blockCount) * sizeof(BlockEntry);
+        if (footer.tableOffset > m_size - sizeof(footer) || tableBytes > m_size - sizeof(footer) - footer.tableOffset)
+            return fail("block table out of range");
+
+        m_blocks.resize(footer.blockCount);
+        if (tableBytes) memcpy(m_blocks.data(), m_base + footer.tableOffset, static_cast<size_t>(tableBytes));
+        for (const BlockEntry& block : m_blocks)
+        {
+            if (block.offset > footer.tableOffset || block.storedSize > footer.tableOffset - block.offset)
+                return fail("block out of range");
+            if (block.codec == Codec::None && block.storedSize != block.rawSize) return fail("block size mismatch");
+            if (block.codec != Codec::None && block.codec != Codec::LZ4) return fail("unknown block codec");
+        }
+
+        size_t count = 0;
+        m_nodes = reinterpret_cast<const NodeRecord*>(blockData(BlockType::Nodes, sizeof(NodeRecord), &count));
+        m_nodeCount = count;
+
+        // Strings are variable-sized: header, offsets, then characters
+        if (const BlockEntry* block = findBlock(BlockType::Strings))
+        {
+            const uint8_t* data = blockData(BlockType::Strings, 1, &count);
+            StringsHeader header;
+            if (!data || count < sizeof(header)) return fail("malformed string table");
+            memcpy(&header, data, sizeof(header));
+            if (block->rawSize != sizeof(header) + uint64_t(header.count) * sizeof(uint32_t) + header.charBytes)
+                return fail("malformed string table");
+
+            m_stringCount = header.count;
+            m_stringOffsets = reinterpret_cast<const uint32_t*>(data + sizeof(header));
+            m_chars = reinterpret_cast<const char*>(m_stringOffsets + header.count);
+            m_charBytes = header.charBytes;
+        }
+
+        m_componentTypes = reinterpret_cast<const uint32_t*>(blockData(BlockType::ComponentTypes, sizeof(uint32_t),
+                                                                       &count));
+        m_componentTypeCount = count;
+        m_components = reinterpret_cast<const uint32_t*>(blockData(BlockType::Components, sizeof(uint32_t), &count));
+        m_componentCount = count;
+
+        if (auto transforms = reinterpret_cast<const float*>(blockData(BlockType::Transforms, sizeof(float),
+                                                                       &count)))
+        {
+            if (count != m_nodeCount * 10) return fail("transform block does not match the node table");
+            m_positions = transforms;
+            m_rotations = transforms + m_nodeCount * 3;
+            m_scales = transforms + m_nodeCount * 7;
+        }
+
+        if (!m_error.empty()) return fail(m_error.c_str());
+        return validate();
+    }
+
+    void Reader::close()
+    {
+        unmap();
+        m_header = {};
+        m_blocks.clear();
+        m_decompressed.clear();
+        m_nodes = nullptr;
+        m_nodeCount = 0;
+        m_stringOffsets = nullptr;
+        m_chars = nullptr;
+        m_charBytes = 0;
+        m_stringCount = 0;
+        m_componentTypes = nullptr;
+        m_componentTypeCount = 0;
+        m_components = nullptr;
+        m_componentCount = 0;
+        m_positions = nullptr;
+        m_rotations = nullptr;
+        m_scales = nullptr;
+    }
+
+    std::string_view Reader::string(uint32_t index) const
+    {
+        const uint32_t begin = m_stringOffsets[index];
+        const uint32_t end = index + 1 < m_stringCount ? m_stringOffsets[index + 1] : m_charBytes;
+        return std::string_view(m_chars + begin, end - begin - 1);
+    }
+
+    const BlockEntry* Reader::findBlock(BlockType type) const
+    {
+        for (const BlockEntry& block : m_blocks)
+        {
+            if (block.type == type) return &block;
+        }
+        return nullptr;
+    }
+
+    // Block contents as `count` elements of `elementSize` bytes, or nullptr (count 0) when the block is missing
+    // or malformed. The error is recorded for open() to report.
+    const uint8_t* Reader::blockData(BlockType type, uint64_t elementSize, size_t* count)
+    {
+        *count = 0;
+        const BlockEntry* block = findBlock(type);
+        if (!block || block->rawSize == 0) return nullptr;
+
+        if (block->rawSize % elementSize != 0 || (elementSize > 1 && block->rawSize / elementSize != block->count))
+        {
+            m_error = "block size does not match its element count";
+            return nullptr;
+        }
+
+        const uint8_t* data = m_base + block->offset;
+        if (block->codec == Codec::LZ4)
+        {
+            auto buffer = std::make_unique<uint8_t[]>(static_cast<size_t>(block->rawSize));
+            if (!lz4::decompress(data, static_cast<size_t>(block->storedSize), buffer.get(),
+                                 static_cast<size_t>(block->rawSize)))
+            {
+                m_error = "corrupt compressed block";
+                return nullptr;
+            }
+            data = buffer.get();
+            m_decompressed.push_back(std::move(buffer));
+        }
+        else if (block->offset % kBlockAlignment != 0)
+        {
+            m_error = "misaligned block";
+            return nullptr;
+        }
+
+        *count = static_cast<size_t>(block->rawSize / elementSize);
+        return data;
+    }
+
+    // The node table is in depth-first preorder: parents come before their children and every link points
+    // forward. Checking that keeps traversals of a damaged file finite.
+    bool Reader::validate()
+    {
+        for (size_t i = 0; i < m_stringCount; i++)
+        {
+            const uint32_t end = i + 1 < m_stringCount ? m_stringOffsets[i + 1] : m_charBytes;
+            if (m_stringOffsets[i] >= end || end > m_charBytes || m_chars[end - 1] != '\0')
+                return fail("malformed string table");
+        }
+
+        for (size_t i = 0; i < m_componentTypeCount; i++)
+        {
+            if (m_componentTypes[i] >= m_stringCount) return fail("component type name out of range");
+        }
+        for (size_t i = 0; i < m_componentCount; i++)
+        {
+            if (m_components[i] >= m_componentTypeCount) return fail("component type out of range");
+        }
+
+        for (size_t i = 0; i < m_nodeCount; i++)
+        {
+            const NodeRecord& node = m_nodes[i];
+            if (node.parent != kNone && node.parent >= i) return fail("node parent out of order");
+            if (node.firstChild != kNone && (node.firstChild <= i || node.firstChild >= m_nodeCount))
+                return fail("node child out of order");
+            if (node.nextSibling != kNone && (node.nextSibling <= i || node.nextSibling >= m_nodeCount))
+                return fail("node sibling out of order");
+            if (node.name >= m_stringCount) return fail("node name out of range");
+            if (uint64_t(node.firstComponent) + node.componentCount > m_componentCount && node.componentCount > 0)
+                return fail("node components out of range");
+        }
+        return true;
+    }
+
+    bool Reader::fail(const char* message)
+    {
+        std::string error = message;
+        close();
+        m_error = error;
+        return false;
+    }
+
+#ifdef _WIN32
+    bool Reader::map(const char* path)
+    {
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return fail("cannot open file");
+        m_fileHandle = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return fail("cannot map an empty file");
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return fail("cannot map file");
+        m_mappingHandle = mapping;
+
+        m_base = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_base) return fail("cannot map file");
+        m_size = static_cast<size_t>(size.QuadPart);
+        return true;
+    }
+
+    void Reader::unmap()
+    {
+        if (m_base) UnmapViewOfFile(m_base);
+        if (m_mappingHandle) CloseHandle(m_mappingHandle);
+        if (m_fileHandle) CloseHandle(m_fileHandle);
+        m_base = nullptr;
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+        m_size = 0;
+    }
+#else
+    bool Reader::map(const char* path)
+    {
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return fail("cannot open file");
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            ::close(fd);
+            return fail("cannot map an empty file");
+        }
+
+        void* base = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps the file referenced
+        if (base == MAP_FAILED) return fail("cannot map file");
+
+        m_base = static_cast<const uint8_t*>(base);
+        m_size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void Reader::unmap()
+    {
+        if (m_base) munmap(const_cast<uint8_t*>(m_base), m_size);
+        m_base = nullptr;
+        m_size = 0;
+    }
+#endif
+}
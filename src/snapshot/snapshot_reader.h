@@ -0,0 +1,89 @@
+﻿#pragma once
+
+#include "snapshot_format.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace snapshot
+{
+    // Opens a snapshot through a read-only memory mapping. Uncompressed blocks are used in place; LZ4 blocks
+    // are decompressed once into owned buffers. open() validates every link and string index, so the
+    // accessors can be used without further bounds checks.
+    class Reader
+    {
+    public:
+        Reader() = default;
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        bool open(const char* path);
+        void close();
+        bool isOpen() const { return m_base != nullptr; }
+        const std::string& getError() const { return m_error; }
+
+        uint32_t flags() const { return m_header.flags; }
+        uint64_t createdUnixMs() const { return m_header.createdUnixMs; }
+        size_t fileSize() const { return m_size; }
+
+        const NodeRecord* nodes() const { return m_nodes; }
+        size_t nodeCount() const { return m_nodeCount; }
+        const NodeRecord& operator[](uint32_t index) const { return m_nodes[index]; }
+
+        size_t stringCount() const { return m_stringCount; }
+        std::string_view string(uint32_t index) const;
+        std::string_view nameOf(uint32_t node) const { return string(m_nodes[node].name); }
+
+        size_t componentTypeCount() const { return m_componentTypeCount; }
+        std::string_view componentTypeName(uint32_t type) const { return string(m_componentTypes[type]); }
+
+        // Component type indices of a node
+        const uint32_t* componentsOf(uint32_t node) const { return m_components + m_nodes[node].firstComponent; }
+        size_t componentCount() const { return m_componentCount; }
+
+        // World transforms, parallel to the node table. Null when the snapshot has no transform block.
+        bool hasTransforms() const { return m_positions != nullptr; }
+        const float* positionOf(uint32_t node) const { return m_positions + node * 3; }
+        const float* rotationOf(uint32_t node) const { return m_rotations + node * 4; }
+        const float* scaleOf(uint32_t node) const { return m_scales + node * 3; }
+
+        const BlockEntry* findBlock(BlockType type) const;
+        const std::vector<BlockEntry>& blocks() const { return m_blocks; }
+
+    private:
+        const uint8_t* m_base = nullptr;
+        size_t m_size = 0;
+#ifdef _WIN32
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#endif
+        std::string m_error;
+        FileHeader m_header = {};
+        std::vector<BlockEntry> m_blocks;
+        std::vector<std::unique_ptr<uint8_t[]>> m_decompressed;
+
+        const NodeRecord* m_nodes = nullptr;
+        size_t m_nodeCount = 0;
+        const uint32_t* m_stringOffsets = nullptr;
+        const char* m_chars = nullptr;
+        uint32_t m_charBytes = 0;
+        size_t m_stringCount = 0;
+        const uint32_t* m_componentTypes = nullptr;
+        size_t m_componentTypeCount = 0;
+        const uint32_t* m_components = nullptr;
+        size_t m_componentCount = 0;
+        const float* m_positions = nullptr;
+        const float* m_rotations = nullptr;
+        const float* m_scales = nullptr;
+
+        bool map(const char* path);
+        void unmap();
+        const uint8_t* blockData(BlockType type, uint64_t elementSize, size_t* count);
+        bool validate();
+        bool fail(const char* message);
+    };
+}
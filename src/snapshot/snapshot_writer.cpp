@@ -0,0 +1,177 @@
+﻿#include "snapshot_writer.h"
+#include "lz4_block.h"
+
+#include <cstring>
+
+namespace snapshot
+{
+    // -----------------------------------------------------------------------
+    // StringTableBuilder
+    // -----------------------------------------------------------------------
+
+    uint32_t StringTableBuilder::intern(std::string_view str)
+    {
+        auto [it, inserted] = m_ids.try_emplace(std::string(str), static_cast<uint32_t>(m_offsets.size()));
+        if (!inserted) return it->second;
+
+        m_offsets.push_back(static_cast<uint32_t>(m_chars.size()));
+        m_chars.insert(m_chars.end(), str.begin(), str.end());
+        m_chars.push_back('\0');
+        return it->second;
+    }
+
+    std::string_view StringTableBuilder::get(uint32_t id) const
+    {
+        const uint32_t begin = m_offsets[id];
+        const uint32_t end = id + 1 < m_offsets.size() ? m_offsets[id + 1] : static_cast<uint32_t>(m_chars.size());
+        return std::string_view(m_chars.data() + begin, end - begin - 1);
+    }
+
+    std::vector<uint8_t> StringTableBuilder::serialize() const
+    {
+        StringsHeader header;
+        header.count = static_cast<uint32_t>(m_offsets.size());
+        header.charBytes = static_cast<uint32_t>(m_chars.size());
+
+        const size_t offsetBytes = m_offsets.size() * sizeof(uint32_t);
+        std::vector<uint8_t> out(sizeof(header) + offsetBytes + m_chars.size());
+        memcpy(out.data(), &header, sizeof(header));
+        if (offsetBytes) memcpy(out.data() + sizeof(header), m_offsets.data(), offsetBytes);
+        if (!m_chars.empty()) memcpy(out.data() + sizeof(header) + offsetBytes, m_chars.data(), m_chars.size());
+        return out;
+    }
+
+    // -----------------------------------------------------------------------
+    // Writer
+    // -----------------------------------------------------------------------
+
+    Writer::~Writer()
+    {
+        abort();
+    }
+
+    bool Writer::open(const char* path, uint32_t flags, uint64_t createdUnixMs)
+    {
+        abort();
+        m_error.clear();
+        m_blocks.clear();
+        m_offset = 0;
+
+        m_file = fopen(path, "wb");
+        if (!m_file) return fail("cannot create file");
+        m_path = path;
+        setvbuf(m_file, nullptr, _IOFBF, 1 << 20);
+
+        FileHeader header = {};
+        memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.flags = flags;
+        header.createdUnixMs = createdUnixMs;
+        return write(&header, sizeof(header));
+    }
+
+    bool Writer::writeBlock(BlockType type, const void* data, size_t size, uint64_t count)
+    {
+        if (!m_file) return fail("file is not open");
+
+        BlockEntry entry = {};
+        entry.type = type;
+        entry.codec = Codec::None;
+        entry.offset = m_offset;
+        entry.rawSize = size;
+        entry.storedSize = size;
+        entry.count = count;
+
+        const void* stored = data;
+        if (m_compress && size > 0)
+        {
+            m_scratch.resize(lz4::compressBound(size));
+            const size_t compressed = lz4::compress(static_cast<const uint8_t*>(data), size, m_scratch.data(),
+                                                    m_scratch.size());
+            if (compressed > 0 && compressed < size)
+            {
+                entry.codec = Codec::LZ4;
+                entry.storedSize = compressed;
+                stored = m_scratch.data();
+            }
+        }
+
+        if (!write(stored, static_cast<size_t>(entry.storedSize)) || !pad()) return false;
+        m_blocks.push_back(entry);
+        return true;
+    }
+
+    bool Writer::finish()
+    {
+        if (!m_file) return fail("file is not open");
+
+        FileFooter footer = {};
+        footer.tableOffset = m_offset;
+        footer.blockCount = static_cast<uint32_t>(m_blocks.size());
+        memcpy(footer.magic, kMagic, sizeof(kMagic));
+
+        if (!write(m_blocks.data(), m_blocks.size() * sizeof(BlockEntry)) || !write(&footer, sizeof(footer)))
+            return false;
+
+        const bool ok = fclose(m_file) == 0;
+        m_file = nullptr;
+        if (!ok)
+        {
+            remove(m_path.c_str());
+            return fail("flush failed");
+        }
+        return true;
+    }
+
+    void Writer::abort()
+    {
+        if (!m_file) return;
+        fclose(m_file);
+        m_file = nullptr;
+        remove(m_path.c_str());
+    }
+
+    bool Writer::write(const void* data, size_t size)
+    {
+        if (size > 0 && fwrite(data, 1, size, m_file) != size)
+        {
+            abort();
+            return fail("write failed");
+        }
+        m_offset += size;
+        return true;
+    }
+
+    bool Writer::pad()
+    {
+        static const uint8_t zeros[kBlockAlignment] = {};
+        const size_t padding = static_cast<size_t>((kBlockAlignment - m_offset % kBlockAlignment) % kBlockAlignment);
+        return write(zeros, padding);
+    }
+
+    bool Writer::fail(const char* message)
+    {
+        m_error = message;
+        return false;
+    }
+
+    // -----------------------------------------------------------------------
+    // Capture
+    // -----------------------------------------------------------------------
+
+    bool Capture::write(Writer& writer, const char* path) const
+    {
+        const std::vector<uint8_t> stringBlock = strings.serialize();
+        return writer.open(path, flags, createdUnixMs) &&
+            writer.writeBlock(BlockType::Nodes, nodes.data(), nodes.size() * sizeof(NodeRecord), nodes.size()) &&
+            writer.writeBlock(BlockType::Strings, stringBlock.data(), stringBlock.size(), strings.size()) &&
+            writer.writeBlock(BlockType::ComponentTypes, componentTypes.data(),
+                              componentTypes.size() * sizeof(uint32_t), componentTypes.size()) &&
+            writer.writeBlock(BlockType::Components, components.data(), components.size() * sizeof(uint32_t),
+                              components.size()) &&
+            (transforms.empty() ||
+             writer.writeBlock(BlockType::Transforms, transforms.data(), transforms.size() * sizeof(float),
+                               transforms.size())) &&
+            writer.finish();
+    }
+}
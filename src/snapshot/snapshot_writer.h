@@ -0,0 +1,86 @@
+﻿#pragma once
+
+#include "snapshot_format.h"
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace snapshot
+{
+    // Deduplicating string table in the layout of the Strings block
+    class StringTableBuilder
+    {
+    public:
+        uint32_t intern(std::string_view str);
+        std::string_view get(uint32_t id) const;
+        size_t size() const { return m_offsets.size(); }
+
+        // Serialized Strings block: StringsHeader, offsets, characters
+        std::vector<uint8_t> serialize() const;
+
+    private:
+        std::vector<char> m_chars;
+        std::vector<uint32_t> m_offsets;
+        std::unordered_map<std::string, uint32_t> m_ids;
+    };
+
+    // Writes a snapshot front to back: header on open(), each block as it is handed over, block table and
+    // footer on finish(). Nothing is written twice, so the file can go to a pipe or a slow disk.
+    class Writer
+    {
+    public:
+        Writer() = default;
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        bool open(const char* path, uint32_t flags, uint64_t createdUnixMs);
+
+        // With compression on, a block is stored as LZ4 only when that makes it smaller
+        void setCompression(bool enabled) { m_compress = enabled; }
+
+        bool writeBlock(BlockType type, const void* data, size_t size, uint64_t count);
+        bool finish();
+
+        // Closes and deletes a file that was not finished
+        void abort();
+
+        uint64_t bytesWritten() const { return m_offset; }
+        const std::string& getError() const { return m_error; }
+
+    private:
+        FILE* m_file = nullptr;
+        std::string m_path;
+        uint64_t m_offset = 0;
+        bool m_compress = false;
+        std::vector<BlockEntry> m_blocks;
+        std::vector<uint8_t> m_scratch;
+        std::string m_error;
+
+        bool write(const void* data, size_t size);
+        bool pad();
+        bool fail(const char* message);
+    };
+
+    // A complete snapshot held in memory, block by block in file layout. It can be written out as is or
+    // diffed directly (snapshot_diff.h) without a round trip through disk.
+    struct Capture
+    {
+        std::vector<NodeRecord> nodes; // depth-first preorder
+        StringTableBuilder strings;
+        std::vector<uint32_t> componentTypes; // string index per component type
+        std::vector<uint32_t> components;
+        std::vector<float> transforms; // empty, or positions, rotations and scales for every node
+        uint32_t flags = 0;
+        uint64_t createdUnixMs = 0;
+
+        std::string_view nameOf(uint32_t node) const { return strings.get(nodes[node].name); }
+
+        // Open `path`, write every block and finish. The writer's compression setting applies.
+        bool write(Writer& writer, const char* path) const;
+    };
+}
@@ -173,4 +173,58 @@ static const std::unordered_map<std::string, TranslationEntry> g_translations =
     {"False", {"False", "否"}},
     {"Error reading Rigidbody data", {"Error reading Rigidbody data", "读取刚体数据时出错"}},
     {"Error reading Collider data", {"Error reading Collider data", "读取碰撞器数据时出错"}},
+    {"Changed", {"Changed", "变更"}},
+    {"Last Scan", {"Last Scan", "上次扫描"}},
+    {"frames", {"frames", "帧"}},
+    {"Live", {"Live", "实时"}},
+    {"Objects", {"Objects", "对象"}},
+    {"Error", {"Error", "错误"}},
+    {"Changes Since Baseline", {"Changes Since Baseline", "自基线以来的变化"}},
+    {"Not compared yet", {"Not compared yet", "尚未比较"}},
+    {"No changes", {"No changes", "无变化"}},
+    {"Matches", {"matches", "个匹配"}},
+    {"Fuzzy", {"Fuzzy", "模糊"}},
+    {"showing", {"showing", "显示"}},
+    {"Expression", {"Expression", "表达式"}},
+    {"Search", {"Search", "搜索"}},
+    {"objects", {"objects", "个对象"}},
+    {"Collecting bounds...", {"Collecting bounds...", "正在收集包围盒..."}},
+    {"Rebuild Index", {"Rebuild Index", "重建索引"}},
+    {"Build Index", {"Build Index", "构建索引"}},
+    {"with bounds", {"with bounds", "有包围盒"}},
+    {"nodes", {"nodes", "节点"}},
+    {"Track Movement", {"Track Movement", "跟踪移动"}},
+    {"Refit", {"Refit", "重新拟合"}},
+    {"Radius", {"Radius", "半径"}},
+    {"Near Selection", {"Near Selection", "选中对象附近"}},
+    {"Min", {"Min", "最小"}},
+    {"Max", {"Max", "最大"}},
+    {"Inside Box", {"Inside Box", "盒内"}},
+    {"Pick in Game View", {"Pick in Game View", "在游戏视图中拾取"}},
+    {"Sampling", {"Sampling", "采样"}},
+    {"per frame", {"per frame", "每帧"}},
+    {"Watch", {"Watch", "监视"}},
+    {"not readable", {"not readable", "不可读"}},
+    {"samples", {"samples", "样本"}},
+    {"Track Changes", {"Track Changes", "跟踪变更"}},
+    {"Never", {"Never", "从不"}},
+    {"Any field", {"Any field", "任意字段"}},
+    {"Pause on change", {"Pause on change", "变更时暂停"}},
+    {"tracked", {"tracked", "已跟踪"}},
+    {"Paused", {"Paused", "已暂停"}},
+    {"Resume", {"Resume", "继续"}},
+    {"Clear Log", {"Clear Log", "清除日志"}},
+    {"Untrack All", {"Untrack All", "全部取消跟踪"}},
+    {"Editable", {"Editable", "可编辑"}},
+    {"Undo Last", {"Undo Last", "撤销上一步"}},
+    {"Clear", {"Clear", "清除"}},
+    {"pending", {"pending", "待写入"}},
+    {"failed", {"failed", "失败"}},
+    {"Read-only (no game tick)", {"Read-only (no game tick)", "只读（无游戏帧钩子）"}},
+    {"No edits", {"No edits", "没有编辑"}},
+    {"Undo", {"Undo", "撤销"}},
+    {"Undone", {"Undone", "已撤销"}},
+    {"writes", {"writes", "次写入"}},
+    {"Building tree...", {"Building tree...", "正在构建树..."}},
+    {"Searching...", {"Searching...", "搜索中..."}},
 };
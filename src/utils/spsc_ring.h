@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Fixed-size queue between exactly one producer thread and one consumer thread, without locks: each side only
+// writes its own index, and the indices sit on separate cache lines so the two threads do not contend. When
+// the ring is full push() fails instead of waiting, so the producer never stalls on a slow consumer.
+template <typename T, size_t N>
+class SpscRing
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // Producer side
+    bool push(const T& value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == N) return false;
+        m_items[head & (N - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: move up to `max` items into `out`, oldest first. Returns the count.
+    size_t pop(T* out, size_t max)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t count = m_head.load(std::memory_order_acquire) - tail;
+        if (count > max) count = max;
+        for (size_t i = 0; i < count; i++) out[i] = m_items[(tail + i) & (N - 1)];
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Only while neither side is using the ring
+    void reset()
+    {
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    alignas(64) std::atomic<size_t> m_head{0}; // next write, producer-owned
+    alignas(64) std::atomic<size_t> m_tail{0}; // next read, consumer-owned
+    alignas(64) std::array<T, N> m_items;
+};
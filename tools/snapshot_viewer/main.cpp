@@ -0,0 +1,412 @@
+﻿// Offline viewer for scene snapshots saved by the inspector (Scene Explorer > File > Save Snapshot).
+//
+//   snapshot_viewer info <file>                      summary, block table and open time
+//   snapshot_viewer tree <file> [maxDepth]           hierarchy with components
+//   snapshot_viewer find <file> <text>               nodes whose name contains text, with their path
+//   snapshot_viewer diff <before> <after>            objects added, removed, reparented, renamed or toggled
+//   snapshot_viewer generate <file> <nodes> [--lz4] [--mutate <edits>]
+//                                                    synthetic snapshot for benchmarking the reader and diff
+
+#include "snapshot_diff.h"
+#include "snapshot_reader.h"
+#include "snapshot_writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    const char* blockName(snapshot::BlockType type)
+    {
+        switch (type)
+        {
+        case snapshot::BlockType::Nodes:
+            return "Nodes";
+        case snapshot::BlockType::Strings:
+            return "Strings";
+        case snapshot::BlockType::ComponentTypes:
+            return "ComponentTypes";
+        case snapshot::BlockType::Components:
+            return "Components";
+        case snapshot::BlockType::Transforms:
+            return "Transforms";
+        default:
+            return "Unknown";
+        }
+    }
+
+    bool openSnapshot(snapshot::Reader& reader, const char* path, double* elapsedMs)
+    {
+        const auto start = Clock::now();
+        const bool ok = reader.open(path);
+        *elapsedMs = millisecondsSince(start);
+        if (!ok) fprintf(stderr, "%s: %s\n", path, reader.getError().c_str());
+        return ok;
+    }
+
+    int info(const char* path)
+    {
+        snapshot::Reader reader;
+        double openMs = 0.0;
+        if (!openSnapshot(reader, path, &openMs)) return 1;
+
+        size_t roots = 0;
+        uint16_t maxDepth = 0;
+        for (uint32_t i = 0; i < reader.nodeCount(); i++)
+        {
+            if (reader[i].parent == snapshot::kNone) roots++;
+            if (reader[i].depth > maxDepth) maxDepth = reader[i].depth;
+        }
+
+        printf("File:            %s (%zu bytes)\n", path, reader.fileSize());
+        printf("Captured:        %" PRIu64 " ms since epoch%s\n", reader.createdUnixMs(),
+               reader.flags() & snapshot::PartialHierarchy ? ", partial hierarchy" : "");
+        printf("Nodes:           %zu (%zu roots, max depth %u)\n", reader.nodeCount(), roots, maxDepth);
+        printf("Strings:         %zu\n", reader.stringCount());
+        printf("Component types: %zu (%zu components)\n", reader.componentTypeCount(), reader.componentCount());
+        printf("Transforms:      %s\n", reader.hasTransforms() ? "yes" : "no");
+        printf("Open time:       %.2f ms\n\n", openMs);
+
+        printf("%-16s %-6s %14s %14s %12s\n", "Block", "Codec", "Stored", "Raw", "Count");
+        for (const snapshot::BlockEntry& block : reader.blocks())
+        {
+            printf("%-16s %-6s %14" PRIu64 " %14" PRIu64 " %12" PRIu64 "\n", blockName(block.type),
+                   block.codec == snapshot::Codec::LZ4 ? "lz4" : "raw", block.storedSize, block.rawSize, block.count);
+        }
+        return 0;
+    }
+
+    void printNode(const snapshot::Reader& reader, uint32_t index)
+    {
+        const snapshot::NodeRecord& node = reader[index];
+        printf("%*s%.*s", node.depth * 2, "", static_cast<int>(reader.nameOf(index).size()),
+               reader.nameOf(index).data());
+        if (!(node.flags & snapshot::NodeActive)) printf(" (inactive)");
+
+        const uint32_t* components = reader.componentsOf(index);
+        for (uint16_t i = 0; i < node.componentCount; i++)
+        {
+            const std::string_view type = reader.componentTypeName(components[i]);
+            printf("%s%.*s", i == 0 ? "  [" : ", ", static_cast<int>(type.size()), type.data());
+        }
+        if (node.componentCount > 0) printf("]");
+
+        if (reader.hasTransforms())
+        {
+            const float* position = reader.positionOf(index);
+            printf("  (%.2f, %.2f, %.2f)", position[0], position[1], position[2]);
+        }
+        if (!(node.flags & snapshot::NodeChildrenLoaded) && node.childCount > 0)
+            printf("  +%u not captured", node.childCount);
+        printf("\n");
+    }
+
+    int tree(const char* path, int maxDepth)
+    {
+        snapshot::Reader reader;
+        double openMs = 0.0;
+        if (!openSnapshot(reader, path, &openMs)) return 1;
+
+        // Preorder storage means file order is display order
+        for (uint32_t i = 0; i < reader.nodeCount(); i++)
+        {
+            if (maxDepth < 0 || reader[i].depth <= maxDepth) printNode(reader, i);
+        }
+        return 0;
+    }
+
+    int find(const char* path, const char* text)
+    {
+        snapshot::Reader reader;
+        double openMs = 0.0;
+        if (!openSnapshot(reader, path, &openMs)) return 1;
+
+        // Match each distinct name once, then report the nodes that use a matching name
+        std::vector<uint8_t> matches(reader.stringCount());
+        for (uint32_t i = 0; i < reader.stringCount(); i++)
+            matches[i] = reader.string(i).find(text) != std::string_view::npos;
+
+        size_t found = 0;
+        std::vector<uint32_t> chain;
+        for (uint32_t i = 0; i < reader.nodeCount(); i++)
+        {
+            if (!matches[reader[i].name]) continue;
+            found++;
+
+            chain.clear();
+            for (uint32_t node = i; node != snapshot::kNone; node = reader[node].parent) chain.push_back(node);
+            for (size_t j = chain.size(); j-- > 0;)
+            {
+                const std::string_view name = reader.nameOf(chain[j]);
+                printf("%s%.*s", j + 1 == chain.size() ? "" : "/", static_cast<int>(name.size()), name.data());
+            }
+            printf("\n");
+        }
+        printf("%zu matches\n", found);
+        return 0;
+    }
+
+    void printChange(const snapshot::Reader& before, const snapshot::Reader& after, const snapshot::Change& change)
+    {
+        const snapshot::Reader& reader = change.after != snapshot::kNone ? after : before;
+        const uint32_t index = change.after != snapshot::kNone ? change.after : change.before;
+        const std::string_view name = reader.nameOf(index);
+        printf("  %-16s %-32.*s id %d", snapshot::getChangeKindName(change.kind), static_cast<int>(name.size()),
+               name.data(), change.instanceId);
+
+        if (change.kind == snapshot::ChangeKind::Renamed)
+        {
+            const std::string_view oldName = before.nameOf(change.before);
+            printf("  (was %.*s)", static_cast<int>(oldName.size()), oldName.data());
+        }
+        else if (change.kind == snapshot::ChangeKind::Reparented)
+        {
+            const uint32_t oldParent = before[change.before].parent;
+            const uint32_t newParent = after[change.after].parent;
+            const std::string_view from = oldParent != snapshot::kNone ? before.nameOf(oldParent) : "<root>";
+            const std::string_view to = newParent != snapshot::kNone ? after.nameOf(newParent) : "<root>";
+            printf("  %.*s -> %.*s", static_cast<int>(from.size()), from.data(), static_cast<int>(to.size()),
+                   to.data());
+        }
+        else if (change.count > 1)
+        {
+            printf("  (%u objects)", change.count);
+        }
+        printf("\n");
+    }
+
+    int diff(const char* beforePath, const char* afterPath)
+    {
+        snapshot::Reader before, after;
+        double openMs = 0.0;
+        if (!openSnapshot(before, beforePath, &openMs) || !openSnapshot(after, afterPath, &openMs)) return 1;
+
+        auto start = Clock::now();
+        snapshot::HashedTree beforeTree, afterTree;
+        beforeTree.build(before);
+        afterTree.build(after);
+        const double hashMs = millisecondsSince(start);
+
+        start = Clock::now();
+        const snapshot::DiffResult result = snapshot::diff(beforeTree, afterTree);
+        const double diffMs = millisecondsSince(start);
+
+        for (const snapshot::Change& change : result.changes) printChange(before, after, change);
+
+        printf("\n");
+        for (size_t kind = 0; kind < static_cast<size_t>(snapshot::ChangeKind::Count); kind++)
+        {
+            printf("%-16s %zu\n", snapshot::getChangeKindName(static_cast<snapshot::ChangeKind>(kind)),
+                   result.counts[kind]);
+        }
+        printf("Compared %zu pairs, skipped %zu unchanged subtrees (%zu nodes)\n", result.compared,
+               result.skippedSubtrees, result.skippedNodes);
+        printf("Hashing %.2f ms, diff %.2f ms\n", hashMs, diffMs);
+        return 0;
+    }
+
+    // Balanced tree with a branching factor of 8, a few hundred distinct names and one or two components per
+    // node. `mutations` random edits (rename, toggle, move, remove, add) are applied with a fixed seed, so a
+    // plain and a mutated file of the same size make a reproducible diff benchmark.
+    int generate(const char* path, uint32_t count, bool compress, uint32_t mutations)
+    {
+        const auto start = Clock::now();
+        if (count == 0) count = 1;
+
+        snapshot::Capture capture;
+        std::vector<uint32_t> nameIds;
+        for (int i = 0; i < 500; i++) nameIds.push_back(capture.strings.intern("Object_" + std::to_string(i)));
+
+        const char* typeNames[] = {"UnityEngine.MeshRenderer", "UnityEngine.BoxCollider", "UnityEngine.Light",
+                                   "Game.EnemyController", "Game.Pickup"};
+        for (const char* name : typeNames) capture.componentTypes.push_back(capture.strings.intern(name));
+
+        constexpr uint32_t kBranching = 8;
+        std::vector<uint32_t> parentOf(count), nameOf(count);
+        std::vector<uint8_t> active(count), removed(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            parentOf[i] = i == 0 ? snapshot::kNone : (i - 1) / kBranching;
+            nameOf[i] = nameIds[i % nameIds.size()];
+            active[i] = i % 7 != 0;
+        }
+
+        uint64_t state = 0x2545F4914F6CDD1DULL;
+        auto random = [&state](uint32_t bound)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return static_cast<uint32_t>(state % bound);
+        };
+        auto isAncestor = [&parentOf](uint32_t ancestor, uint32_t node)
+        {
+            for (; node != snapshot::kNone; node = parentOf[node])
+            {
+                if (node == ancestor) return true;
+            }
+            return false;
+        };
+
+        for (uint32_t m = 0; m < mutations && count > 1; m++)
+        {
+            const uint32_t node = 1 + random(static_cast<uint32_t>(parentOf.size()) - 1);
+            switch (m % 5)
+            {
+            case 0:
+                nameOf[node] = capture.strings.intern("Renamed_" + std::to_string(m));
+                break;
+            case 1:
+                active[node] ^= 1;
+                break;
+            case 2:
+            {
+                const uint32_t parent = random(static_cast<uint32_t>(parentOf.size()));
+                if (!isAncestor(node, parent)) parentOf[node] = parent;
+                break;
+            }
+            case 3:
+                removed[node] = 1;
+                break;
+            default:
+                parentOf.push_back(node);
+                nameOf.push_back(capture.strings.intern("Spawned_" + std::to_string(m)));
+                active.push_back(1);
+                removed.push_back(0);
+                break;
+            }
+        }
+
+        // Child lists in index order, then a preorder walk that skips removed subtrees
+        const uint32_t total = static_cast<uint32_t>(parentOf.size());
+        std::vector<uint32_t> firstChild(total, snapshot::kNone), nextSibling(total, snapshot::kNone);
+        for (uint32_t i = total; i-- > 1;)
+        {
+            nextSibling[i] = firstChild[parentOf[i]];
+            firstChild[parentOf[i]] = i;
+        }
+
+        std::vector<uint32_t> order;
+        order.reserve(total);
+        std::vector<uint32_t> stack = {0};
+        while (!stack.empty())
+        {
+            const uint32_t node = stack.back();
+            stack.pop_back();
+            if (removed[node]) continue;
+            order.push_back(node);
+
+            const size_t mark = stack.size();
+            for (uint32_t child = firstChild[node]; child != snapshot::kNone; child = nextSibling[child])
+                stack.push_back(child);
+            std::reverse(stack.begin() + mark, stack.end());
+        }
+
+        std::vector<uint32_t> preorder(total, snapshot::kNone);
+        for (uint32_t i = 0; i < order.size(); i++) preorder[order[i]] = i;
+
+        const size_t written = order.size();
+        std::vector<snapshot::NodeRecord>& nodes = capture.nodes;
+        nodes.resize(written);
+        capture.transforms.resize(written * 10);
+        float* positions = capture.transforms.data();
+        float* rotations = positions + written * 3;
+        float* scales = positions + written * 7;
+        std::vector<uint32_t> lastChild(written, snapshot::kNone);
+
+        for (uint32_t i = 0; i < written; i++)
+        {
+            const uint32_t source = order[i];
+            snapshot::NodeRecord& node = nodes[i];
+            node = {};
+            node.instanceId = static_cast<int32_t>(source + 1) * 2;
+            node.parent = source == 0 ? snapshot::kNone : preorder[parentOf[source]];
+            node.depth = node.parent == snapshot::kNone ? 0 : static_cast<uint16_t>(nodes[node.parent].depth + 1);
+            node.firstChild = snapshot::kNone;
+            node.nextSibling = snapshot::kNone;
+            node.name = nameOf[source];
+            node.flags = snapshot::NodeChildrenLoaded;
+            if (active[source]) node.flags |= snapshot::NodeActive;
+
+            if (node.parent != snapshot::kNone)
+            {
+                nodes[node.parent].childCount++;
+                uint32_t& previous = lastChild[node.parent];
+                if (previous != snapshot::kNone) nodes[previous].nextSibling = i;
+                else nodes[node.parent].firstChild = i;
+                previous = i;
+            }
+
+            node.firstComponent = static_cast<uint32_t>(capture.components.size());
+            node.componentCount = static_cast<uint16_t>(1 + source % 2);
+            for (uint16_t c = 0; c < node.componentCount; c++)
+                capture.components.push_back(static_cast<uint32_t>((source + c) % capture.componentTypes.size()));
+
+            positions[i * 3 + 0] = static_cast<float>(source % 1000);
+            positions[i * 3 + 1] = static_cast<float>(node.depth);
+            positions[i * 3 + 2] = static_cast<float>(source / 1000);
+            rotations[i * 4 + 3] = 1.0f;
+            scales[i * 3 + 0] = scales[i * 3 + 1] = scales[i * 3 + 2] = 1.0f;
+        }
+
+        snapshot::Writer writer;
+        writer.setCompression(compress);
+        if (!capture.write(writer, path))
+        {
+            fprintf(stderr, "%s: %s\n", path, writer.getError().c_str());
+            return 1;
+        }
+        printf("Wrote %zu nodes, %" PRIu64 " bytes in %.1f ms\n", written, writer.bytesWritten(),
+               millisecondsSince(start));
+        return 0;
+    }
+
+    int usage()
+    {
+        fprintf(stderr, "usage: snapshot_viewer info <file>\n"
+                        "       snapshot_viewer tree <file> [maxDepth]\n"
+                        "       snapshot_viewer find <file> <text>\n"
+                        "       snapshot_viewer diff <before> <after>\n"
+                        "       snapshot_viewer generate <file> <nodes> [--lz4] [--mutate <edits>]\n");
+        return 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) return usage();
+    const char* command = argv[1];
+    const char* path = argv[2];
+
+    if (strcmp(command, "info") == 0) return info(path);
+    if (strcmp(command, "tree") == 0) return tree(path, argc > 3 ? atoi(argv[3]) : -1);
+    if (strcmp(command, "find") == 0 && argc > 3) return find(path, argv[3]);
+    if (strcmp(command, "diff") == 0 && argc > 3) return diff(path, argv[3]);
+    if (strcmp(command, "generate") == 0 && argc > 3)
+    {
+        bool compress = false;
+        uint32_t mutations = 0;
+        for (int i = 4; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--lz4") == 0) compress = true;
+            else if (strcmp(argv[i], "--mutate") == 0 && i + 1 < argc)
+                mutations = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            else return usage();
+        }
+        return generate(path, static_cast<uint32_t>(strtoul(argv[3], nullptr, 10)), compress, mutations);
+    }
+    return usage();
+}